@@ -11,20 +11,47 @@
 //include cpp files that needs to be compiled
 #include "core/kernel/chibi_kernel.cpp"
 #include "core/logging/logging.cpp"
+#include "core/logging/serial_log_sink.cpp"
+#include "core/logging/ram_log_sink.cpp"
+#include "core/logging/file_log_sink.cpp"
+#include "core/logging/stdout_log_sink.cpp"
+#include "core/tracing/tracer.cpp"
+#include "core/stats/stats_registry.cpp"
+#include "core/programs/top_program.cpp"
 #include "core/kernel/components/input_manager.cpp"
 #include "core/kernel/components/input_listener.cpp"
 #include "core/kernel/device/control_input_device.cpp"
 #include "core/kernel/device/display_device.cpp"
+#include "core/kernel/device/rgb_display_device.cpp"
+#include "core/kernel/device/mono_display_device.cpp"
+#include "core/kernel/device/sensor_device.cpp"
 #include "core/kernel/components/task_manager.cpp"
 #include "core/kernel/components/program_manager.cpp"
 #include "core/kernel/components/device_manager.cpp"
 #include "core/kernel/components/interface_manager.cpp"
+#include "core/kernel/components/display_compositor.cpp"
+#include "core/kernel/components/sensor_buffer.cpp"
+#include "core/kernel/components/sensor_sampler.cpp"
+#include "core/kernel/interfaces/i2c_bus.cpp"
+#include "core/kernel/interfaces/simulated_i2c_backend.cpp"
+#include "core/kernel/interfaces/spi_bus.cpp"
+#include "core/kernel/interfaces/esp_spi_backend.cpp"
+#include "core/kernel/interfaces/simulated_spi_backend.cpp"
 #include "core/task/task.cpp"
 #include "core/task/task_interface.cpp"
 #include "core/task/gui/gui_element.cpp"
+#include "core/task/gui/gui_container.cpp"
+#include "core/task/gui/text_metrics_cache.cpp"
 #include "core/task/gui/task_view_renderer.cpp"
 #include "core/task/gui/view.cpp"
+#include "core/graphics/font_5x7.cpp"
+#include "core/graphics/mono_framebuffer.cpp"
+#include "core/graphics/rgb565_framebuffer.cpp"
 #include "core/base_devices/ssd1306.cpp"
+#include "core/base_devices/spi_oled_display.cpp"
+#include "core/base_devices/i2c_register_sensor.cpp"
+#include "core/base_devices/memory_rgb_display.cpp"
+#include "core/base_devices/memory_mono_display.cpp"
 #include "core/base_devices/wheel.cpp"
 #include "core/base_devices/button.cpp"
 
@@ -88,6 +115,56 @@ DisplayDevice* ChibiESP::getDisplayDevice(uint32_t deviceId){
   return _kernel->getDisplayDevice(deviceId); // Get the display device by id
 }
 
+/**
+ * * @brief Gets the compositor that controls the access to a display device.
+ * * @param deviceId the id of the display device.
+ * * @return A pointer to the compositor, or nullptr if the device is not found or not initialized.
+ */
+DisplayCompositor* ChibiESP::getDisplayCompositor(uint32_t deviceId){
+  return _kernel->getDisplayCompositor(deviceId);
+}
+
+/**
+ * * @brief Registers a sensor device, sampled by the kernel once the devices are initialized.
+ * * @param device The sensor device to be registered.
+ * * @param period The sampling period in milliseconds, 0 to not sample it until setSensorPeriod.
+ * * @param historyLength The number of samples kept for the subscribed tasks.
+ * * @return 0 on success, or an error code if the device could not be registered.
+ * * @details Tasks read the samples through subscribeSensor instead of polling the sensor, so each sensor is read once
+ * * for all of them, and the sensors of an I2C bus are read together.
+ */
+int ChibiESP::register_sensor_device(SensorDevice* device, uint32_t period, size_t historyLength){
+  return _kernel->register_sensor_device(device, period, historyLength);
+}
+
+/**
+ * * @brief Gets a sensor device by its id.
+ * * @param deviceId the id of the sensor device.
+ * * @return A pointer to the sensor device, or nullptr if not found.
+ */
+SensorDevice* ChibiESP::getSensorDevice(uint32_t deviceId){
+  return _kernel->getSensorDevice(deviceId);
+}
+
+/**
+ * * @brief Subscribes to the samples of a sensor: the latest value, the history of a time window and the new samples.
+ * * @param deviceId the id of the sensor device.
+ * * @return The subscription, not valid if the sensor is not registered.
+ */
+SensorSubscription ChibiESP::subscribeSensor(uint32_t deviceId){
+  return _kernel->subscribeSensor(deviceId);
+}
+
+/**
+ * * @brief Changes the sampling period of a sensor.
+ * * @param deviceId the id of the sensor device.
+ * * @param period The sampling period in milliseconds, 0 to stop the sampling.
+ * * @return 0 on success, -1 if the sensor is not registered.
+ */
+int ChibiESP::setSensorPeriod(uint32_t deviceId, uint32_t period){
+  return _kernel->setSensorPeriod(deviceId, period);
+}
+
 /**
  * * @brief Main loop function for the ChibiESP library.
  * * @details This function should be called in the main loop of the Arduino sketch. It handles the kernel's loop function and updates the state of the system.
@@ -124,6 +201,16 @@ bool ChibiESP::registerI2cInterface(int bus, int sda_pin, int scl_pin){
   return _kernel->registerI2cInterface(bus, sda_pin, scl_pin);
 }
 
+/**
+ * * @brief Registers an I2C bus that transfers through a custom backend, like a SimulatedI2cBackend.
+ * * @param bus The I2C bus number.
+ * * @param backend The backend of the bus, not owned by the bus.
+ * * @return true on success, false on failure.
+ */
+bool ChibiESP::registerI2cInterface(int bus, I2cBackend* backend){
+  return _kernel->registerI2cInterface(bus, backend);
+}
+
 /**
  * * @brief Gets the I2C interface by bus number.
  * * @param bus The I2C bus number.
@@ -133,6 +220,46 @@ TwoWire* ChibiESP::getI2cInterface(int bus){
   return _kernel->getI2cInterface(bus);
 }
 
+/**
+ * * @brief Gets the I2C bus service by bus number, to queue transactions on it.
+ * * @param bus The I2C bus number.
+ * * @return A pointer to the I2C bus, or nullptr if not found.
+ */
+I2cBus* ChibiESP::getI2cBus(int bus){
+  return _kernel->getI2cBus(bus);
+}
+
+/**
+ * * @brief Registers an SPI interface. Transfers use DMA.
+ * * @param bus The SPI bus number: 0 for SPI2, 1 for SPI3.
+ * * @param sck_pin The clock pin number.
+ * * @param miso_pin The MISO pin number, -1 if no device is read.
+ * * @param mosi_pin The MOSI pin number.
+ * * @return true on success, false on failure.
+ */
+bool ChibiESP::registerSpiInterface(int bus, int sck_pin, int miso_pin, int mosi_pin){
+  return _kernel->registerSpiInterface(bus, sck_pin, miso_pin, mosi_pin);
+}
+
+/**
+ * * @brief Registers an SPI bus that transfers through a custom backend, like a SimulatedSpiBackend.
+ * * @param bus The SPI bus number.
+ * * @param backend The backend of the bus, not owned by the bus.
+ * * @return true on success, false on failure.
+ */
+bool ChibiESP::registerSpiInterface(int bus, SpiBackend* backend){
+  return _kernel->registerSpiInterface(bus, backend);
+}
+
+/**
+ * * @brief Gets the SPI bus by bus number, to add devices and transfer on it.
+ * * @param bus The SPI bus number.
+ * * @return A pointer to the SPI bus, or nullptr if not found.
+ */
+SpiBus* ChibiESP::getSpiBus(int bus){
+  return _kernel->getSpiBus(bus);
+}
+
 /**
  * * @brief Gets the navigation up event.
  * * @return The navigation up event.
@@ -231,3 +358,12 @@ bool ChibiESP::isTaskRunning(const uint8_t taskID){
 bool ChibiESP::isProgramRunning(const std::string programName){
   return _kernel->isProgramRunning(programName); // Check if the program is alive
 }
+
+/**
+ * * @brief gets the information of all the tasks
+ * * @param list filled with one entry for each task
+ * * @details the cpu time is available only when FreeRTOS collects the run time stats
+ */
+void ChibiESP::getTaskInfoList(std::vector<CESP_TaskInfo_t>& list){
+  _kernel->getTaskInfoList(list);
+}
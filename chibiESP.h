@@ -8,16 +8,25 @@
 #include "core/kernel/components/input_manager.h"
 #include "core/structs/program.h"
 #include "core/structs/input_structs.h"
+#include "core/kernel/components/sensor_buffer.h"
 
 #include <string>
+#include <vector>
 #include <stdint.h>
 
 class InputListener;
 class DisplayDevice;
+class DisplayCompositor;
+class SensorDevice;
 class InterfaceManager;
 class TwoWire;
+class I2cBus;
+class I2cBackend;
+class SpiBus;
+class SpiBackend;
 class ChibiKernel;
 class ControlInputDevice;
+struct CESP_TaskInfo_t;
 
 class ChibiESP{
 public:
@@ -28,6 +37,7 @@ public:
   void loop();
   int register_control_input_device(ControlInputDevice* device);
   int register_display_device(DisplayDevice* device);
+  int register_sensor_device(SensorDevice* device, uint32_t period, size_t historyLength = SENSOR_DEFAULT_HISTORY);
 
   //program functions
   int createProgram(CESP_Program program);
@@ -36,6 +46,7 @@ public:
   int quitTask(const uint8_t taskID); // Gracefully quit a task by ID
   bool isTaskRunning(const uint8_t taskID);
   bool isProgramRunning(const std::string programName);
+  void getTaskInfoList(std::vector<CESP_TaskInfo_t>& list);
 
   //input navigation events
   InputEvent getNavUpEvent() const;
@@ -47,10 +58,21 @@ public:
 
   //devices getter
   DisplayDevice* getDisplayDevice(uint32_t deviceId);
+  DisplayCompositor* getDisplayCompositor(uint32_t deviceId);
+  SensorDevice* getSensorDevice(uint32_t deviceId);
+
+  //sensors
+  SensorSubscription subscribeSensor(uint32_t deviceId);
+  int setSensorPeriod(uint32_t deviceId, uint32_t period);
 
   //interfaces
   bool registerI2cInterface(int bus, int sda_pin, int scl_pin);
+  bool registerI2cInterface(int bus, I2cBackend* backend);
   TwoWire* getI2cInterface(int bus);
+  I2cBus* getI2cBus(int bus);
+  bool registerSpiInterface(int bus, int sck_pin, int miso_pin, int mosi_pin);
+  bool registerSpiInterface(int bus, SpiBackend* backend);
+  SpiBus* getSpiBus(int bus);
 
   //getters for cores reservations
   int getKernelCoreId() const;
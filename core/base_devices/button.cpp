@@ -40,7 +40,7 @@ int ButtonDevice::init(ControlDeviceInitStruct_t& init_struct){
             delete _device;
             _device = nullptr;
         }
-        Logger::error("Button Device: Init error: no callback function provided for input manager");
+        CESP_LOGE(LogModule::INPUTS, "Button Device: Init error: no callback function provided for input manager");
         return -2; // Nothing to configure
     }
 
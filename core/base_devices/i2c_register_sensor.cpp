@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/base_devices/i2c_register_sensor.h"
+#include "core/logging/logging.h"
+#include "core/kernel/device/sensor_device.h"
+#include "core/kernel/interfaces/i2c_bus.h"
+#include "chibiESP.h"
+
+I2cRegisterSensor::I2cRegisterSensor(uint32_t deviceId) :
+    SensorDevice(deviceId),
+    _bus(nullptr)
+{
+
+}
+
+int I2cRegisterSensor::configure(I2cRegisterSensorConfigStruct config){
+    if(config.channel_count == 0 || config.channel_count > SENSOR_MAX_CHANNELS) return -1;
+    _config = config;
+    return 0;
+}
+
+int I2cRegisterSensor::init(){
+    //This device needs a i2c bus handled by the kernel
+    _bus = chibiESP.getI2cBus(_config.i2c_bus);
+    if(_bus == nullptr){
+        CESP_LOGE(LogModule::DEVICE, "I2C sensor error: i2c bus %d is not registered", _config.i2c_bus);
+        return -1;
+    }
+    _readTransaction.setAddress(_config.i2c_address);
+    _readTransaction.setPriority(I2cPriority::BACKGROUND);
+    return 0;
+}
+
+int I2cRegisterSensor::read(float* values){
+    if(_bus == nullptr) return -1;
+    _readTransaction.clear();
+    _readTransaction.readRegister(_config.first_register, _raw, _config.channel_count * 2);
+    if(_bus->transfer(_readTransaction) != I2C_OK) return -1;
+
+    for(uint8_t channel = 0; channel < _config.channel_count; channel++){
+        const uint8_t* bytes = _raw + channel * 2;
+        uint16_t raw = _config.big_endian ? (bytes[0] << 8) | bytes[1] : (bytes[1] << 8) | bytes[0];
+        float value = _config.is_signed ? (float)(int16_t)raw : (float)raw;
+        values[channel] = value * _config.scale + _config.offset;
+    }
+    return 0;
+}
+
+int I2cRegisterSensor::get_device_info(SensorDeviceInfo_t &info){
+    info.sensorModel = _config.model;
+    info.channelCount = _config.channel_count;
+    info.minPeriod = _config.min_period;
+    return 0;
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef I2C_REGISTER_SENSOR_H
+#define I2C_REGISTER_SENSOR_H
+
+#include "core/kernel/device/sensor_device.h"
+#include "core/kernel/interfaces/i2c_bus.h"
+
+struct I2cRegisterSensorConfigStruct {
+    uint8_t i2c_bus; // I2C bus number
+    uint8_t i2c_address;
+    uint8_t first_register;  // Register of the first channel, the others follow
+    uint8_t channel_count;   // Up to SENSOR_MAX_CHANNELS
+    bool big_endian = true;  // Byte order of the registers, most sensors send the high byte first
+    bool is_signed = true;
+    float scale = 1.0f;      // Channel value = raw value * scale + offset
+    float offset = 0.0f;
+    uint32_t min_period = 0; // Fastest sampling period of the sensor, in milliseconds
+    const char* model = "I2C sensor";
+};
+
+/**
+ * @brief sensor that exposes its channels as consecutive 16 bit registers, like most temperature, pressure and
+ * inertial sensors. All the channels are read with a single register read
+ */
+class I2cRegisterSensor : public SensorDevice{
+public:
+    I2cRegisterSensor(uint32_t deviceId);
+    int configure(I2cRegisterSensorConfigStruct config);
+    int init() override;
+    int read(float* values) override;
+    int get_device_info(SensorDeviceInfo_t &info) override;
+    int getI2cBus() const override {return _config.i2c_bus;}
+private:
+    I2cRegisterSensorConfigStruct _config;
+    I2cBus* _bus;
+    I2cTransaction _readTransaction;    //reused to avoid allocations
+    uint8_t _raw[SENSOR_MAX_CHANNELS * 2];
+};
+
+#endif  //I2C_REGISTER_SENSOR_H
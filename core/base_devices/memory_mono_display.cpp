@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/base_devices/memory_mono_display.h"
+#include "core/kernel/device/mono_display_device.h"
+#include "core/logging/logging.h"
+
+#include <Arduino.h>
+#include <string.h>
+#include <vector>
+
+MemoryMonoDisplay::MemoryMonoDisplay(uint32_t deviceId) :
+    MonoDisplayDevice(deviceId),
+    _screenWidth(0),
+    _screenHeight(0),
+    _sendFirstPage(0),
+    _sendPageCount(0)
+{
+    resetStats();
+}
+
+int MemoryMonoDisplay::configure(MemoryMonoDisplayConfigStruct config){
+    _screenWidth = config.screenWidth;
+    _screenHeight = config.screenHeight;
+    return 0;
+}
+
+int MemoryMonoDisplay::init(){
+    if(!initFramebuffer(_screenWidth, _screenHeight)){
+        CESP_LOGE(LogModule::DEVICE, "Memory display error: could not create the framebuffer");
+        return -1;
+    }
+    _panel.assign(_framebuffer.getBufferSize(), 0);
+    _sendBuffer.resize(_framebuffer.getBufferSize());
+    _sendPageCount = 0;
+    resetStats();
+    return 0;
+}
+
+int MemoryMonoDisplay::deinit(void* arg){
+    _panel.clear();
+    _sendBuffer.clear();
+    return 0;
+}
+
+int MemoryMonoDisplay::get_device_info(DisplayDeviceInfo_t &info){
+    info.screenWidth = _screenWidth;
+    info.screenHeight = _screenHeight;
+    info.colorType = DisplayColorType::Monochrome;
+    info.colorDepth = 1; // 1 bit per pixel
+    info.displayModel = "Memory monochrome";
+    info.controllerId = 0;
+    return 0;
+}
+
+void MemoryMonoDisplay::resetStats(){
+    _lastUpdate = {0, 0, 0};
+    _total = {0, 0, 0};
+    _updateCount = 0;
+}
+
+/**
+ * @brief copy the changed pages, as the SSD1306 would receive them
+ */
+int MemoryMonoDisplay::preparePages(uint8_t first_page, uint8_t page_count, const uint8_t *pages){
+    _sendFirstPage = first_page;
+    _sendPageCount = page_count;
+    if(page_count) memcpy(_sendBuffer.data() + (size_t)first_page * _screenWidth, pages, (size_t)page_count * _screenWidth);
+    return 0;
+}
+
+/**
+ * @brief write the copied pages in the panel and count what changed
+ */
+int MemoryMonoDisplay::sendUpdate(){
+    _lastUpdate = {0, 0, 0};
+    size_t start = (size_t)_sendFirstPage * _screenWidth;
+    size_t end = start + (size_t)_sendPageCount * _screenWidth;
+    for(size_t i = start; i < end; i++){
+        uint8_t diff = _panel[i] ^ _sendBuffer[i];
+        if(diff){
+            _lastUpdate.bytesChanged++;
+            _lastUpdate.pixelsChanged += __builtin_popcount(diff);
+            _panel[i] = _sendBuffer[i];
+        }
+    }
+    _lastUpdate.bytesSent = end - start;
+    _sendPageCount = 0;
+
+    _total.bytesSent += _lastUpdate.bytesSent;
+    _total.bytesChanged += _lastUpdate.bytesChanged;
+    _total.pixelsChanged += _lastUpdate.pixelsChanged;
+    _updateCount++;
+    return 0;
+}
+
+bool MemoryMonoDisplay::getPanelPixel(int16_t x, int16_t y) const{
+    if(x < 0 || y < 0 || x >= _screenWidth || y >= _screenHeight || _panel.empty()) return false;
+    return _panel[(y >> 3) * _screenWidth + x] & (1 << (y & 7));
+}
+
+/**
+ * @brief write the panel content as a binary PBM image (white pixels are written as black, like on paper)
+ * @param out where to write the image: a file or a serial port
+ * @return the number of bytes written
+ */
+size_t MemoryMonoDisplay::writePbm(Print &out) const{
+    char header[24];
+    snprintf(header, sizeof(header), "P4\n%d %d\n", _screenWidth, _screenHeight);
+    size_t written = out.write((const uint8_t*)header, strlen(header));
+
+    //PBM rows are packed 8 pixels per byte, most significant bit first
+    std::vector <uint8_t> row((_screenWidth + 7) / 8);
+    for(int16_t y = 0; y < _screenHeight; y++){
+        memset(row.data(), 0, row.size());
+        for(int16_t x = 0; x < _screenWidth; x++){
+            if(getPanelPixel(x, y)) row[x >> 3] |= 0x80 >> (x & 7);
+        }
+        written += out.write(row.data(), row.size());
+    }
+    return written;
+}
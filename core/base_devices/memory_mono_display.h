@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef MEMORY_MONO_DISPLAY_H
+#define MEMORY_MONO_DISPLAY_H
+
+#include "core/kernel/device/mono_display_device.h"
+
+#include <stdint.h>
+#include <vector>
+
+class Print;
+
+struct MemoryMonoDisplayConfigStruct {
+    int screenWidth;  // Width of the display in pixels
+    int screenHeight; // Height of the display in pixels
+};
+
+//data sent by an update and what it changed on the panel
+struct MemoryDisplayUpdateStats {
+    uint32_t bytesSent;     //bytes that a SSD1306 would receive (whole dirty pages)
+    uint32_t bytesChanged;  //bytes that are different on the panel after the update
+    uint32_t pixelsChanged; //pixels that are different on the panel after the update
+};
+
+/**
+ * @brief headless monochromatic display: same memory layout and update logic of the SSD1306,
+ * but the pages are written in a memory panel instead of being sent on the bus.
+ * @details used to measure the cost of rendering and to compare the screen content with reference images
+ */
+class MemoryMonoDisplay : public MonoDisplayDevice{
+public:
+    MemoryMonoDisplay(uint32_t deviceId);
+    int configure(MemoryMonoDisplayConfigStruct config);
+    int init() override;
+    int deinit(void* arg) override;
+    int get_device_info(DisplayDeviceInfo_t &info) override;
+    int sendUpdate() override;
+
+    //content of the panel, as the real display would show it
+    bool getPanelPixel(int16_t x, int16_t y) const;
+    size_t writePbm(Print &out) const;
+
+    //update statistics
+    MemoryDisplayUpdateStats getLastUpdateStats() const {return _lastUpdate;}
+    MemoryDisplayUpdateStats getTotalStats() const {return _total;}
+    uint32_t getUpdateCount() const {return _updateCount;}
+    void resetStats();
+protected:
+    int preparePages(uint8_t first_page, uint8_t page_count, const uint8_t *pages) override;
+private:
+    int _screenWidth, _screenHeight;
+    std::vector <uint8_t> _sendBuffer;  //dirty pages copied by prepareUpdate
+    uint8_t _sendFirstPage, _sendPageCount;
+    std::vector <uint8_t> _panel;       //what the display shows, SSD1306 layout
+
+    MemoryDisplayUpdateStats _lastUpdate, _total;
+    uint32_t _updateCount;
+};
+
+#endif  //MEMORY_MONO_DISPLAY_H
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/base_devices/memory_rgb_display.h"
+#include "core/kernel/device/rgb_display_device.h"
+#include "core/logging/logging.h"
+
+#include <vector>
+
+MemoryRgbDisplay::MemoryRgbDisplay(uint32_t deviceId) :
+    RgbDisplayDevice(deviceId),
+    _screenWidth(0),
+    _screenHeight(0),
+    _windowCount(0),
+    _pixelsSent(0)
+{
+
+}
+
+int MemoryRgbDisplay::configure(MemoryRgbDisplayConfigStruct config){
+    _screenWidth = config.screenWidth;
+    _screenHeight = config.screenHeight;
+    return 0;
+}
+
+int MemoryRgbDisplay::init(){
+    if(!initFramebuffer(_screenWidth, _screenHeight)){
+        CESP_LOGE(LogModule::DEVICE, "Memory display error: could not create the framebuffer");
+        return -1;
+    }
+    _panel.assign((size_t)_screenWidth * _screenHeight, 0);
+    _windowCount = 0;
+    _pixelsSent = 0;
+    return 0;
+}
+
+int MemoryRgbDisplay::deinit(void* arg){
+    _panel.clear();
+    _panel.shrink_to_fit();
+    return 0;
+}
+
+int MemoryRgbDisplay::get_device_info(DisplayDeviceInfo_t &info){
+    info.screenWidth = _screenWidth;
+    info.screenHeight = _screenHeight;
+    info.colorType = DisplayColorType::RGB;
+    info.colorDepth = 16;
+    info.displayModel = "Memory RGB565";
+    info.controllerId = 0;
+    return 0;
+}
+
+uint16_t MemoryRgbDisplay::getPanelPixel(int16_t x, int16_t y) const{
+    if(x < 0 || y < 0 || x >= _screenWidth || y >= _screenHeight || _panel.empty()) return 0;
+    return _panel[y * _screenWidth + x];
+}
+
+int MemoryRgbDisplay::writeWindow(int16_t x, int16_t y, int16_t width, int16_t height, const uint8_t *pixels){
+    if(_panel.empty() || x < 0 || y < 0 || x + width > _screenWidth || y + height > _screenHeight) return -1;
+    for(int16_t row = 0; row < height; row++){
+        uint16_t *dst = _panel.data() + (y + row) * _screenWidth + x;
+        for(int16_t col = 0; col < width; col++){
+            dst[col] = (pixels[0] << 8) | pixels[1];
+            pixels += 2;
+        }
+    }
+    _windowCount++;
+    _pixelsSent += (uint32_t)width * height;
+    return 0;
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef MEMORY_RGB_DISPLAY_H
+#define MEMORY_RGB_DISPLAY_H
+
+#include "core/kernel/device/rgb_display_device.h"
+
+#include <stdint.h>
+#include <vector>
+
+struct MemoryRgbDisplayConfigStruct {
+    int screenWidth;  // Width of the display in pixels
+    int screenHeight; // Height of the display in pixels
+};
+
+/**
+ * @brief reference RGB565 display without hardware: the windows sent by the framebuffer are written in a memory panel.
+ * @details useful to check the color rendering path and the tile updates on a board without a color panel, or on a host
+ */
+class MemoryRgbDisplay : public RgbDisplayDevice{
+public:
+    MemoryRgbDisplay(uint32_t deviceId);
+    int configure(MemoryRgbDisplayConfigStruct config);
+    int init() override;
+    int deinit(void* arg) override;
+    int get_device_info(DisplayDeviceInfo_t &info) override;
+
+    //content of the panel, as the real display would show it
+    uint16_t getPanelPixel(int16_t x, int16_t y) const;
+    uint32_t getWindowCount() const {return _windowCount;}
+    uint32_t getPixelsSent() const {return _pixelsSent;}
+protected:
+    int writeWindow(int16_t x, int16_t y, int16_t width, int16_t height, const uint8_t *pixels) override;
+private:
+    int _screenWidth, _screenHeight;
+    std::vector <uint16_t> _panel;
+    uint32_t _windowCount;  //windows written since init
+    uint32_t _pixelsSent;   //pixels written since init
+};
+
+#endif  //MEMORY_RGB_DISPLAY_H
@@ -0,0 +1,147 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/base_devices/spi_oled_display.h"
+#include "core/logging/logging.h"
+#include "core/kernel/device/mono_display_device.h"
+#include "core/kernel/interfaces/spi_bus.h"
+#include "chibiESP.h"
+
+#include <Arduino.h>
+
+#include <string.h>
+
+namespace{
+    const uint8_t SH1106_COLUMN_OFFSET = 2;     //the 128 visible columns of the 132 in the ram
+};
+
+SpiOledDisplay::SpiOledDisplay(uint32_t deviceId) :
+    MonoDisplayDevice(deviceId),
+    _bus(nullptr),
+    _spiDevice(-1),
+    _sendFirstPage(0),
+    _sendPageCount(0)
+{
+
+}
+
+int SpiOledDisplay::configure(SpiOledConfigStruct config){
+    _screenWidth = config.screenWidth;
+    _screenHeight = config.screenHeight;
+    _spi_bus = config.spi_bus;
+    _cs_pin = config.cs_pin;
+    _dc_pin = config.dc_pin;
+    _reset_pin = config.reset_pin;
+    _spi_frequency = config.spi_frequency;
+    _controller = config.controller;
+    return 0;
+}
+
+int SpiOledDisplay::init(){
+    //This device needs a spi bus handled by the kernel
+    _bus = chibiESP.getSpiBus(_spi_bus);
+    if(_bus == nullptr){
+        CESP_LOGE(LogModule::DEVICE, "SPI OLED device error: spi bus %d is not registered", _spi_bus);
+        return -1;
+    }
+    _spiDevice = _bus->addDevice(_cs_pin, _spi_frequency, 0);
+    if(_spiDevice < 0){
+        CESP_LOGE(LogModule::DEVICE, "SPI OLED device error: could not add the device to spi bus %d", _spi_bus);
+        return -1;
+    }
+
+    pinMode(_dc_pin, OUTPUT);
+    if(_reset_pin >= 0){
+        pinMode(_reset_pin, OUTPUT);
+        digitalWrite(_reset_pin, HIGH);
+        delay(1);
+        digitalWrite(_reset_pin, LOW);
+        delay(10);
+        digitalWrite(_reset_pin, HIGH);
+    }
+
+    uint8_t commands[OLED_INIT_COMMANDS_SIZE];
+    getOledInitCommands(_controller, _screenHeight, commands);
+    if(sendCommands(commands, sizeof(commands)) < 0){
+        CESP_LOGE(LogModule::DEVICE, "SPI OLED device error: could not initialize display");
+        return -1;
+    }
+
+    if(!initFramebuffer(_screenWidth, _screenHeight)){
+        CESP_LOGE(LogModule::DEVICE, "SPI OLED device error: could not create the framebuffer");
+        return -1;
+    }
+    _sendBuffer.reserve((size_t)_screenWidth * ((_screenHeight + 7) / 8));
+    return 0;
+}
+
+int SpiOledDisplay::deinit(void* arg){
+    if(_bus == nullptr) return 0;
+
+    const uint8_t displayOff = 0xAE;
+    sendCommands(&displayOff, 1);
+    _bus = nullptr;
+    return 0;
+}
+
+int SpiOledDisplay::get_device_info(DisplayDeviceInfo_t &info){
+    info.screenWidth = _screenWidth;
+    info.screenHeight = _screenHeight;
+    info.colorType = DisplayColorType::Monochrome;
+    info.colorDepth = 1; // 1 bit per pixel
+    info.displayModel = _controller == OledController::SH1106 ? "SH1106" : "SSD1306";
+    info.controllerId = 0;
+    return 0;
+}
+
+/**
+ * @brief copy the changed pages in the send buffer
+ */
+int SpiOledDisplay::preparePages(uint8_t first_page, uint8_t page_count, const uint8_t *pages){
+    _sendFirstPage = first_page;
+    _sendPageCount = page_count;
+    _sendBuffer.assign(pages, pages + (size_t)page_count * _screenWidth);
+    return 0;
+}
+
+int SpiOledDisplay::sendUpdate(){
+    //only the send buffer is read: the framebuffer can be drawn in the meantime
+    if(_bus == nullptr) return -1;
+    if(_sendPageCount == 0) return 0;
+    return _bus->run(sendFrameWrapper, this) == SPI_OK ? 0 : -1;
+}
+
+//send the prepared pages, with the bus reserved so that the data/command pin is not changed under another transfer
+int SpiOledDisplay::sendFrame(){
+    if(_controller == OledController::SSD1306){
+        uint8_t window[OLED_WINDOW_COMMANDS_SIZE];
+        getOledWindowCommands(_screenWidth, _sendFirstPage, _sendPageCount, window);
+        if(sendCommands(window, sizeof(window)) < 0) return SPI_ERROR_BUS;
+        return sendData(_sendBuffer.data(), _sendBuffer.size()) < 0 ? SPI_ERROR_BUS : SPI_OK;
+    }
+
+    //SH1106: the column address does not move to the next page, each page is selected and written
+    for(uint8_t page = 0; page < _sendPageCount; page++){
+        const uint8_t position[] = {
+            (uint8_t)(0xB0 | (_sendFirstPage + page)),  //page
+            SH1106_COLUMN_OFFSET & 0x0F,                //column, low nibble
+            0x10 | (SH1106_COLUMN_OFFSET >> 4)          //column, high nibble
+        };
+        if(sendCommands(position, sizeof(position)) < 0) return SPI_ERROR_BUS;
+        if(sendData(_sendBuffer.data() + (size_t)page * _screenWidth, _screenWidth) < 0) return SPI_ERROR_BUS;
+    }
+    return SPI_OK;
+}
+
+int SpiOledDisplay::sendCommands(const uint8_t* commands, size_t length){
+    std::lock_guard <std::recursive_mutex> lock(_bus->getMutex());
+    digitalWrite(_dc_pin, LOW);
+    return _bus->write(_spiDevice, commands, length) == SPI_OK ? 0 : -1;
+}
+
+int SpiOledDisplay::sendData(const uint8_t* data, size_t length){
+    std::lock_guard <std::recursive_mutex> lock(_bus->getMutex());
+    digitalWrite(_dc_pin, HIGH);
+    return _bus->write(_spiDevice, data, length) == SPI_OK ? 0 : -1;
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SPI_OLED_DISPLAY_H
+#define SPI_OLED_DISPLAY_H
+
+#include "core/kernel/device/mono_display_device.h"
+#include "core/kernel/interfaces/spi_bus.h"
+
+#include <vector>
+
+struct SpiOledConfigStruct {
+    int screenWidth;  // Width of the display in pixels
+    int screenHeight; // Height of the display in pixels
+    uint8_t spi_bus; // SPI bus number
+    int cs_pin;
+    int dc_pin;       // Data/command select
+    int reset_pin = -1;  // -1 if the reset is wired to the board reset
+    uint32_t spi_frequency = 8000000;   // Both controllers accept up to 10MHz
+    OledController controller = OledController::SSD1306;
+};
+
+/**
+ * @brief SSD1306 or SH1106 monochromatic OLED display on a 4 wire SPI bus
+ * @details the changed pages are copied in a send buffer by prepareUpdate, then sent with the bus reserved:
+ * the commands with the data/command pin low, the pages with it high. On the ESP32 the pages are sent with DMA
+ */
+class SpiOledDisplay : public MonoDisplayDevice{
+public:
+    SpiOledDisplay(uint32_t deviceId);
+    int configure(SpiOledConfigStruct config);
+    int init() override;
+    int deinit(void* arg) override;
+    int get_device_info(DisplayDeviceInfo_t &info) override;
+    int sendUpdate() override;
+
+    static int sendFrameWrapper(void* context){
+        return static_cast<SpiOledDisplay*>(context)->sendFrame();
+    }
+protected:
+    int preparePages(uint8_t first_page, uint8_t page_count, const uint8_t *pages) override;
+private:
+    int sendFrame();
+    int sendCommands(const uint8_t* commands, size_t length);
+    int sendData(const uint8_t* data, size_t length);
+
+    int _screenWidth, _screenHeight;
+    uint8_t _spi_bus;
+    int _cs_pin, _dc_pin, _reset_pin;
+    uint32_t _spi_frequency;
+    OledController _controller;
+    SpiBus* _bus;
+    int _spiDevice;
+    std::vector <uint8_t> _sendBuffer;  //pages prepared by prepareUpdate
+    uint8_t _sendFirstPage;
+    uint8_t _sendPageCount;             //0 if there is nothing to send
+};
+
+#endif  //SPI_OLED_DISPLAY_H
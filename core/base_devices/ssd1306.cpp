@@ -4,16 +4,21 @@
 
 #include "core/base_devices/ssd1306.h"
 #include "core/logging/logging.h"
-#include "core/kernel/device/display_device.h"
+#include "core/kernel/device/mono_display_device.h"
+#include "core/kernel/interfaces/i2c_bus.h"
 #include "chibiESP.h"
 
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
-#include <Wire.h>
+#include <string.h>
+
+namespace{
+    //first byte of every write: a stream of commands or a stream of display data
+    const uint8_t SSD1306_CONTROL_COMMANDS = 0x00;
+    const uint8_t SSD1306_CONTROL_DATA = 0x40;
+};
 
 SSD1306::SSD1306(uint32_t deviceId) :
-    DisplayDevice(deviceId),
-    _displayObj(nullptr)
+    MonoDisplayDevice(deviceId),
+    _bus(nullptr)
 {
 
 }
@@ -22,31 +27,44 @@ int SSD1306::configure(SSD1306ConfigStruct config){
     _screenWidth = config.screenWidth;
     _screenHeight = config.screenHeight;
     _i2c_bus = config.i2c_bus;
+    _i2c_address = config.i2c_address;
+    _i2c_clock = config.i2c_clock;
+    _i2c_chunk_size = config.i2c_chunk_size;
     return 0;
 }
 
 int SSD1306::init(){
-    //This device needs a i2c interface handled by the kernel
-    //NEVER close the TwoWire interface since it's managed by the system
-    TwoWire* i2cInterface = chibiESP.getI2cInterface(_i2c_bus);
-    if(i2cInterface == nullptr){
-        Logger::error("SSD1306 device error: i2c interface is nullptr");
+    //This device needs a i2c bus handled by the kernel
+    _bus = chibiESP.getI2cBus(_i2c_bus);
+    if(_bus == nullptr){
+        CESP_LOGE(LogModule::DEVICE, "SSD1306 device error: i2c bus %d is not registered", _i2c_bus);
+        return -1;
+    }
+    if(_i2c_clock) _bus->setClock(_i2c_clock);
+    if(_i2c_chunk_size) _bus->setChunkSize(_i2c_chunk_size);
+    _frameTransaction.setAddress(_i2c_address);
+    _frameTransaction.setPriority(I2cPriority::INTERACTIVE);
+
+    uint8_t commands[OLED_INIT_COMMANDS_SIZE];
+    getOledInitCommands(OledController::SSD1306, _screenHeight, commands);
+    if(sendCommands(commands, sizeof(commands)) < 0){
+        CESP_LOGE(LogModule::DEVICE, "SSD1306 device error: could not initialize display");
         return -1;
     }
 
-    _displayObj = new Adafruit_SSD1306(_screenWidth, _screenHeight, i2cInterface, -1);
-    if (!_displayObj->begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
-        Logger::error("SSD1306 device error: could not initialize display");
+    if(!initFramebuffer(_screenWidth, _screenHeight)){
+        CESP_LOGE(LogModule::DEVICE, "SSD1306 device error: could not create the framebuffer");
         return -1;
     }
     return 0;
 }
 
 int SSD1306::deinit(void* arg){
-    if(_displayObj == nullptr) return 0;
-    
-    delete _displayObj;
-    _displayObj = nullptr;
+    if(_bus == nullptr) return 0;
+
+    const uint8_t displayOff = 0xAE;
+    sendCommands(&displayOff, 1);
+    _bus = nullptr;
     return 0;
 }
 
@@ -60,37 +78,36 @@ int SSD1306::get_device_info(DisplayDeviceInfo_t &info){
     return 0;
 }
 
-int SSD1306::updateScreen(){
-    _displayObj->display();
+/**
+ * @brief copy the changed pages in the frame transaction, after the commands that select their window
+ * @details same memory layout: the pages are copied as they are
+ */
+int SSD1306::preparePages(uint8_t first_page, uint8_t page_count, const uint8_t *pages){
+    _frameTransaction.clear();
+    if(page_count == 0) return 0;
+
+    uint8_t window[1 + OLED_WINDOW_COMMANDS_SIZE];
+    window[0] = SSD1306_CONTROL_COMMANDS;
+    getOledWindowCommands(_screenWidth, first_page, page_count, window + 1);
+    size_t length = (size_t)page_count * _screenWidth;
+    const uint8_t prefix = SSD1306_CONTROL_DATA;
+
+    _frameTransaction.write(window, sizeof(window));
+    uint8_t* data = _frameTransaction.writeBulk(&prefix, 1, length);
+    memcpy(data, pages, length);
     return 0;
 }
 
-int SSD1306::clearScreen(){
-    _displayObj->clearDisplay();
-    return 0;
+int SSD1306::sendUpdate(){
+    //only the frame transaction is read: the framebuffer can be drawn in the meantime
+    if(_bus == nullptr) return -1;
+    if(_frameTransaction.isEmpty()) return 0;
+    return _bus->transfer(_frameTransaction) == I2C_OK ? 0 : -1;
 }
 
-int SSD1306::drawText(std::string text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color){
-    int16_t x1, y1;
-    uint16_t w, h;
-
-    //get text size
-    _displayObj->setTextSize(size);
-    _displayObj->getTextBounds(text.c_str(), x, y, &x1, &y1, &w, &h);
-
-    //Draw the background color
-    _displayObj->fillRect(x1, y1, w, h, bg_color);
-
-    // draw the text
-    _displayObj->setTextColor(fg_color);
-    _displayObj->setCursor(x, y);
-    _displayObj->print(text.c_str());
-
-    return 0;
-}
-
-int SSD1306::getTextSize(std::string text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t *width, uint16_t *height){
-    _displayObj->setTextSize(size);
-    _displayObj->getTextBounds(text.c_str(), x, y, real_x, real_y, width, height);
-    return 0;
+int SSD1306::sendCommands(const uint8_t* commands, size_t length){
+    I2cTransaction transaction(_i2c_address, I2cPriority::INTERACTIVE);
+    uint8_t* data = transaction.writeBulk(&SSD1306_CONTROL_COMMANDS, 1, length);
+    memcpy(data, commands, length);
+    return _bus->transfer(transaction) == I2C_OK ? 0 : -1;
 }
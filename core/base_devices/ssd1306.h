@@ -5,32 +5,44 @@
 #ifndef SSD1306_DISPLAY_H
 #define SSD1306_DISPLAY_H
 
-#include "core/kernel/device/display_device.h"
-
-class Adafruit_SSD1306;
+#include "core/kernel/device/mono_display_device.h"
+#include "core/kernel/interfaces/i2c_bus.h"
 
 struct SSD1306ConfigStruct {
     int screenWidth;  // Width of the display in pixels
     int screenHeight; // Height of the display in pixels
     uint8_t i2c_bus; // I2C bus number
+    uint8_t i2c_address = 0x3C;
+    uint32_t i2c_clock = I2C_CLOCK_FAST;  // Clock set on the bus at init, 0 to keep the current one. Many modules also work at I2C_CLOCK_FAST_PLUS
+    size_t i2c_chunk_size = 0;  // Length of the writes of a frame, 0 to keep the one of the bus. Larger chunks send less overhead
 };
 
-class SSD1306 : public DisplayDevice{
+/**
+ * @brief SSD1306 monochromatic OLED display on an I2C bus
+ * @details frames are sent through the I2cBus queue: the display is set to the window of the changed pages,
+ * then their bytes are sent as a bulk write, in chunks of the bus chunk size
+ */
+class SSD1306 : public MonoDisplayDevice{
 public:
     SSD1306(uint32_t deviceId);
     int configure(SSD1306ConfigStruct config);
     int init() override;
     int deinit(void* arg) override;
     int get_device_info(DisplayDeviceInfo_t &info) override;
-    int clearScreen() override;
-    int updateScreen() override;
-    int drawText(std::string text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color) override;
-    int getTextSize(std::string text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t* width, uint16_t* height) override;
-    
+    int sendUpdate() override;
+    int getI2cBus() const override {return _i2c_bus;}
+protected:
+    int preparePages(uint8_t first_page, uint8_t page_count, const uint8_t *pages) override;
 private:
+    int sendCommands(const uint8_t* commands, size_t length);
+
     int _screenWidth, _screenHeight;
     uint8_t _i2c_bus; // I2C bus number
-    Adafruit_SSD1306* _displayObj;
+    uint8_t _i2c_address;
+    uint32_t _i2c_clock;
+    size_t _i2c_chunk_size;
+    I2cBus* _bus;
+    I2cTransaction _frameTransaction;   //prepared by prepareUpdate, reused to avoid allocations
 
 };
 
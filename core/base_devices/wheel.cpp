@@ -51,18 +51,18 @@ void WheelDevice::device_update_isr(){
 //initialize the encoders and attach interrupts
 int WheelDevice::init(ControlDeviceInitStruct_t& init_struct){
     if(_device == nullptr) {
-        Logger::error("Wheel Device: Init error: no device available");
+        CESP_LOGE(LogModule::INPUTS, "Wheel Device: Init error: no device available");
         return -1; // Nothing to initialize
     }
 
     if(_instances.size() >= MAX_WHEEL_DEVICES) {
-        Logger::error("Wheel Device: Configuration error: maximum number of wheel devices reached (%d)", MAX_WHEEL_DEVICES);
+        CESP_LOGE(LogModule::INPUTS, "Wheel Device: Configuration error: maximum number of wheel devices reached (%d)", MAX_WHEEL_DEVICES);
         return -1; // Maximum number of devices reached
     }
 
     _input_interrupt = init_struct.input_interrupt; // Set the callback function for input manager
     if (_input_interrupt == nullptr) {
-        Logger::error("Wheel _device: Init error: no callback function provided for input manager");
+        CESP_LOGE(LogModule::INPUTS, "Wheel _device: Init error: no callback function provided for input manager");
         _instances.pop_back(); // Remove this instance from the static vector
         return -1; // Nothing to initialize
     }
@@ -70,7 +70,7 @@ int WheelDevice::init(ControlDeviceInitStruct_t& init_struct){
     //initialize the GPIO pin for the _device
     _device->encoder = new EncoderStepCounter(_device->s1_gpio, _device->s2_gpio);
     if(_device->encoder == nullptr) {
-        Logger::error("Wheel _device: Init error: unable to create encoder object for device %d", _device->deviceId);
+        CESP_LOGE(LogModule::INPUTS, "Wheel _device: Init error: unable to create encoder object for device %d", _device->deviceId);
         _instances.pop_back(); // Remove this instance from the static vector
         return -1; // Skip this _device
     }
@@ -79,7 +79,7 @@ int WheelDevice::init(ControlDeviceInitStruct_t& init_struct){
     _device->interrupt_s1 = digitalPinToInterrupt(_device->s1_gpio);
     _device->interrupt_s2 = digitalPinToInterrupt(_device->s2_gpio);
     if(_device->interrupt_s1 == NOT_AN_INTERRUPT || _device->interrupt_s2 == NOT_AN_INTERRUPT) {
-        Logger::error("Wheel _device: Init error: unable to create interrupt for device %d", _device->deviceId);
+        CESP_LOGE(LogModule::INPUTS, "Wheel _device: Init error: unable to create interrupt for device %d", _device->deviceId);
         delete _device->encoder;
         _device->encoder = nullptr; // Clean up the encoder object
         _instances.pop_back(); // Remove this instance from the static vector
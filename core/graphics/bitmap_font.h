@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef BITMAP_FONT_H
+#define BITMAP_FONT_H
+
+#include <stdint.h>
+
+/**
+ * @brief fixed size bitmap font stored column by column (bit 0 is the top row),
+ * the same layout used by the SSD1306 display memory
+ */
+struct BitmapFont{
+    const uint8_t *glyphs;  //glyph_width bytes for each character
+    uint8_t first_char, last_char;  //range of characters available in the font
+    uint8_t glyph_width;    //columns stored for each glyph
+    uint8_t advance;        //horizontal distance between two characters (glyph + spacing)
+    uint8_t line_height;    //height of a text line in pixels (max 8)
+
+    const uint8_t* getGlyph(char c) const{
+        uint8_t code = static_cast<uint8_t>(c);
+        if(code < first_char || code > last_char) code = first_char;   //fallback to the first glyph (space)
+        return glyphs + (code - first_char) * glyph_width;
+    }
+};
+
+extern const BitmapFont CESP_FONT_5X7;  //classic 5x7 font, 6x8 pixel cell
+
+#endif //BITMAP_FONT_H
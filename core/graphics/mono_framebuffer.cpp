@@ -0,0 +1,202 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/graphics/mono_framebuffer.h"
+#include "core/graphics/bitmap_font.h"
+#include "core/logging/logging.h"
+
+#include <new>
+#include <string.h>
+
+MonoFramebuffer::MonoFramebuffer() :
+    _font(CESP_FONT_5X7)
+{
+    _buffer = nullptr;
+    _bufferSize = 0;
+    _width = 0;
+    _height = 0;
+    _pages = 0;
+    _dirtyPages = 0;
+}
+
+MonoFramebuffer::~MonoFramebuffer(){
+    if(_buffer) delete[] _buffer;
+    _buffer = nullptr;
+}
+
+/**
+ * @brief allocates the framebuffer memory
+ * @return false if the size is not supported or there is no memory available
+ */
+bool MonoFramebuffer::init(uint16_t width, uint16_t height){
+    if(_buffer) delete[] _buffer;
+    _buffer = nullptr;
+
+    _pages = (height + 7) / 8;
+    if(width == 0 || _pages == 0 || _pages > 32){
+        CESP_LOGE(LogModule::GRAPHICS, "Framebuffer: unsupported size %dx%d", width, height);
+        return false;
+    }
+
+    _width = width;
+    _height = height;
+    _bufferSize = (size_t)_width * _pages;
+    _buffer = new (std::nothrow) uint8_t[_bufferSize];
+    if(!_buffer){
+        CESP_LOGE(LogModule::GRAPHICS, "Framebuffer: could not allocate %d bytes", _bufferSize);
+        return false;
+    }
+    clear(BW_Color::CESP_BLACK);
+    return true;
+}
+
+void MonoFramebuffer::clear(BW_Color color){
+    if(!_buffer) return;
+    memset(_buffer, color == BW_Color::CESP_WHITE ? 0xFF : 0x00, _bufferSize);
+    markDirty(0, _height);
+}
+
+void MonoFramebuffer::setPixel(int16_t x, int16_t y, BW_Color color){
+    if(!_buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t &byte = _buffer[(y >> 3) * _width + x];
+    if(color == BW_Color::CESP_WHITE) byte |= (1 << (y & 7));
+    else byte &= ~(1 << (y & 7));
+    _dirtyPages |= 1UL << (y >> 3);
+}
+
+void MonoFramebuffer::fillRect(int16_t x, int16_t y, int16_t width, int16_t height, BW_Color color){
+    if(!_buffer) return;
+
+    //clip to screen
+    if(x < 0){ width += x; x = 0; }
+    if(y < 0){ height += y; y = 0; }
+    if(x + width > _width) width = _width - x;
+    if(y + height > _height) height = _height - y;
+    if(width <= 0 || height <= 0) return;
+
+    uint8_t value = color == BW_Color::CESP_WHITE ? 0xFF : 0x00;
+    int16_t page = y >> 3;
+    int16_t last_row = y + height;  //exclusive
+    while(page * 8 < last_row){
+        int16_t page_top = page * 8;
+        uint8_t mask = 0xFF;
+        if(y > page_top) mask &= 0xFF << (y - page_top);
+        if(last_row < page_top + 8) mask &= 0xFF >> (page_top + 8 - last_row);
+
+        uint8_t *dst = _buffer + page * _width + x;
+        if(mask == 0xFF){
+            memset(dst, value, width);  //whole page row
+        }else{
+            for(int16_t i = 0; i < width; i++){
+                dst[i] = (dst[i] & ~mask) | (value & mask);
+            }
+        }
+        page++;
+    }
+    markDirty(y, height);
+}
+
+/**
+ * @brief draw a text with the 5x7 font. Background and foreground are written together, one byte column at a time
+ * @details when y is a multiple of 8 and size is 1 every character is just a copy of 6 bytes in the buffer
+ */
+void MonoFramebuffer::drawText(const char* text, int16_t x, int16_t y, uint8_t size, BW_Color bg_color, BW_Color fg_color){
+    if(!_buffer || text == nullptr) return;
+    if(size == 0) size = 1;
+    if(size > MAX_TEXT_SIZE) size = MAX_TEXT_SIZE;
+
+    const uint8_t fg_mask = fg_color == BW_Color::CESP_WHITE ? 0xFF : 0x00;
+    const uint8_t bg_mask = bg_color == BW_Color::CESP_WHITE ? 0xFF : 0x00;
+    const int16_t char_width = _font.advance * size;
+    const uint8_t cell_height = _font.line_height * size;
+
+    if(y >= _height || y + cell_height <= 0) return;    //nothing visible
+
+    const bool aligned = size == 1 && (y & 7) == 0 && y >= 0;
+    int16_t cursor = x;
+    for(const char* c = text; *c != '\0'; c++, cursor += char_width){
+        if(cursor >= _width) break;
+        if(cursor + char_width <= 0) continue;
+
+        const uint8_t *glyph = _font.getGlyph(*c);
+
+        //fast path: the whole character cell is on screen and aligned to a page
+        if(aligned && cursor >= 0 && cursor + char_width <= _width){
+            uint8_t *dst = _buffer + (y >> 3) * _width + cursor;
+            for(uint8_t col = 0; col < _font.advance; col++){
+                uint8_t bits = col < _font.glyph_width ? glyph[col] : 0;
+                dst[col] = (bits & fg_mask) | (~bits & bg_mask);
+            }
+            continue;
+        }
+
+        for(uint8_t col = 0; col < _font.advance; col++){
+            uint8_t bits = col < _font.glyph_width ? glyph[col] : 0;
+            uint8_t value = (bits & fg_mask) | (~bits & bg_mask);
+
+            //scale the column vertically
+            uint64_t column = value;
+            if(size > 1){
+                column = 0;
+                for(uint8_t row = 0; row < 8; row++){
+                    if(value & (1 << row)) column |= ((1ULL << size) - 1) << (row * size);
+                }
+            }
+            for(uint8_t s = 0; s < size; s++){
+                writeColumn(cursor + col * size + s, y, column, cell_height);
+            }
+        }
+    }
+    markDirty(y, cell_height);
+}
+
+/**
+ * @brief get the size of the text in pixels without drawing it
+ */
+void MonoFramebuffer::getTextSize(const char* text, uint8_t size, uint16_t *width, uint16_t *height) const{
+    if(size == 0) size = 1;
+    if(size > MAX_TEXT_SIZE) size = MAX_TEXT_SIZE;
+    size_t length = text ? strlen(text) : 0;
+    if(width) *width = length * _font.advance * size;
+    if(height) *height = length ? _font.line_height * size : 0;
+}
+
+bool MonoFramebuffer::getDirtyPages(uint8_t &first_page, uint8_t &last_page) const{
+    if(_dirtyPages == 0) return false;
+    first_page = __builtin_ctz(_dirtyPages);
+    last_page = 31 - __builtin_clz(_dirtyPages);
+    return true;
+}
+
+//write bit_count bits of a column starting at row y, across as many pages as needed
+void MonoFramebuffer::writeColumn(int16_t x, int16_t y, uint64_t bits, uint8_t bit_count){
+    if(x < 0 || x >= _width) return;
+    if(y < 0){
+        if(-y >= bit_count) return;
+        bits >>= -y;
+        bit_count += y;
+        y = 0;
+    }
+
+    uint8_t shift = y & 7;
+    uint64_t value = bits << shift;
+    uint64_t mask = (bit_count >= 64 ? ~0ULL : ((1ULL << bit_count) - 1)) << shift;
+    for(int16_t page = y >> 3; mask != 0 && page < _pages; page++){
+        uint8_t m = mask & 0xFF;
+        uint8_t &dst = _buffer[page * _width + x];
+        dst = (dst & ~m) | (value & m);
+        value >>= 8;
+        mask >>= 8;
+    }
+}
+
+void MonoFramebuffer::markDirty(int16_t y, int16_t height){
+    if(y < 0){ height += y; y = 0; }
+    if(height <= 0 || y >= _height) return;
+    int16_t last = (y + height - 1) >> 3;
+    if(last >= _pages) last = _pages - 1;
+    for(int16_t page = y >> 3; page <= last; page++){
+        _dirtyPages |= 1UL << page;
+    }
+}
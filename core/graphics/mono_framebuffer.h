@@ -0,0 +1,55 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef MONO_FRAMEBUFFER_H
+#define MONO_FRAMEBUFFER_H
+
+#include "core/kernel/device/display_device.h"  //for BW_Color
+#include "core/graphics/bitmap_font.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief 1 bit per pixel framebuffer with the same memory layout of the SSD1306 display:
+ * the screen is split in pages of 8 rows, each byte is one column of a page (bit 0 is the top row).
+ * @details The buffer can be sent as it is to the display. Text is blitted one byte column at a time.
+ */
+class MonoFramebuffer{
+public:
+    MonoFramebuffer();
+    ~MonoFramebuffer();
+    bool init(uint16_t width, uint16_t height);
+
+    uint8_t* getBuffer() { return _buffer; }
+    size_t getBufferSize() const { return _bufferSize; }
+    uint16_t getWidth() const { return _width; }
+    uint16_t getHeight() const { return _height; }
+    uint8_t getPageCount() const { return _pages; }
+
+    //drawing functions
+    void clear(BW_Color color);
+    void setPixel(int16_t x, int16_t y, BW_Color color);
+    void fillRect(int16_t x, int16_t y, int16_t width, int16_t height, BW_Color color);
+    void drawText(const char* text, int16_t x, int16_t y, uint8_t size, BW_Color bg_color, BW_Color fg_color);
+    void getTextSize(const char* text, uint8_t size, uint16_t *width, uint16_t *height) const;
+
+    //dirty pages tracking: pages changed since the last clearDirty()
+    bool getDirtyPages(uint8_t &first_page, uint8_t &last_page) const;
+    void clearDirty() { _dirtyPages = 0; }
+
+    static const uint8_t MAX_TEXT_SIZE = 7;
+private:
+    void writeColumn(int16_t x, int16_t y, uint64_t bits, uint8_t bit_count);
+    void markDirty(int16_t y, int16_t height);
+
+    uint8_t *_buffer;
+    size_t _bufferSize;
+    uint16_t _width, _height;
+    uint8_t _pages;
+    uint32_t _dirtyPages;   //one bit per page
+    const BitmapFont &_font;
+};
+
+#endif //MONO_FRAMEBUFFER_H
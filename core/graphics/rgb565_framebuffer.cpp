@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/graphics/rgb565_framebuffer.h"
+#include "core/graphics/bitmap_font.h"
+#include "core/logging/logging.h"
+
+#include <new>
+#include <string.h>
+
+Rgb565Framebuffer::Rgb565Framebuffer() :
+    _font(CESP_FONT_5X7)
+{
+    _buffer = nullptr;
+    _width = 0;
+    _height = 0;
+    _tileColumns = 0;
+    _tileRows = 0;
+}
+
+Rgb565Framebuffer::~Rgb565Framebuffer(){
+    if(_buffer) delete[] _buffer;
+    _buffer = nullptr;
+}
+
+/**
+ * @brief allocates the framebuffer memory
+ * @return false if the size is not supported or there is no memory available
+ */
+bool Rgb565Framebuffer::init(uint16_t width, uint16_t height){
+    if(_buffer) delete[] _buffer;
+    _buffer = nullptr;
+
+    if(width == 0 || height == 0){
+        CESP_LOGE(LogModule::GRAPHICS, "Framebuffer: unsupported size %dx%d", width, height);
+        return false;
+    }
+
+    _width = width;
+    _height = height;
+    _buffer = new (std::nothrow) uint16_t[(size_t)_width * _height];
+    if(!_buffer){
+        CESP_LOGE(LogModule::GRAPHICS, "Framebuffer: could not allocate %d bytes", (size_t)_width * _height * 2);
+        return false;
+    }
+    _tileColumns = (_width + RGB565_TILE_SIZE - 1) / RGB565_TILE_SIZE;
+    _tileRows = (_height + RGB565_TILE_SIZE - 1) / RGB565_TILE_SIZE;
+    _dirtyTiles.assign(((size_t)_tileColumns * _tileRows + 31) / 32, 0);
+    clear({0, 0, 0});
+    return true;
+}
+
+uint16_t Rgb565Framebuffer::toRgb565(RGB_Color color){
+    return ((color.r & 0xF8) << 8) | ((color.g & 0xFC) << 3) | (color.b >> 3);
+}
+
+uint16_t Rgb565Framebuffer::getPixel(int16_t x, int16_t y) const{
+    if(!_buffer || x < 0 || y < 0 || x >= _width || y >= _height) return 0;
+    return _buffer[y * _width + x];
+}
+
+void Rgb565Framebuffer::clear(RGB_Color color){
+    fillRect(0, 0, _width, _height, color);
+}
+
+void Rgb565Framebuffer::setPixel(int16_t x, int16_t y, RGB_Color color){
+    if(!_buffer || x < 0 || y < 0 || x >= _width || y >= _height) return;
+    _buffer[y * _width + x] = toRgb565(color);
+    markDirty(x, y, 1, 1);
+}
+
+void Rgb565Framebuffer::fillRect(int16_t x, int16_t y, int16_t width, int16_t height, RGB_Color color){
+    fillClipped(x, y, width, height, toRgb565(color));
+}
+
+/**
+ * @brief draw a text with the 5x7 font. Background and foreground are written together, one pixel block at a time
+ */
+void Rgb565Framebuffer::drawText(const char* text, int16_t x, int16_t y, uint8_t size, RGB_Color bg_color, RGB_Color fg_color){
+    if(!_buffer || text == nullptr) return;
+    if(size == 0) size = 1;
+    if(size > MAX_TEXT_SIZE) size = MAX_TEXT_SIZE;
+
+    const uint16_t fg = toRgb565(fg_color);
+    const uint16_t bg = toRgb565(bg_color);
+    const int16_t char_width = _font.advance * size;
+    const int16_t cell_height = _font.line_height * size;
+    if(y >= _height || y + cell_height <= 0) return;    //nothing visible
+
+    int16_t cursor = x;
+    for(const char* c = text; *c != '\0'; c++, cursor += char_width){
+        if(cursor >= _width) break;
+        if(cursor + char_width <= 0) continue;
+
+        const uint8_t *glyph = _font.getGlyph(*c);
+        for(uint8_t col = 0; col < _font.advance; col++){
+            int16_t px = cursor + col * size;
+            if(px + size <= 0 || px >= _width) continue;
+            uint8_t bits = col < _font.glyph_width ? glyph[col] : 0;
+
+            //consecutive rows with the same color are filled together
+            uint8_t row = 0;
+            while(row < _font.line_height){
+                bool set = bits & (1 << row);
+                uint8_t run = 1;
+                while(row + run < _font.line_height && ((bits >> (row + run)) & 1) == set) run++;
+                fillClipped(px, y + row * size, size, run * size, set ? fg : bg);
+                row += run;
+            }
+        }
+    }
+}
+
+/**
+ * @brief get the size of the text in pixels without drawing it
+ */
+void Rgb565Framebuffer::getTextSize(const char* text, uint8_t size, uint16_t *width, uint16_t *height) const{
+    if(size == 0) size = 1;
+    if(size > MAX_TEXT_SIZE) size = MAX_TEXT_SIZE;
+    size_t length = text ? strlen(text) : 0;
+    if(width) *width = length * _font.advance * size;
+    if(height) *height = length ? _font.line_height * size : 0;
+}
+
+bool Rgb565Framebuffer::isTileDirty(uint16_t column, uint16_t row) const{
+    if(column >= _tileColumns || row >= _tileRows) return false;
+    uint32_t tile = (uint32_t)row * _tileColumns + column;
+    return _dirtyTiles[tile >> 5] & (1UL << (tile & 31));
+}
+
+uint32_t Rgb565Framebuffer::getDirtyTileCount() const{
+    uint32_t count = 0;
+    for(uint32_t word : _dirtyTiles) count += __builtin_popcount(word);
+    return count;
+}
+
+void Rgb565Framebuffer::clearDirty(){
+    for(uint32_t &word : _dirtyTiles) word = 0;
+}
+
+/**
+ * @brief clear the changed tiles of a single tile row, for updates sent one piece at a time
+ */
+void Rgb565Framebuffer::clearDirtyRow(uint16_t row){
+    if(row >= _tileRows) return;
+    for(uint16_t column = 0; column < _tileColumns; column++){
+        uint32_t tile = (uint32_t)row * _tileColumns + column;
+        _dirtyTiles[tile >> 5] &= ~(1UL << (tile & 31));
+    }
+}
+
+void Rgb565Framebuffer::fillClipped(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t value){
+    if(!_buffer) return;
+
+    //clip to screen
+    if(x < 0){ width += x; x = 0; }
+    if(y < 0){ height += y; y = 0; }
+    if(x + width > _width) width = _width - x;
+    if(y + height > _height) height = _height - y;
+    if(width <= 0 || height <= 0) return;
+
+    for(int16_t row = 0; row < height; row++){
+        uint16_t *dst = _buffer + (y + row) * _width + x;
+        for(int16_t i = 0; i < width; i++) dst[i] = value;
+    }
+    markDirty(x, y, width, height);
+}
+
+//mark the tiles touched by a rectangle already clipped to the screen
+void Rgb565Framebuffer::markDirty(int16_t x, int16_t y, int16_t width, int16_t height){
+    uint16_t first_column = x / RGB565_TILE_SIZE;
+    uint16_t last_column = (x + width - 1) / RGB565_TILE_SIZE;
+    uint16_t first_row = y / RGB565_TILE_SIZE;
+    uint16_t last_row = (y + height - 1) / RGB565_TILE_SIZE;
+    for(uint16_t row = first_row; row <= last_row; row++){
+        for(uint16_t column = first_column; column <= last_column; column++){
+            uint32_t tile = (uint32_t)row * _tileColumns + column;
+            _dirtyTiles[tile >> 5] |= 1UL << (tile & 31);
+        }
+    }
+}
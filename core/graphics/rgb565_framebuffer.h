@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef RGB565_FRAMEBUFFER_H
+#define RGB565_FRAMEBUFFER_H
+
+#include "core/kernel/device/display_device.h"  //for RGB_Color
+#include "core/graphics/bitmap_font.h"
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace{
+    const uint8_t RGB565_TILE_SIZE = 16;   //side of a damage tile in pixels
+};
+
+/**
+ * @brief 16 bit per pixel (RGB565) framebuffer, one pixel per uint16_t, row by row.
+ * @details the screen is split in tiles of RGB565_TILE_SIZE pixels. Drawing marks the tiles it touches,
+ * so that only the changed tiles are converted and sent to the display
+ */
+class Rgb565Framebuffer{
+public:
+    Rgb565Framebuffer();
+    ~Rgb565Framebuffer();
+    bool init(uint16_t width, uint16_t height);
+
+    uint16_t* getBuffer() { return _buffer; }
+    uint16_t getWidth() const { return _width; }
+    uint16_t getHeight() const { return _height; }
+    uint16_t getPixel(int16_t x, int16_t y) const;
+
+    //drawing functions
+    void clear(RGB_Color color);
+    void setPixel(int16_t x, int16_t y, RGB_Color color);
+    void fillRect(int16_t x, int16_t y, int16_t width, int16_t height, RGB_Color color);
+    void drawText(const char* text, int16_t x, int16_t y, uint8_t size, RGB_Color bg_color, RGB_Color fg_color);
+    void getTextSize(const char* text, uint8_t size, uint16_t *width, uint16_t *height) const;
+
+    //tile damage tracking: tiles changed since the last clearDirty()
+    uint16_t getTileColumns() const { return _tileColumns; }
+    uint16_t getTileRows() const { return _tileRows; }
+    bool isTileDirty(uint16_t column, uint16_t row) const;
+    uint32_t getDirtyTileCount() const;
+    void clearDirty();
+    void clearDirtyRow(uint16_t row);
+
+    static uint16_t toRgb565(RGB_Color color);
+    static const uint8_t MAX_TEXT_SIZE = 7;
+private:
+    void fillClipped(int16_t x, int16_t y, int16_t width, int16_t height, uint16_t value);
+    void markDirty(int16_t x, int16_t y, int16_t width, int16_t height);
+
+    uint16_t *_buffer;
+    uint16_t _width, _height;
+    uint16_t _tileColumns, _tileRows;
+    std::vector <uint32_t> _dirtyTiles;    //one bit per tile, row by row
+    const BitmapFont &_font;
+};
+
+#endif //RGB565_FRAMEBUFFER_H
@@ -9,6 +9,9 @@
 #include "core/kernel/components/interface_manager.h"
 #include "core/kernel/device/display_device.h"
 #include "core/kernel/components/device_manager.h"
+#include "core/tracing/tracer.h"
+#include "core/stats/stats_registry.h"
+#include "core/programs/top_program.h"
 
 ChibiKernel* ChibiKernel::instance = nullptr;
 
@@ -17,22 +20,33 @@ ChibiKernel::ChibiKernel() :
 {
   _interfaceManager = new InterfaceManager();
   _deviceManager = new DeviceManager();
+  _loopStat = StatsRegistry::counter("kernel.loops");
+  _freeHeapStat = StatsRegistry::gauge("heap.free");
+  _minFreeHeapStat = StatsRegistry::gauge("heap.min_free");
 }
 
 int ChibiKernel::init(){
 
   instance = this; // Set the static instance pointer
 
-  Logger::init();
-  Logger::info("Starting ChibiKernel..");
   //get what core is reserved for kernel and for usermode
   _kernelCoreId = xPortGetCoreID();
   _userModeCoreId = 1 - _kernelCoreId;
+
+  //the log writer formats and sends the messages on the user core, away from the kernel loop
+  if(Logger::init(_userModeCoreId) < 0){
+    //without the writer the messages stay in the rings: report it on the port directly and keep going
+    Serial.println("ChibiKernel: could not start the log writer, log messages are dropped");
+  }
+  CESP_LOGI(LogModule::KERNEL, "Starting ChibiKernel..");
   _slow_loop_timer = millis();
 
   _task_manager.Init(); // Initialize the task manager
 
-  Logger::info("Kernel running on core %d", _kernelCoreId);
+  //built-in programs
+  _program_manager.register_program(CESP_Program("top", top_program_setup, top_program_loop, top_program_closeup));
+
+  CESP_LOGI(LogModule::KERNEL, "Kernel running on core %d", _kernelCoreId);
 
   return 0;
 }
@@ -40,7 +54,8 @@ int ChibiKernel::init(){
 void ChibiKernel::init_kernel_devices(){
 
   _deviceManager->init_control_input_devices(ChibiKernel::input_interrupt_callback); // Initialize control input devices
-  _deviceManager->init_display_devices(); // Initialize display devices
+  _deviceManager->init_display_devices(_interfaceManager, _kernelCoreId); // Initialize display devices and their flush tasks
+  _deviceManager->init_sensor_devices(_interfaceManager, _kernelCoreId); // Initialize sensor devices and start sampling them
 }
 
 // Static wrapper function for wheel inputs
@@ -63,31 +78,75 @@ DisplayDevice* ChibiKernel::getDisplayDevice(uint32_t deviceId){
   return _deviceManager->get_display_device_by_id(deviceId); // Get the display device by id
 }
 
+DisplayCompositor* ChibiKernel::getDisplayCompositor(uint32_t deviceId){
+  return _deviceManager->get_display_compositor(deviceId);
+}
+
+int ChibiKernel::register_sensor_device(SensorDevice* device, uint32_t period, size_t historyLength){
+  return _deviceManager->register_sensor_device(device, period, historyLength); // Register the device with the device manager
+}
+
+SensorDevice* ChibiKernel::getSensorDevice(uint32_t deviceId){
+  return _deviceManager->get_sensor_device_by_id(deviceId);
+}
+
+SensorSubscription ChibiKernel::subscribeSensor(uint32_t deviceId){
+  return SensorSubscription(_deviceManager->get_sensor_buffer(deviceId));
+}
+
+int ChibiKernel::setSensorPeriod(uint32_t deviceId, uint32_t period){
+  return _deviceManager->set_sensor_period(deviceId, period);
+}
+
 void ChibiKernel::update_device_state(){
   _deviceManager->update_control_input_devices_state(); // Update the state of control input devices
 }
 
 void ChibiKernel::loop(){
+  CESP_TRACE_SCOPE("kernel_loop");
   // update hardware state
   update_device_state();
+  if(_loopStat) _loopStat->add();
 
   //unfrequent tasks
   if(millis() - _slow_loop_timer){
     _slow_loop_timer = millis();
     _task_manager.update();
     _input_manager.update();
+    if(_freeHeapStat) _freeHeapStat->set(ESP.getFreeHeap());
+    if(_minFreeHeapStat) _minFreeHeapStat->set(ESP.getMinFreeHeap());
   }
 
 }
 
 bool ChibiKernel::registerI2cInterface(int bus, int sda_pin, int scl_pin){
-  return _interfaceManager->registerI2cInterface(bus, sda_pin, scl_pin);
+  return _interfaceManager->registerI2cInterface(bus, sda_pin, scl_pin, _kernelCoreId);
+}
+
+bool ChibiKernel::registerI2cInterface(int bus, I2cBackend* backend){
+  return _interfaceManager->registerI2cInterface(bus, backend, _kernelCoreId);
 }
 
 TwoWire* ChibiKernel::getI2cInterface(int bus){
   return _interfaceManager->getI2cInterface(bus);
 }
 
+I2cBus* ChibiKernel::getI2cBus(int bus){
+  return _interfaceManager->getI2cBus(bus);
+}
+
+bool ChibiKernel::registerSpiInterface(int bus, int sck_pin, int miso_pin, int mosi_pin){
+  return _interfaceManager->registerSpiInterface(bus, sck_pin, miso_pin, mosi_pin);
+}
+
+bool ChibiKernel::registerSpiInterface(int bus, SpiBackend* backend){
+  return _interfaceManager->registerSpiInterface(bus, backend);
+}
+
+SpiBus* ChibiKernel::getSpiBus(int bus){
+  return _interfaceManager->getSpiBus(bus);
+}
+
 int ChibiKernel::register_input_listener(InputListener *&listener){
   return _input_manager.createInputListener(listener); // Register a new input listener
 }
@@ -182,3 +241,11 @@ bool ChibiKernel::isTaskRunning(const uint8_t taskID){
 bool ChibiKernel::isProgramRunning(const std::string programName){
   return _task_manager.is_program_alive(programName);
 }
+
+/**
+ * * @brief gets the information of all the tasks, including their loop count and cpu time
+ * * @param list filled with one entry for each task
+ */
+void ChibiKernel::getTaskInfoList(std::vector<CESP_TaskInfo_t>& list){
+  _task_manager.get_task_info_list(list);
+}
@@ -9,12 +9,21 @@
 #include "core/kernel/components/program_manager.h"
 #include "core/kernel/components/task_manager.h"
 #include "core/kernel/components/device_manager.h"
+#include "core/kernel/components/sensor_buffer.h"
 
 class InputListener;
 class DisplayDevice;
+class DisplayCompositor;
+class SensorDevice;
 class InterfaceManager;
 class TwoWire;
+class I2cBus;
+class I2cBackend;
+class SpiBus;
+class SpiBackend;
 class ControlInputDevice;
+class StatCounter;
+class StatGauge;
 
 class ChibiKernel{
 public:
@@ -26,6 +35,7 @@ public:
   InputManager& get_input_manager() { return _input_manager; } // Getter for input manager instance
   int register_control_input_device(ControlInputDevice* device);
   int register_display_device(DisplayDevice* device);
+  int register_sensor_device(SensorDevice* device, uint32_t period, size_t historyLength = SENSOR_DEFAULT_HISTORY);
 
   //program functions
   int createProgram(CESP_Program program);
@@ -34,6 +44,7 @@ public:
   int quitTask(const uint8_t taskID); // Gracefully quit a task by ID
   bool isTaskRunning(const uint8_t taskID);
   bool isProgramRunning(const std::string programName);
+  void getTaskInfoList(std::vector<CESP_TaskInfo_t>& list);
 
   //input functions (Internal use only)
   int register_input_listener(InputListener *&listener); // Register an input listener
@@ -48,10 +59,21 @@ public:
 
   //devices getter
   DisplayDevice* getDisplayDevice(uint32_t deviceId);
+  DisplayCompositor* getDisplayCompositor(uint32_t deviceId);
+  SensorDevice* getSensorDevice(uint32_t deviceId);
+
+  //sensors
+  SensorSubscription subscribeSensor(uint32_t deviceId);
+  int setSensorPeriod(uint32_t deviceId, uint32_t period);
 
   //interfaces
   bool registerI2cInterface(int bus, int sda_pin, int scl_pin);
+  bool registerI2cInterface(int bus, I2cBackend* backend);
   TwoWire* getI2cInterface(int bus);
+  I2cBus* getI2cBus(int bus);
+  bool registerSpiInterface(int bus, int sck_pin, int miso_pin, int mosi_pin);
+  bool registerSpiInterface(int bus, SpiBackend* backend);
+  SpiBus* getSpiBus(int bus);
 
   //core ids
   int getKernelCoreId() const { return _kernelCoreId; } // Getter for kernel core ID
@@ -73,6 +95,11 @@ private:
 
   uint32_t _slow_loop_timer;
 
+  //statistics
+  StatCounter* _loopStat;
+  StatGauge* _freeHeapStat;
+  StatGauge* _minFreeHeapStat;
+
   //navigation events
   InputEvent _upNavEvent; // Navigation up event
   InputEvent _downNavEvent; // Navigation down event
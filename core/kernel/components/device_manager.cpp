@@ -5,6 +5,12 @@
 #include "core/kernel/components/device_manager.h"
 #include "core/kernel/device/control_input_device.h"
 #include "core/kernel/device/display_device.h"
+#include "core/kernel/components/display_compositor.h"
+#include "core/kernel/device/sensor_device.h"
+#include "core/kernel/components/sensor_buffer.h"
+#include "core/kernel/components/sensor_sampler.h"
+#include "core/kernel/components/interface_manager.h"
+#include "core/kernel/interfaces/i2c_bus.h"
 #include "core/logging/logging.h"
 
 #include <mutex>
@@ -13,7 +19,7 @@ int DeviceManager::register_control_input_device(ControlInputDevice* device){
     std::lock_guard<std::mutex> lock(_controlInputDeviceMutex); // Lock the mutex for thread safety
     for (const auto& existing_device : _regControlInputDevices) {
         if (existing_device.device->get_device_id() == device->get_device_id()) {
-            Logger::error("Input device %d is already registered", device->get_device_id());
+            CESP_LOGE(LogModule::DEVICE, "Input device %d is already registered", device->get_device_id());
             return -1; // Device already registered
         }
     }
@@ -22,24 +28,23 @@ int DeviceManager::register_control_input_device(ControlInputDevice* device){
     ControlInputControlStruct_t device_struct;
     device_struct.device = device;
     _regControlInputDevices.push_back(device_struct);
-    Logger::info("Input device %d registered", device->get_device_id());
+    CESP_LOGI(LogModule::DEVICE, "Input device %d registered", device->get_device_id());
     return 0; // Success
 }
 
 int DeviceManager::register_display_device(DisplayDevice* device){
     std::lock_guard<std::mutex> lock(_displayDeviceMutex); // Lock the mutex for thread safety
-    for (const auto& existing_device : _regDisplayDevices) {
-        if (existing_device.device->get_device_id() == device->get_device_id()) {
-            Logger::error("Display device %d is already registered", device->get_device_id());
-            return -1; // Device already registered
-        }
+    if (_regDisplayDevices.find(device->get_device_id()) != _regDisplayDevices.end()) {
+        CESP_LOGE(LogModule::DEVICE, "Display device %d is already registered", device->get_device_id());
+        return -1; // Device already registered
     }
 
     // Register the new device
     DisplayControlStruct_t device_struct;
     device_struct.device = device;
-    _regDisplayDevices.push_back(device_struct);
-    Logger::info("Display device %d registered", device->get_device_id());
+    device_struct.compositor = nullptr;
+    _regDisplayDevices[device->get_device_id()] = device_struct;
+    CESP_LOGI(LogModule::DEVICE, "Display device %d registered", device->get_device_id());
     return 0; // Success
 }
 
@@ -49,21 +54,33 @@ void DeviceManager::init_control_input_devices(void input_interrupt_callback(Inp
         ControlDeviceInitStruct_t init_struct;
         init_struct.input_interrupt = input_interrupt_callback; // Set the input interrupt callback function
         if(inputDevice.device->init(init_struct) < 0){
-            Logger::error("Failed to initialize control input device %d", inputDevice.device->get_device_id());
+            CESP_LOGE(LogModule::DEVICE, "Failed to initialize control input device %d", inputDevice.device->get_device_id());
         }else{
-            Logger::info("Control input device %d initialized", inputDevice.device->get_device_id());
+            CESP_LOGI(LogModule::DEVICE, "Control input device %d initialized", inputDevice.device->get_device_id());
         }
     }
 }
 
-void DeviceManager::init_display_devices(){
+/**
+ * @brief initialize the display devices and start a compositor for each one
+ * @param interfaceManager used to get the bus of the displays, so that displays on the same bus are not sent together
+ * @param flushCoreId core that runs the flush tasks of the compositors
+ */
+void DeviceManager::init_display_devices(InterfaceManager* interfaceManager, int flushCoreId){
+    std::lock_guard<std::mutex> lock(_displayDeviceMutex); // Lock the mutex for thread safety
     // Initialize display devices
-    for (auto& displayDevice : _regDisplayDevices) {
+    for (auto& entry : _regDisplayDevices) {
+        DisplayControlStruct_t &displayDevice = entry.second;
         if(displayDevice.device->init() < 0){
-            Logger::error("Failed to initialize display device %d", displayDevice.device->get_device_id());
-        }else{
-            Logger::info("Display device %d initialized", displayDevice.device->get_device_id());
+            CESP_LOGE(LogModule::DEVICE, "Failed to initialize display device %d", displayDevice.device->get_device_id());
+            continue;
         }
+        CESP_LOGI(LogModule::DEVICE, "Display device %d initialized", displayDevice.device->get_device_id());
+
+        int busNumber = displayDevice.device->getI2cBus();
+        I2cBus* bus = busNumber >= 0 ? interfaceManager->getI2cBus(busNumber) : nullptr;
+        displayDevice.compositor = new DisplayCompositor(displayDevice.device, bus);
+        displayDevice.compositor->start(flushCoreId);
     }
 }
 
@@ -71,7 +88,7 @@ int DeviceManager::update_control_input_devices_state(){
     std::lock_guard<std::mutex> lock(_controlInputDeviceMutex); // Lock the mutex for thread safety
     for (auto& inputDevice : _regControlInputDevices) {
         if(inputDevice.device->update() < 0){
-            //Logger::error("Failed to update control input device %s", inputDevice.device->get_name().c_str());
+            //CESP_LOGE(LogModule::DEVICE, "Failed to update control input device %s", inputDevice.device->get_name().c_str());
         }
     }
     return 0; // Success
@@ -79,10 +96,87 @@ int DeviceManager::update_control_input_devices_state(){
 
 DisplayDevice* DeviceManager::get_display_device_by_id(uint32_t deviceId){
     std::lock_guard<std::mutex> lock(_displayDeviceMutex); // Lock the mutex for thread safety
-    for (auto& displayDevice : _regDisplayDevices) {
-        if(displayDevice.device->get_device_id() == deviceId){
-            return displayDevice.device; // Return the device if found
+    auto it = _regDisplayDevices.find(deviceId);
+    if(it == _regDisplayDevices.end()) return nullptr; // Device not found
+    return it->second.device;
+}
+
+DisplayCompositor* DeviceManager::get_display_compositor(uint32_t deviceId){
+    std::lock_guard<std::mutex> lock(_displayDeviceMutex); // Lock the mutex for thread safety
+    auto it = _regDisplayDevices.find(deviceId);
+    if(it == _regDisplayDevices.end()) return nullptr; // Device not found
+    return it->second.compositor;
+}
+/**
+ * @brief register a sensor, read by the kernel sampler once the devices are initialized
+ * @param period sampling period in milliseconds, 0 to not sample it until set_sensor_period
+ * @param historyLength samples kept for the subscribed tasks
+ */
+int DeviceManager::register_sensor_device(SensorDevice* device, uint32_t period, size_t historyLength){
+    std::lock_guard<std::mutex> lock(_sensorDeviceMutex); // Lock the mutex for thread safety
+    if (_regSensorDevices.find(device->get_device_id()) != _regSensorDevices.end()) {
+        CESP_LOGE(LogModule::DEVICE, "Sensor device %d is already registered", device->get_device_id());
+        return -1; // Device already registered
+    }
+
+    // Register the new device
+    SensorControlStruct_t device_struct;
+    device_struct.device = device;
+    device_struct.buffer = new SensorBuffer(historyLength);
+    device_struct.period = period;
+    _regSensorDevices[device->get_device_id()] = device_struct;
+    CESP_LOGI(LogModule::DEVICE, "Sensor device %d registered", device->get_device_id());
+    return 0; // Success
+}
+
+/**
+ * @brief initialize the sensor devices and start sampling them
+ * @param interfaceManager used to get the bus of the sensors, so that the reads of a bus are batched
+ * @param samplerCoreId core of the sampler task
+ */
+void DeviceManager::init_sensor_devices(InterfaceManager* interfaceManager, int samplerCoreId){
+    std::lock_guard<std::mutex> lock(_sensorDeviceMutex); // Lock the mutex for thread safety
+    if(_regSensorDevices.empty()) return;
+    if(_sensorSampler == nullptr) _sensorSampler = new SensorSampler();
+
+    for (auto& entry : _regSensorDevices) {
+        SensorControlStruct_t &sensorDevice = entry.second;
+        if(sensorDevice.device->init() < 0){
+            CESP_LOGE(LogModule::DEVICE, "Failed to initialize sensor device %d", sensorDevice.device->get_device_id());
+            continue;
         }
+        CESP_LOGI(LogModule::DEVICE, "Sensor device %d initialized", sensorDevice.device->get_device_id());
+
+        int busNumber = sensorDevice.device->getI2cBus();
+        I2cBus* bus = busNumber >= 0 ? interfaceManager->getI2cBus(busNumber) : nullptr;
+        _sensorSampler->addSensor(sensorDevice.device, sensorDevice.buffer, bus, sensorDevice.period);
     }
-    return nullptr; // Device not found
-}
\ No newline at end of file
+    _sensorSampler->start(samplerCoreId);
+}
+
+SensorDevice* DeviceManager::get_sensor_device_by_id(uint32_t deviceId){
+    std::lock_guard<std::mutex> lock(_sensorDeviceMutex); // Lock the mutex for thread safety
+    auto it = _regSensorDevices.find(deviceId);
+    if(it == _regSensorDevices.end()) return nullptr; // Device not found
+    return it->second.device;
+}
+
+SensorBuffer* DeviceManager::get_sensor_buffer(uint32_t deviceId){
+    std::lock_guard<std::mutex> lock(_sensorDeviceMutex); // Lock the mutex for thread safety
+    auto it = _regSensorDevices.find(deviceId);
+    if(it == _regSensorDevices.end()) return nullptr; // Device not found
+    return it->second.buffer;
+}
+
+/**
+ * @brief change the sampling period of a sensor
+ * @param period milliseconds, 0 to stop the sampling
+ */
+int DeviceManager::set_sensor_period(uint32_t deviceId, uint32_t period){
+    std::lock_guard<std::mutex> lock(_sensorDeviceMutex); // Lock the mutex for thread safety
+    auto it = _regSensorDevices.find(deviceId);
+    if(it == _regSensorDevices.end()) return -1; // Device not found
+    it->second.period = period;
+    if(_sensorSampler) _sensorSampler->setPeriod(deviceId, period);
+    return 0;
+}
@@ -6,12 +6,18 @@
 #define DEVICE_MANAGER_H
 
 #include <vector>
+#include <map>
 #include <mutex>
 
 #include "core/structs/input_structs.h"
 
 class ControlInputDevice;
 class DisplayDevice;
+class DisplayCompositor;
+class InterfaceManager;
+class SensorDevice;
+class SensorBuffer;
+class SensorSampler;
 
 struct ControlInputControlStruct_t{
     ControlInputDevice* device;
@@ -19,29 +25,47 @@ struct ControlInputControlStruct_t{
 
 struct DisplayControlStruct_t{
     DisplayDevice* device;
+    DisplayCompositor* compositor;  //nullptr until the device is initialized
+};
+
+struct SensorControlStruct_t{
+    SensorDevice* device;
+    SensorBuffer* buffer;   //last samples, read by the subscribed tasks
+    uint32_t period;        //sampling period in milliseconds
 };
 
 class DeviceManager {
 public:
     int register_control_input_device(ControlInputDevice* device);
     int register_display_device(DisplayDevice* device);
+    int register_sensor_device(SensorDevice* device, uint32_t period, size_t historyLength);
 
     void init_control_input_devices(void input_interrupt_callback(InputEvent &event));
-    void init_display_devices();
+    void init_display_devices(InterfaceManager* interfaceManager, int flushCoreId);
+    void init_sensor_devices(InterfaceManager* interfaceManager, int samplerCoreId);
 
     //control input device functions
     int update_control_input_devices_state();
 
     //display device functions
     DisplayDevice*  get_display_device_by_id(uint32_t deviceId);
+    DisplayCompositor* get_display_compositor(uint32_t deviceId);
+
+    //sensor device functions
+    SensorDevice* get_sensor_device_by_id(uint32_t deviceId);
+    SensorBuffer* get_sensor_buffer(uint32_t deviceId);
+    int set_sensor_period(uint32_t deviceId, uint32_t period);
 private:
     //mutexes 
     std::mutex _displayDeviceMutex;
     std::mutex _controlInputDeviceMutex;
+    std::mutex _sensorDeviceMutex;
 
     //registered devices
     std::vector <ControlInputControlStruct_t> _regControlInputDevices; // List of input devices registered
-    std::vector <DisplayControlStruct_t> _regDisplayDevices; // List of devices registered
+    std::map <uint32_t, DisplayControlStruct_t> _regDisplayDevices; // Display devices registered, by device id
+    std::map <uint32_t, SensorControlStruct_t> _regSensorDevices; // Sensor devices registered, by device id
+    SensorSampler* _sensorSampler = nullptr; // Created when the sensors are initialized
 };
 
 #endif // DEVICE_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,112 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/components/display_compositor.h"
+#include "core/kernel/device/display_device.h"
+#include "core/kernel/interfaces/i2c_bus.h"
+#include "core/logging/logging.h"
+#include "core/tracing/tracer.h"
+#include "core/stats/stats_registry.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <mutex>
+#include <atomic>
+
+DisplayCompositor::DisplayCompositor(DisplayDevice* device, I2cBus* bus) :
+    _device(device),
+    _bus(bus),
+    _lastOwner(nullptr),
+    _flushPending(false),
+    _flushCount(0),
+    _flushTaskHandle(nullptr)
+{
+    _flushStat = StatsRegistry::counter("display.flushes");
+    _sendTimeStat = StatsRegistry::histogram("display.send_us");
+}
+
+DisplayCompositor::~DisplayCompositor(){
+    if(_flushTaskHandle) vTaskDelete(_flushTaskHandle);
+}
+
+/**
+ * @brief start the flush task of the display
+ * @param coreId core where the task runs
+ * @return false if the task could not be created: frames are then sent by the renderer in endFrame
+ */
+bool DisplayCompositor::start(int coreId){
+    if(_flushTaskHandle) return true;
+    //the driver runs here: bus transfers, and log calls that format the message on this stack
+    if(xTaskCreatePinnedToCore(flushTaskWrapper, "DisplayFlush", 4096, this, 1, &_flushTaskHandle, coreId) != pdPASS){
+        CESP_LOGE(LogModule::DEVICE, "Display %d: could not create the flush task", _device->get_device_id());
+        _flushTaskHandle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief get exclusive access to the display to draw a frame. Must be followed by endFrame
+ * @param owner the renderer that draws
+ * @return false if another renderer drew on the display since the last frame of the owner: the screen must be drawn from scratch
+ */
+bool DisplayCompositor::beginFrame(const void* owner){
+    _drawMutex.lock();
+    bool sameOwner = _lastOwner == owner;
+    _lastOwner = owner;
+    return sameOwner;
+}
+
+/**
+ * @brief release the display and, if something was drawn, schedule the frame to be sent
+ */
+void DisplayCompositor::endFrame(bool changed){
+    if(changed && _flushTaskHandle == nullptr){
+        CESP_TRACE_SCOPE("display_update");
+        _device->updateScreen();    //no flush task: send the frame right away
+        changed = false;
+    }
+    _drawMutex.unlock();
+    if(!changed) return;
+
+    //frames drawn while a flush is running are merged in the next flush
+    _flushPending.store(true);
+    xTaskNotifyGive(_flushTaskHandle);
+}
+
+void DisplayCompositor::flush_task_function(){
+    while(true){
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if(!_flushPending.exchange(false)) continue;
+
+        //the copy is quick: renderers are blocked only for it, not for the transfer.
+        //Devices with a bounded send buffer copy and send a large update in several pieces
+        uint32_t start = micros();
+        bool pending;
+        do{
+            {
+                CESP_TRACE_SCOPE("display_prepare");
+                std::lock_guard <std::mutex> lock(_drawMutex);
+                _device->prepareUpdate();
+                pending = _device->hasPendingUpdate();
+            }
+
+            CESP_TRACE_SCOPE("display_send");
+            if(_bus){
+                _bus->run(sendFunction, _device, I2cPriority::INTERACTIVE);
+            }else{
+                _device->sendUpdate();
+            }
+        }while(pending);
+        _flushCount++;
+        if(_flushStat) _flushStat->add();
+        if(_sendTimeStat) _sendTimeStat->record(micros() - start);
+    }
+}
+
+//run by the bus worker
+int DisplayCompositor::sendFunction(void* context){
+    return static_cast<DisplayDevice*>(context)->sendUpdate() < 0 ? I2C_ERROR_BUS : I2C_OK;
+}
@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef DISPLAY_COMPOSITOR_H
+#define DISPLAY_COMPOSITOR_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <mutex>
+#include <atomic>
+#include <stdint.h>
+
+class DisplayDevice;
+class I2cBus;
+class StatCounter;
+class StatHistogram;
+
+/**
+ * @brief owns the access to a display device. Renderers draw into the display between beginFrame and endFrame,
+ * then a flush task on the kernel core sends the frame to the screen. Each display has its own flush task, so
+ * displays on different buses are refreshed at the same time. On an I2C bus the frames are sent through the bus queue
+ * with high priority, so they are serialized with the other clients of the bus
+ */
+class DisplayCompositor{
+public:
+    DisplayCompositor(DisplayDevice* device, I2cBus* bus);
+    ~DisplayCompositor();
+    bool start(int coreId);
+
+    //drawing functions, called by the renderers
+    bool beginFrame(const void* owner);
+    void endFrame(bool changed);
+
+    DisplayDevice* getDevice() const {return _device;}
+    uint32_t getFlushCount() const {return _flushCount.load();}
+
+    static void flushTaskWrapper(void* arg){
+        static_cast<DisplayCompositor*>(arg)->flush_task_function();
+    }
+private:
+    void flush_task_function();
+    static int sendFunction(void* context);
+
+    DisplayDevice* const _device;
+    I2cBus* const _bus;     //nullptr if the display is not on an I2C bus
+    std::mutex _drawMutex;      //held while a renderer draws and while the frame is copied for sending
+    const void* _lastOwner;     //renderer that drew the current screen content
+    std::atomic <bool> _flushPending;
+    std::atomic <uint32_t> _flushCount;
+    TaskHandle_t _flushTaskHandle;
+
+    //statistics of all the displays
+    StatCounter* _flushStat;
+    StatHistogram* _sendTimeStat;   //microseconds to send a frame
+};
+
+#endif //DISPLAY_COMPOSITOR_H
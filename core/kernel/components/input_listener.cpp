@@ -29,12 +29,18 @@ bool InputListener::pushEvent(InputEvent event){
     }
 }
 
+//events waiting to be read
+size_t InputListener::getEventCount(){
+    std::lock_guard<std::mutex> lock(_eventMutex);
+    return _events.size();
+}
+
 bool InputListener::getEvent(InputEvent &event){
     std::lock_guard<std::mutex> lock(_eventMutex); // Lock the mutex for thread safety
     if (!_events.empty()) {
         event = _events.front(); // Get the front event
         _events.pop_front(); // Remove it from the queue
-        //Logger::info("Popped event, total size: %d", _events.size());
+        CESP_LOGD(LogModule::INPUTS, "Popped event, total size: %d", _events.size());
         return true; // Event popped successfully
     }
     return false; // No events to pop
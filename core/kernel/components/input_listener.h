@@ -18,6 +18,7 @@ public:
     bool getEvent (InputEvent &event);
     void clearEvents();
     bool pushEvent(InputEvent event);
+    size_t getEventCount();
     void destroy();
     bool isAlive();
 private:
@@ -5,6 +5,14 @@
 #include "core/kernel/components/input_manager.h"
 #include "core/kernel/components/input_listener.h"
 #include "core/logging/logging.h"
+#include "core/tracing/tracer.h"
+#include "core/stats/stats_registry.h"
+
+InputManager::InputManager(){
+    _eventsStat = StatsRegistry::counter("input.events");
+    _listenersStat = StatsRegistry::gauge("input.listeners");
+    _queueStat = StatsRegistry::gauge("input.queue_max");
+}
 
 /**
  * @brief Creates a new input listener and registers it with the input manager.
@@ -23,7 +31,7 @@ int InputManager::createInputListener(InputListener *&listener){
         }
         ++listenerId;
         if(listenerId >= 500){
-            Logger::error("InputManager: Too many input listeners");
+            CESP_LOGE(LogModule::INPUTS, "InputManager: Too many input listeners");
             return -1; // Error: no available listener ID
         }
     }
@@ -31,23 +39,28 @@ int InputManager::createInputListener(InputListener *&listener){
     InputListener *new_listener = new InputListener();
     _inputListeners[listenerId] = new_listener;
     listener = new_listener; // Assign the listener to the provided pointer
-    Logger::info("InputManager: Listener ID %d created", listenerId); // Log the creation of the listener
+    CESP_LOGI(LogModule::INPUTS, "InputManager: Listener ID %d created", listenerId); // Log the creation of the listener
     return listenerId; // Return the ID of the newly created listener    
 }
 
 void InputManager::update(){
     std::lock_guard<std::mutex> lock(_mutex); // Lock the mutex for thread safety
 
+    size_t queue_max = 0;
     for (auto it = _inputListeners.begin(); it != _inputListeners.end(); ) {
         InputListener *listener = it->second;
         if (!listener->isAlive()) { // Verifica se il listener non è vivo
-            Logger::info("InputManager: Removing dead listener ID %d", it->first);
+            CESP_LOGI(LogModule::INPUTS, "InputManager: Removing dead listener ID %d", it->first);
             delete listener;
             it = _inputListeners.erase(it); // Rimuovi il listener e aggiorna l'iteratore
         } else {
+            size_t queued = listener->getEventCount();
+            if(queued > queue_max) queue_max = queued;
             ++it; // Passa al prossimo elemento
         }
     }
+    if(_listenersStat) _listenersStat->set(_inputListeners.size());
+    if(_queueStat) _queueStat->set(queue_max);
 }
 
 void InputManager::input_interrupt_callback(InputEvent &event){
@@ -56,10 +69,13 @@ void InputManager::input_interrupt_callback(InputEvent &event){
 
 
 void InputManager::dispatchEvent(InputEvent event){
+    CESP_TRACE_SCOPE("dispatch_event");
+    if(_eventsStat) _eventsStat->add();
     std::lock_guard<std::mutex> lock(_mutex); // Lock the mutex for thread safety
 
     for(auto it = _inputListeners.begin(); it != _inputListeners.end(); it++) {
         InputListener *listener = it->second;
         listener->pushEvent(event);
     }
+    CESP_LOGD(LogModule::INPUTS, "InputManager: Event type %d from device %d sent to %d listeners", (int)event.type, event.deviceID, _inputListeners.size());
 }
\ No newline at end of file
@@ -18,10 +18,12 @@
 #include "core/structs/input_structs.h"
 
 class InputListener;
+class StatCounter;
+class StatGauge;
 
 class InputManager {
 public:
-    InputManager() = default;
+    InputManager();
     ~InputManager() = default;
 
     int createInputListener(InputListener *&listener);
@@ -34,6 +36,11 @@ private:
 
     std::map <uint16_t, InputListener*> _inputListeners; // List of input destination callbacks
     std::mutex _mutex; // Mutex for thread safety
+
+    //statistics
+    StatCounter* _eventsStat;
+    StatGauge* _listenersStat;
+    StatGauge* _queueStat;  //events waiting in the fullest listener
 };
 
 #endif //INPUT_MANAGER_H
\ No newline at end of file
@@ -4,13 +4,18 @@
 
 #include "core/kernel/components/interface_manager.h"
 #include "core/kernel/interfaces/i2c_bus.h"
+#include "core/kernel/interfaces/spi_bus.h"
 #include "core/logging/logging.h"
 
 #include <map>
 
 class TwoWire;
 
-bool InterfaceManager::registerI2cInterface(int bus, int sda_pin, int scl_pin){
+/**
+ * @brief create the I2c interface of a hardware bus and start its worker
+ * @param workerCoreId core that runs the transactions of the bus
+ */
+bool InterfaceManager::registerI2cInterface(int bus, int sda_pin, int scl_pin, int workerCoreId){
     if(bus > 255 || bus < 0){
         return false;
     }
@@ -19,14 +24,33 @@ bool InterfaceManager::registerI2cInterface(int bus, int sda_pin, int scl_pin){
     if(_i2cInterfaces.find(bus) != _i2cInterfaces.end()){
         return false;
     }    
-    I2cBus* newBus = new I2cBus(bus, sda_pin, scl_pin);
+    return addI2cBus(new I2cBus(bus, sda_pin, scl_pin), workerCoreId);
+}
+
+/**
+ * @brief create a bus that transfers through a custom backend, like a SimulatedI2cBackend. The backend is not owned
+ */
+bool InterfaceManager::registerI2cInterface(int bus, I2cBackend* backend, int workerCoreId){
+    if(bus > 255 || bus < 0 || backend == nullptr){
+        return false;
+    }
+    if(_i2cInterfaces.find(bus) != _i2cInterfaces.end()){
+        return false;
+    }
+    return addI2cBus(new I2cBus(bus, backend), workerCoreId);
+}
+
+bool InterfaceManager::addI2cBus(I2cBus* newBus, int workerCoreId){
     if(!newBus || !newBus->init()){
-        if(newBus) delete newBus;
-        Logger::error("InterfaceManager: error creating I2c interface on bus %d", bus);
+        if(newBus){
+            CESP_LOGE(LogModule::KERNEL, "InterfaceManager: error creating I2c interface on bus %d", newBus->getBus());
+            delete newBus;
+        }
         return false;
     }
-    _i2cInterfaces[bus] = newBus;
-    Logger::info("InterfaceManager: Creating I2c interface on bus %d", bus);
+    newBus->start(workerCoreId);   //without the worker the transactions run on the callers
+    _i2cInterfaces[newBus->getBus()] = newBus;
+    CESP_LOGI(LogModule::KERNEL, "InterfaceManager: Creating I2c interface on bus %d", newBus->getBus());
     return true;
 }
 
@@ -35,4 +59,61 @@ TwoWire* InterfaceManager::getI2cInterface(int bus){
         return nullptr;
     }
     return _i2cInterfaces[bus]->getWire();
-}
\ No newline at end of file
+}
+
+I2cBus* InterfaceManager::getI2cBus(int bus){
+    auto it = _i2cInterfaces.find(bus);
+    if(it == _i2cInterfaces.end()){
+        return nullptr;
+    }
+    return it->second;
+}
+
+/**
+ * @brief create the SPI interface of a hardware bus, with DMA transfers
+ * @param bus 0 for SPI2, 1 for SPI3. SPI0 and SPI1 are used by the flash
+ * @param miso_pin -1 for write only devices, like displays
+ */
+bool InterfaceManager::registerSpiInterface(int bus, int sck_pin, int miso_pin, int mosi_pin){
+    if(bus > 1 || bus < 0){
+        return false;
+    }
+    if(_spiInterfaces.find(bus) != _spiInterfaces.end()){
+        return false;
+    }
+    return addSpiBus(new SpiBus(bus, sck_pin, miso_pin, mosi_pin));
+}
+
+/**
+ * @brief create a bus that transfers through a custom backend, like a SimulatedSpiBackend. The backend is not owned
+ */
+bool InterfaceManager::registerSpiInterface(int bus, SpiBackend* backend){
+    if(bus > 255 || bus < 0 || backend == nullptr){
+        return false;
+    }
+    if(_spiInterfaces.find(bus) != _spiInterfaces.end()){
+        return false;
+    }
+    return addSpiBus(new SpiBus(bus, backend));
+}
+
+bool InterfaceManager::addSpiBus(SpiBus* newBus){
+    if(!newBus || !newBus->init()){
+        if(newBus){
+            CESP_LOGE(LogModule::KERNEL, "InterfaceManager: error creating SPI interface on bus %d", newBus->getBus());
+            delete newBus;
+        }
+        return false;
+    }
+    _spiInterfaces[newBus->getBus()] = newBus;
+    CESP_LOGI(LogModule::KERNEL, "InterfaceManager: Creating SPI interface on bus %d", newBus->getBus());
+    return true;
+}
+
+SpiBus* InterfaceManager::getSpiBus(int bus){
+    auto it = _spiInterfaces.find(bus);
+    if(it == _spiInterfaces.end()){
+        return nullptr;
+    }
+    return it->second;
+}
@@ -9,14 +9,26 @@
 
 class TwoWire;
 class I2cBus;
+class I2cBackend;
+class SpiBus;
+class SpiBackend;
 
 class InterfaceManager{
 public:
     InterfaceManager() = default;
-    bool registerI2cInterface(int bus, int sda_pin, int scl_pin);
+    bool registerI2cInterface(int bus, int sda_pin, int scl_pin, int workerCoreId);
+    bool registerI2cInterface(int bus, I2cBackend* backend, int workerCoreId);
     TwoWire* getI2cInterface(int bus);
+    I2cBus* getI2cBus(int bus);
+    bool registerSpiInterface(int bus, int sck_pin, int miso_pin, int mosi_pin);
+    bool registerSpiInterface(int bus, SpiBackend* backend);
+    SpiBus* getSpiBus(int bus);
 private:
+    bool addI2cBus(I2cBus* newBus, int workerCoreId);
+    bool addSpiBus(SpiBus* newBus);
+
     std::map <uint8_t, I2cBus*> _i2cInterfaces;
+    std::map <uint8_t, SpiBus*> _spiInterfaces;
 };
 
 #endif
\ No newline at end of file
@@ -12,7 +12,7 @@ bool CESP_ProgramManager::register_program(CESP_Program program){
         program.user_def_loop == nullptr ||
         program.user_def_setup == nullptr ||
         program.program_name == ""){
-        Logger::error("Program Manager: Program has invalid parameters");
+        CESP_LOGE(LogModule::KERNEL, "Program Manager: Program has invalid parameters");
         return false;
     }
 
@@ -21,7 +21,7 @@ bool CESP_ProgramManager::register_program(CESP_Program program){
     // Check if the program is already registered
     for (const auto& existing_program : _programs) {
         if (existing_program->program_name == program.program_name) {
-            Logger::error("Program Manager: Program %s is already registered", program.program_name.c_str());
+            CESP_LOGE(LogModule::KERNEL, "Program Manager: Program %s is already registered", program.program_name.c_str());
             return false; // Program already registered
         }
     }
@@ -29,7 +29,7 @@ bool CESP_ProgramManager::register_program(CESP_Program program){
     // Register the new program
     _programs.push_back(new CESP_Program(program));
 
-    Logger::info("Program Manager: Program %s registered", program.program_name.c_str());
+    CESP_LOGI(LogModule::KERNEL, "Program Manager: Program %s registered", program.program_name.c_str());
     return true; // Success
 }
 
@@ -0,0 +1,124 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/components/sensor_buffer.h"
+#include "core/kernel/device/sensor_device.h"
+
+#include <mutex>
+#include <string.h>
+
+SensorBuffer::SensorBuffer(size_t capacity) :
+    _samples(capacity > 0 ? capacity : 1),
+    _sequence(0)
+{
+}
+
+/**
+ * @brief store a reading. The channels past the given ones are 0
+ */
+void SensorBuffer::push(uint32_t timestamp, const float* values, uint8_t channels){
+    if(channels > SENSOR_MAX_CHANNELS) channels = SENSOR_MAX_CHANNELS;
+    std::lock_guard <std::mutex> lock(_mutex);
+    _sequence++;
+    SensorSample &sample = _samples[_sequence % _samples.size()];
+    sample.timestamp = timestamp;
+    sample.sequence = _sequence;
+    memset(sample.values, 0, sizeof(sample.values));
+    memcpy(sample.values, values, channels * sizeof(float));
+}
+
+/**
+ * @return false if the sensor was never read
+ */
+bool SensorBuffer::getLatest(SensorSample &sample) const{
+    std::lock_guard <std::mutex> lock(_mutex);
+    if(_sequence == 0) return false;
+    sample = _samples[_sequence % _samples.size()];
+    return true;
+}
+
+/**
+ * @brief the samples of the last window milliseconds that are still in the buffer, oldest first
+ * @return the number of samples
+ */
+size_t SensorBuffer::getHistory(std::vector <SensorSample> &samples, uint32_t window) const{
+    samples.clear();
+    std::lock_guard <std::mutex> lock(_mutex);
+    if(_sequence == 0) return 0;
+    uint32_t newest = _samples[_sequence % _samples.size()].timestamp;
+
+    //walk back from the newest sample while it is in the window
+    uint32_t first = _sequence;
+    uint32_t stored = _sequence < _samples.size() ? _sequence : _samples.size();
+    while(_sequence - first + 1 < stored){
+        const SensorSample &previous = _samples[(first - 1) % _samples.size()];
+        if(newest - previous.timestamp > window) break;
+        first--;
+    }
+    for(uint32_t sequence = first; sequence <= _sequence; sequence++) samples.push_back(_samples[sequence % _samples.size()]);
+    return samples.size();
+}
+
+/**
+ * @brief the samples after the given sequence number that are still in the buffer, oldest first
+ */
+size_t SensorBuffer::getSince(std::vector <SensorSample> &samples, uint32_t sequence) const{
+    samples.clear();
+    std::lock_guard <std::mutex> lock(_mutex);
+    uint32_t oldest = _sequence >= _samples.size() ? _sequence - _samples.size() + 1 : 1;
+    uint32_t first = sequence + 1 > oldest ? sequence + 1 : oldest;
+    for(uint32_t next = first; next <= _sequence; next++) samples.push_back(_samples[next % _samples.size()]);
+    return samples.size();
+}
+
+uint32_t SensorBuffer::getSequence() const{
+    std::lock_guard <std::mutex> lock(_mutex);
+    return _sequence;
+}
+
+//a new subscription starts from the current sample: readNew returns only the following ones
+SensorSubscription::SensorSubscription(const SensorBuffer* buffer) :
+    _buffer(buffer),
+    _lastSequence(buffer ? buffer->getSequence() : 0),
+    _missed(0)
+{
+}
+
+/**
+ * @brief the last value read from the sensor
+ * @return false if there is none yet
+ */
+bool SensorSubscription::latest(SensorSample &sample) const{
+    return _buffer ? _buffer->getLatest(sample) : false;
+}
+
+/**
+ * @brief the samples of the last window milliseconds, oldest first. The window is limited by the buffer length
+ */
+size_t SensorSubscription::history(std::vector <SensorSample> &samples, uint32_t window) const{
+    if(_buffer == nullptr){
+        samples.clear();
+        return 0;
+    }
+    return _buffer->getHistory(samples, window);
+}
+
+/**
+ * @brief the samples taken since the last call, oldest first. Samples overwritten in the meantime are counted in getMissed
+ */
+size_t SensorSubscription::readNew(std::vector <SensorSample> &samples){
+    if(_buffer == nullptr){
+        samples.clear();
+        return 0;
+    }
+    size_t count = _buffer->getSince(samples, _lastSequence);
+    if(count == 0) return 0;
+    _missed += samples.front().sequence - _lastSequence - 1;
+    _lastSequence = samples.back().sequence;
+    return count;
+}
+
+bool SensorSubscription::hasNew() const{
+    return _buffer != nullptr && _buffer->getSequence() != _lastSequence;
+}
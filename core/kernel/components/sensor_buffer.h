@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SENSOR_BUFFER_H
+#define SENSOR_BUFFER_H
+
+#include "core/kernel/device/sensor_device.h"
+
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace{
+    const size_t SENSOR_DEFAULT_HISTORY = 32;   //samples kept for each sensor
+};
+
+/**
+ * @brief the last samples of a sensor. Written by the sampler, read by any number of tasks
+ * @details when full, a new sample overwrites the oldest one
+ */
+class SensorBuffer{
+public:
+    SensorBuffer(size_t capacity);
+
+    void push(uint32_t timestamp, const float* values, uint8_t channels);
+
+    bool getLatest(SensorSample &sample) const;
+    size_t getHistory(std::vector <SensorSample> &samples, uint32_t window) const;
+    size_t getSince(std::vector <SensorSample> &samples, uint32_t sequence) const;
+    uint32_t getSequence() const;
+    size_t getCapacity() const {return _samples.size();}
+private:
+    mutable std::mutex _mutex;
+    std::vector <SensorSample> _samples;
+    uint32_t _sequence;     //samples pushed since the creation, the last one has this sequence
+};
+
+/**
+ * @brief access of a task to the samples of a sensor. Each subscription tracks the samples already read
+ * @details obtained from ChibiESP::subscribeSensor. Does not need to be released
+ */
+class SensorSubscription{
+public:
+    SensorSubscription(const SensorBuffer* buffer = nullptr);
+
+    bool isValid() const {return _buffer != nullptr;}
+    bool latest(SensorSample &sample) const;
+    size_t history(std::vector <SensorSample> &samples, uint32_t window) const;
+    size_t readNew(std::vector <SensorSample> &samples);
+    bool hasNew() const;
+    uint32_t getMissed() const {return _missed;}
+private:
+    const SensorBuffer* _buffer;
+    uint32_t _lastSequence;     //last sample returned by readNew
+    uint32_t _missed;           //samples overwritten before readNew returned them
+};
+
+#endif //SENSOR_BUFFER_H
@@ -0,0 +1,163 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/components/sensor_sampler.h"
+#include "core/kernel/components/sensor_buffer.h"
+#include "core/kernel/device/sensor_device.h"
+#include "core/kernel/interfaces/i2c_bus.h"
+#include "core/logging/logging.h"
+#include "core/tracing/tracer.h"
+#include "core/stats/stats_registry.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <mutex>
+
+SensorSampler::SensorSampler() :
+    _samplerTaskHandle(nullptr)
+{
+    _sampleStat = StatsRegistry::counter("sensors.samples");
+    _errorStat = StatsRegistry::counter("sensors.errors");
+    _batchStat = StatsRegistry::counter("sensors.batches");
+    _latencyStat = StatsRegistry::histogram("sensors.late_ms");
+}
+
+SensorSampler::~SensorSampler(){
+    if(_samplerTaskHandle) vTaskDelete(_samplerTaskHandle);
+}
+
+/**
+ * @brief add an initialized sensor, read for the first time right away
+ * @param bus I2C bus of the sensor, nullptr if it is not on one
+ * @param period sampling period in milliseconds, 0 to keep the sensor stopped
+ */
+void SensorSampler::addSensor(SensorDevice* device, SensorBuffer* buffer, I2cBus* bus, uint32_t period){
+    SensorDeviceInfo_t info;
+    device->get_device_info(info);
+
+    std::lock_guard <std::mutex> lock(_mutex);
+    Sensor sensor;
+    sensor.device = device;
+    sensor.buffer = buffer;
+    sensor.bus = bus;
+    sensor.channels = info.channelCount > SENSOR_MAX_CHANNELS ? SENSOR_MAX_CHANNELS : info.channelCount;
+    sensor.period = period > 0 && period < info.minPeriod ? info.minPeriod : period;
+    sensor.nextRead = millis();
+    _sensors.push_back(sensor);
+}
+
+/**
+ * @brief change the sampling period of a sensor, from the next reading
+ * @param period milliseconds, 0 to stop the sampling
+ * @return false if the sensor is not sampled
+ */
+bool SensorSampler::setPeriod(uint32_t deviceId, uint32_t period){
+    {
+        std::lock_guard <std::mutex> lock(_mutex);
+        Sensor* found = nullptr;
+        for(Sensor &sensor : _sensors){
+            if(sensor.device->get_device_id() == deviceId) found = &sensor;
+        }
+        if(found == nullptr) return false;
+
+        SensorDeviceInfo_t info;
+        found->device->get_device_info(info);
+        if(found->period == 0) found->nextRead = millis();  //restarted: read right away
+        found->period = period > 0 && period < info.minPeriod ? info.minPeriod : period;
+    }
+    if(_samplerTaskHandle) xTaskNotifyGive(_samplerTaskHandle);    //recompute the sleep
+    return true;
+}
+
+/**
+ * @brief start the sampler task
+ * @param coreId core where the task runs
+ */
+bool SensorSampler::start(int coreId){
+    if(_samplerTaskHandle) return true;
+    if(xTaskCreatePinnedToCore(samplerTaskWrapper, "SensorSampler", 3072, this, 1, &_samplerTaskHandle, coreId) != pdPASS){
+        CESP_LOGE(LogModule::DEVICE, "Sensor sampler: could not create the task");
+        _samplerTaskHandle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+//put the sensors due by now in the batches of their buses. Called with the mutex held, on the sampler task
+//return the milliseconds until the next sensor is due, if none is due now
+uint32_t SensorSampler::collectDue(uint32_t now){
+    uint32_t wait = SENSOR_IDLE_WAIT_MS;
+    for(Batch &batch : _batches) batch.sensors.clear();
+
+    for(Sensor &sensor : _sensors){
+        if(sensor.period == 0) continue;
+        int32_t until = (int32_t)(sensor.nextRead - now);
+        if(until > (int32_t)SENSOR_BATCH_WINDOW_MS){
+            if((uint32_t)until < wait) wait = until;
+            continue;
+        }
+
+        if(until < 0 && _latencyStat) _latencyStat->record(-until);
+        Batch* found = nullptr;
+        for(Batch &batch : _batches){
+            if(batch.bus == sensor.bus) found = &batch;
+        }
+        if(found == nullptr){
+            _batches.push_back(Batch{this, sensor.bus, {}});
+            found = &_batches.back();
+        }
+        found->sensors.push_back({sensor.device, sensor.buffer, sensor.channels});
+        //keep the sensors in phase, unless the sampler fell behind by more than a period
+        sensor.nextRead += sensor.period;
+        if((int32_t)(sensor.nextRead - now) <= 0) sensor.nextRead = now + sensor.period;
+        wait = 0;
+    }
+    return wait;
+}
+
+//read the sensors of a batch. On an I2C bus it runs on the bus worker, with the bus reserved
+int SensorSampler::readBatch(void* context){
+    Batch* batch = static_cast<Batch*>(context);
+    for(const Reading &reading : batch->sensors) batch->sampler->readSensor(reading);
+    return I2C_OK;
+}
+
+void SensorSampler::readSensor(const Reading &reading){
+    float values[SENSOR_MAX_CHANNELS] = {0};
+    if(reading.device->read(values) < 0){
+        if(_errorStat) _errorStat->add();
+        return;
+    }
+    reading.buffer->push(millis(), values, reading.channels);
+    if(_sampleStat) _sampleStat->add();
+}
+
+void SensorSampler::sampler_task_function(){
+    while(true){
+        uint32_t wait;
+        {
+            std::lock_guard <std::mutex> lock(_mutex);
+            wait = collectDue(millis());
+        }
+        //a period change wakes the sampler early
+        if(wait > 0){
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+            continue;
+        }
+
+        //the mutex is not held while waiting for the buses, so that setPeriod does not wait for the readings
+        CESP_TRACE_SCOPE("sensor_sampling");
+        for(Batch &batch : _batches){
+            if(batch.sensors.empty()) continue;
+            if(_batchStat) _batchStat->add();
+            if(batch.bus == nullptr){
+                readBatch(&batch);
+                continue;
+            }
+            //not run, for example with the bus queue full: none of its sensors was read
+            if(batch.bus->run(readBatch, &batch, I2cPriority::BACKGROUND) != I2C_OK && _errorStat) _errorStat->add(batch.sensors.size());
+        }
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SENSOR_SAMPLER_H
+#define SENSOR_SAMPLER_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+
+class SensorDevice;
+class SensorBuffer;
+class I2cBus;
+class StatCounter;
+class StatHistogram;
+
+namespace{
+    const uint32_t SENSOR_BATCH_WINDOW_MS = 2;     //sensors due this close are read in the same batch
+    const uint32_t SENSOR_IDLE_WAIT_MS = 1000;     //longest sleep of the sampler
+};
+
+/**
+ * @brief reads the sensors at their sampling periods and stores the samples in their buffers,
+ * so that tasks read the buffers instead of polling the buses
+ * @details the sensors due at the same time are grouped by I2C bus: each group is one low priority request on the bus
+ * queue, run with the bus reserved, so the reads of a bus are sent back to back and wait in the queue once.
+ * Sensors that are not on an I2C bus are read directly on the sampler task.
+ * The sensors are scheduled with the mutex held, and read after it is released
+ */
+class SensorSampler{
+public:
+    SensorSampler();
+    ~SensorSampler();
+
+    void addSensor(SensorDevice* device, SensorBuffer* buffer, I2cBus* bus, uint32_t period);
+    bool setPeriod(uint32_t deviceId, uint32_t period);
+    bool start(int coreId);
+
+    static void samplerTaskWrapper(void* arg){
+        static_cast<SensorSampler*>(arg)->sampler_task_function();
+    }
+private:
+    struct Sensor{
+        SensorDevice* device;
+        SensorBuffer* buffer;
+        I2cBus* bus;            //nullptr if the sensor is not on an I2C bus
+        uint8_t channels;
+        uint32_t period;        //milliseconds, 0 to stop the sampling
+        uint32_t nextRead;      //millis() of the next reading
+    };
+
+    //a sensor due now, copied so that it can be read without the mutex
+    struct Reading{
+        SensorDevice* device;
+        SensorBuffer* buffer;
+        uint8_t channels;
+    };
+
+    //sensors of a bus read in the same request
+    struct Batch{
+        SensorSampler* sampler;
+        I2cBus* bus;
+        std::vector <Reading> sensors;
+    };
+
+    void sampler_task_function();
+    uint32_t collectDue(uint32_t now);
+    static int readBatch(void* context);
+    void readSensor(const Reading &reading);
+
+    std::mutex _mutex;      //held while the sensors are scheduled
+    std::vector <Sensor> _sensors;
+    std::vector <Batch> _batches;   //one for each bus, reused. Used only by the sampler task
+    TaskHandle_t _samplerTaskHandle;
+
+    //statistics
+    StatCounter* _sampleStat;
+    StatCounter* _errorStat;
+    StatCounter* _batchStat;
+    StatHistogram* _latencyStat;     //milliseconds a reading was late
+};
+
+#endif //SENSOR_SAMPLER_H
@@ -4,18 +4,24 @@
 
 #include "core/kernel/components/task_manager.h"
 #include "core/task/task.h"
+#include "core/stats/stats_registry.h"
 #include <chibiESP.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
 #include <map>
 #include <mutex>
+#include <vector>
 
 CESP_TaskManager::CESP_TaskManager(ChibiKernel* kernelObj) : 
 _kernel_obj(kernelObj)
 {
+    _taskCountStat = StatsRegistry::gauge("tasks.count");
 }
 
 void CESP_TaskManager::Init(){
-    Logger::info("Address of chibiESP: %p", (void*)&chibiESP);
+    CESP_LOGD(LogModule::TASK, "Address of chibiESP: %p", (void*)&chibiESP);
     _kernelCoreId = chibiESP.getKernelCoreId(); // Get the kernel core ID
     _userCoreId = chibiESP.getUserCoreId(); // Get the user core ID
 }
@@ -30,23 +36,24 @@ void CESP_TaskManager::update(){
         if(taskInfo.status == CESP_TaskStatus::TASK_STATUS_TERMINATED){
             delete taskObj; // Delete the task object if terminated
             _task_map.erase(task.first); // Remove it from the map
-            Logger::info("Task Manager: Task ID %d (%s) deleted", task.first, taskInfo.programName.c_str());
+            CESP_LOGI(LogModule::TASK, "Task Manager: Task ID %d (%s) deleted", task.first, taskInfo.programName.c_str());
         }
     }
+    if(_taskCountStat) _taskCountStat->set(_task_map.size());
 }
 
 //create a new task and return the corresponding task ID
 int CESP_TaskManager::create_new_task(const CESP_Program* const program){
 
     if(program == nullptr){
-        Logger::error("Task Manager: Program is null, cannot create task");
+        CESP_LOGE(LogModule::TASK, "Task Manager: Program is null, cannot create task");
         return -1; // Error: program is null
     }
 
     std::lock_guard<std::mutex> lock(_task_map_mutex); // Lock the mutex for thread safety
 
     if(_task_map.size() >= 255){
-        Logger::error("Task Manager: Maximum number of tasks reached. Cannot create task for %s", program->program_name.c_str());
+        CESP_LOGE(LogModule::TASK, "Task Manager: Maximum number of tasks reached. Cannot create task for %s", program->program_name.c_str());
         return -2; // Error: maximum number of tasks reached
     }
 
@@ -62,12 +69,12 @@ int CESP_TaskManager::create_new_task(const CESP_Program* const program){
     CESP_Task* task = new CESP_Task(_kernel_obj, _kernelCoreId, _userCoreId, program->program_name, taskID, 
         program->user_def_setup, program->user_def_loop, program->user_def_closeup);
     if(task == nullptr){
-        Logger::error("Task Manager: Unable to create task object for %s", program->program_name.c_str());
+        CESP_LOGE(LogModule::TASK, "Task Manager: Unable to create task object for %s", program->program_name.c_str());
         return -3; // Error: unable to create task object
     }
     _task_map[taskID] = task; // Store the task in the map
 
-    Logger::info("Task Manager: Task ID %d (%s) created", taskID, program->program_name.c_str());
+    CESP_LOGI(LogModule::TASK, "Task Manager: Task ID %d (%s) created", taskID, program->program_name.c_str());
     return taskID;
     
 }
@@ -83,7 +90,7 @@ int CESP_TaskManager::start_task(const uint32_t taskID){
     CESP_Task* task = _task_map[taskID];
     task->start_task(); // Start the task
 
-    Logger::info("Task Manager: Task ID %d (%s) started", taskID, task->getInfo().programName.c_str());
+    CESP_LOGI(LogModule::TASK, "Task Manager: Task ID %d (%s) started", taskID, task->getInfo().programName.c_str());
     return 0; // Task started successfully
 }
 
@@ -101,7 +108,7 @@ int CESP_TaskManager::kill_task(const uint32_t taskID){
     }
     task->kill_task(); // request a task termination
 
-    Logger::info("Task Manager: Requested task ID %d (%s) forced termination", taskID, task->getInfo().programName.c_str());
+    CESP_LOGI(LogModule::TASK, "Task Manager: Requested task ID %d (%s) forced termination", taskID, task->getInfo().programName.c_str());
     return 0;
 }
 
@@ -119,7 +126,7 @@ int CESP_TaskManager::quit_task(const uint32_t taskID){
     }
     task->quit_task(); // request a task termination
 
-    Logger::info("Task Manager: Requested task ID %d (%s) graceful quit", taskID, task->getInfo().programName.c_str());
+    CESP_LOGI(LogModule::TASK, "Task Manager: Requested task ID %d (%s) graceful quit", taskID, task->getInfo().programName.c_str());
     return 0;
 }
 
@@ -142,4 +149,34 @@ bool CESP_TaskManager::is_program_alive(const std::string programName){
         }
     }
     return false;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief snapshot of the information of all the tasks
+ * @details the run time of the user loops is read with a single uxTaskGetSystemState while the task map is locked,
+ * so that no task can be deleted in the meantime. It is available only when FreeRTOS collects the run time stats
+ */
+void CESP_TaskManager::get_task_info_list(std::vector<CESP_TaskInfo_t>& list){
+    list.clear();
+    std::lock_guard<std::mutex> lock(_task_map_mutex); // Lock the mutex for thread safety
+
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+    std::vector<TaskStatus_t> systemState(uxTaskGetNumberOfTasks() + 2);  //margin for tasks created in the meantime
+    UBaseType_t systemTasks = uxTaskGetSystemState(systemState.data(), systemState.size(), nullptr);
+#endif
+
+    list.reserve(_task_map.size());
+    for(auto& task : _task_map){
+        CESP_TaskInfo_t taskInfo = task.second->getInfo();
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+        TaskHandle_t handle = task.second->getUserTaskHandle();
+        for(UBaseType_t i = 0; i < systemTasks; i++){
+            if(systemState[i].xHandle == handle){
+                taskInfo.cpu_time = systemState[i].ulRunTimeCounter;
+                break;
+            }
+        }
+#endif
+        list.push_back(taskInfo);
+    }
+}
@@ -8,10 +8,13 @@
 #include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 
 class CESP_Task;
 class ChibiKernel;
 class CESP_Program;
+class StatGauge;
+struct CESP_TaskInfo_t;
 
 class CESP_TaskManager{
 public:
@@ -24,12 +27,14 @@ public:
     int quit_task(const uint32_t taskID);   // Quit a task by ID
     bool is_task_alive(const uint32_t taskID);   // checks whether a task is alive
     bool is_program_alive(const std::string programName);   // checks whether a task is alive
+    void get_task_info_list(std::vector<CESP_TaskInfo_t>& list);  // snapshot of the information of all the tasks
 private:
     int _kernelCoreId; // ID of the kernel core
     int _userCoreId; // ID of the user core
     std::map<uint8_t, CESP_Task*> _task_map; // Map of task ID to task object
 
     std::mutex _task_map_mutex; // Mutex for thread safety
+    StatGauge* _taskCountStat;
 
     ChibiKernel * const _kernel_obj;
 };
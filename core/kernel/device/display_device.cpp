@@ -26,7 +26,7 @@ int DisplayDevice::get_device_info(DisplayDeviceInfo_t &info){
 /**
  * @brief TODO: Function to get the size in pixels the text will have on screen
  */
-int DisplayDevice::getTextSize(std::string text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t* width, uint16_t* height){
+int DisplayDevice::getTextSize(const char* text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t* width, uint16_t* height){
     return 0;
 }
 
@@ -55,6 +55,38 @@ int DisplayDevice::updateScreen(){
     return 0;
 }
 
+/**
+ * @brief first half of updateScreen, used by the display compositor
+ * @details copies the internal screen buffer to the buffer that is sent to the display. Drawing is blocked while it runs,
+ * so it should be quick. Devices that cannot split the update do it all here
+ */
+int DisplayDevice::prepareUpdate(){
+    return updateScreen();
+}
+
+/**
+ * @brief second half of updateScreen, used by the display compositor
+ * @details sends the buffer copied by prepareUpdate to the display. Runs while the next frame is drawn
+ */
+int DisplayDevice::sendUpdate(){
+    return 0;
+}
+
+/**
+ * @brief the update did not fit in the send buffer: prepareUpdate and sendUpdate must be called again for the rest
+ */
+bool DisplayDevice::hasPendingUpdate() const{
+    return false;
+}
+
+/**
+ * @brief get the i2c bus used by the device
+ * @return the bus number, -1 if the device does not use a i2c bus
+ */
+int DisplayDevice::getI2cBus() const{
+    return -1;
+}
+
 /**
  * @brief Clear the internal display buffer
  */
@@ -90,7 +122,7 @@ int DisplayDevice::drawCircle(int16_t x, int16_t y, int16_t radius, bool fill, B
 /**
  * @brief Function to draw a text on screen
  */
-int DisplayDevice::drawText(std::string text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color){
+int DisplayDevice::drawText(const char* text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color){
     return 0;
 }
 
@@ -134,7 +166,7 @@ int DisplayDevice::drawCircle(int16_t x, int16_t y, int16_t radius, bool fill, R
 /**
  * @brief Function to draw a text on screen
  */
-int DisplayDevice::drawText(std::string text, int16_t x, int16_t y, int16_t size, RGB_Color bg_color, RGB_Color fg_color){
+int DisplayDevice::drawText(const char* text, int16_t x, int16_t y, int16_t size, RGB_Color bg_color, RGB_Color fg_color){
     return 0;
 }
 /**
@@ -43,11 +43,16 @@ public:
     virtual int updateScreen();
     virtual int clearScreen();
 
+    //two phase screen update, used by the display compositor
+    virtual int prepareUpdate();
+    virtual int sendUpdate();
+    virtual bool hasPendingUpdate() const;
+
     //functions for monochromatic displays
     virtual int drawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, BW_Color color);
     virtual int drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, BW_Color color);
     virtual int drawCircle(int16_t x, int16_t y, int16_t radius, bool fill, BW_Color color);
-    virtual int drawText(std::string text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color);
+    virtual int drawText(const char* text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color);
     virtual int drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, const int16_t width, const int16_t height, BW_Color bg_color, BW_Color fg_color);
     virtual int fillScreen(BW_Color color);
 
@@ -55,13 +60,14 @@ public:
     virtual int drawLine(int16_t x1, int16_t y1, int16_t x2, int16_t y2, RGB_Color color);
     virtual int drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, RGB_Color color);
     virtual int drawCircle(int16_t x, int16_t y, int16_t radius, bool fill, RGB_Color color);
-    virtual int drawText(std::string text, int16_t x, int16_t y, int16_t size, RGB_Color bg_color, RGB_Color fg_color);
+    virtual int drawText(const char* text, int16_t x, int16_t y, int16_t size, RGB_Color bg_color, RGB_Color fg_color);
     virtual int drawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, const int16_t width, const int16_t height, RGB_Color bg_color, RGB_Color fg_color);
     virtual int fillScreen(RGB_Color color);
 
     //info functions
-    virtual int getTextSize(std::string text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t* width, uint16_t* height);
+    virtual int getTextSize(const char* text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t* width, uint16_t* height);
     virtual int get_device_info(DisplayDeviceInfo_t &info);
+    virtual int getI2cBus() const;
     uint32_t get_device_id() const { return _deviceId; }
 private:
     uint32_t _deviceId; // Device ID
@@ -0,0 +1,131 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/device/mono_display_device.h"
+#include "core/kernel/device/display_device.h"
+#include "core/graphics/mono_framebuffer.h"
+
+#include <string.h>
+
+MonoDisplayDevice::MonoDisplayDevice(uint32_t deviceId) :
+    DisplayDevice(deviceId),
+    _lastUpdateBytes(0),
+    _lastUpdatePages(0)
+{
+
+}
+
+/**
+ * @brief allocate the framebuffer. Must be called by the driver in init()
+ * @details the framebuffer starts all dirty: the first update sends the whole screen
+ */
+bool MonoDisplayDevice::initFramebuffer(uint16_t width, uint16_t height){
+    return _framebuffer.init(width, height);
+}
+
+int MonoDisplayDevice::updateScreen(){
+    prepareUpdate();
+    return sendUpdate();
+}
+
+/**
+ * @brief give the window of the changed pages to the driver
+ * @details the pages between the first and the last changed one are sent, so that the window is a single write
+ */
+int MonoDisplayDevice::prepareUpdate(){
+    _lastUpdateBytes = 0;
+    _lastUpdatePages = 0;
+
+    uint8_t first_page, last_page;
+    if(!_framebuffer.getDirtyPages(first_page, last_page)) return preparePages(0, 0, nullptr);
+
+    const uint16_t width = _framebuffer.getWidth();
+    const uint8_t page_count = last_page - first_page + 1;
+    int ret = preparePages(first_page, page_count, _framebuffer.getBuffer() + (size_t)first_page * width);
+    _framebuffer.clearDirty();
+
+    _lastUpdateBytes = (uint32_t)page_count * width;
+    _lastUpdatePages = page_count;
+    return ret;
+}
+
+int MonoDisplayDevice::clearScreen(){
+    _framebuffer.clear(BW_Color::CESP_BLACK);
+    return 0;
+}
+
+int MonoDisplayDevice::fillScreen(BW_Color color){
+    _framebuffer.clear(color);
+    return 0;
+}
+
+int MonoDisplayDevice::drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, BW_Color color){
+    if(fill){
+        _framebuffer.fillRect(x, y, width, height, color);
+        return 0;
+    }
+    _framebuffer.fillRect(x, y, width, 1, color);
+    _framebuffer.fillRect(x, y + height - 1, width, 1, color);
+    _framebuffer.fillRect(x, y, 1, height, color);
+    _framebuffer.fillRect(x + width - 1, y, 1, height, color);
+    return 0;
+}
+
+int MonoDisplayDevice::drawText(const char* text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color){
+    _framebuffer.drawText(text, x, y, size, bg_color, fg_color);
+    return 0;
+}
+
+int MonoDisplayDevice::getTextSize(const char* text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t *width, uint16_t *height){
+    //fixed size font: the text box always starts at the cursor position
+    if(real_x) *real_x = x;
+    if(real_y) *real_y = y;
+    _framebuffer.getTextSize(text, size, width, height);
+    return 0;
+}
+
+/**
+ * @brief configuration sent when the display starts, same values of the Adafruit library
+ * @param commands OLED_INIT_COMMANDS_SIZE bytes
+ * @details the SSD1306 uses horizontal addressing, so that a window of pages is one write.
+ * The SH1106 has page addressing only
+ */
+void MonoDisplayDevice::getOledInitCommands(OledController controller, uint16_t height, uint8_t *commands){
+    const bool sh1106 = controller == OledController::SH1106;
+    const uint8_t comPins = height == 64 ? 0x12 : 0x02;
+    const uint8_t contrast = height == 64 ? 0xCF : 0x8F;
+    const uint8_t table[OLED_INIT_COMMANDS_SIZE] = {
+        0xAE,                               //display off
+        0xD5, 0x80,                         //clock divider
+        0xA8, (uint8_t)(height - 1),        //multiplex
+        0xD3, 0x00,                         //no display offset
+        0x40,                               //start line 0
+        //SH1106: DC-DC converter on. SSD1306: internal charge pump
+        (uint8_t)(sh1106 ? 0xAD : 0x8D), (uint8_t)(sh1106 ? 0x8B : 0x14),
+        //SSD1306: horizontal addressing. SH1106: nop
+        (uint8_t)(sh1106 ? 0xE3 : 0x20), (uint8_t)(sh1106 ? 0xE3 : 0x00),
+        0xA1, 0xC8,                         //column and row scan direction
+        0xDA, comPins,
+        0x81, contrast,
+        0xD9, (uint8_t)(sh1106 ? 0x22 : 0xF1),  //precharge
+        0xDB, (uint8_t)(sh1106 ? 0x35 : 0x40),  //vcom detect
+        0xA4, 0xA6,                         //show the ram, not inverted
+        (uint8_t)(sh1106 ? 0xE3 : 0x2E),    //SSD1306: no scrolling. SH1106: nop
+        0xAF                                //display on
+    };
+    memcpy(commands, table, OLED_INIT_COMMANDS_SIZE);
+}
+
+/**
+ * @brief select the window of pages written by the next data of a SSD1306, in horizontal addressing
+ * @param commands OLED_WINDOW_COMMANDS_SIZE bytes
+ */
+void MonoDisplayDevice::getOledWindowCommands(uint16_t width, uint8_t first_page, uint8_t page_count, uint8_t *commands){
+    commands[0] = 0x21;     //columns
+    commands[1] = 0;
+    commands[2] = width - 1;
+    commands[3] = 0x22;     //pages
+    commands[4] = first_page;
+    commands[5] = first_page + page_count - 1;
+}
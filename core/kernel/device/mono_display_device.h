@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef MONO_DISPLAY_DEVICE_H
+#define MONO_DISPLAY_DEVICE_H
+
+#include "core/kernel/device/display_device.h"
+#include "core/graphics/mono_framebuffer.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace{
+    const uint8_t OLED_INIT_COMMANDS_SIZE = 26;
+    const uint8_t OLED_WINDOW_COMMANDS_SIZE = 6;
+};
+
+//controllers of the monochromatic OLED modules, with the same memory layout but different addressing
+enum class OledController : uint8_t{
+    SSD1306,    //128 columns, a window of pages is sent as one write
+    SH1106      //132 columns with the 128 visible ones from column 2, one page at a time
+};
+
+/**
+ * @brief base class for monochromatic displays with the SSD1306 memory layout. Drawing is done in a
+ * framebuffer, and only the window of the changed pages is sent
+ * @details a driver calls initFramebuffer in init() and implements preparePages, sendUpdate and
+ * get_device_info: it only handles the transport of the pages to the panel. The commands of the
+ * SSD1306 family of controllers are built here, the same on every bus
+ */
+class MonoDisplayDevice : public DisplayDevice{
+public:
+    MonoDisplayDevice(uint32_t deviceId);
+
+    int updateScreen() override;
+    int prepareUpdate() override;
+    int clearScreen() override;
+    int fillScreen(BW_Color color) override;
+    int drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, BW_Color color) override;
+    int drawText(const char* text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color) override;
+    int getTextSize(const char* text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t* width, uint16_t* height) override;
+
+    //statistics of the last update
+    uint32_t getLastUpdateBytes() const {return _lastUpdateBytes;}
+    uint8_t getLastUpdatePages() const {return _lastUpdatePages;}
+protected:
+    bool initFramebuffer(uint16_t width, uint16_t height);
+
+    /**
+     * @brief copy the changed pages where sendUpdate reads them. Called by prepareUpdate
+     * @param pages page_count * width bytes, one page after the other
+     * @param page_count 0 if nothing changed: the next sendUpdate has nothing to send
+     */
+    virtual int preparePages(uint8_t first_page, uint8_t page_count, const uint8_t *pages) = 0;
+
+    static void getOledInitCommands(OledController controller, uint16_t height, uint8_t *commands);
+    static void getOledWindowCommands(uint16_t width, uint8_t first_page, uint8_t page_count, uint8_t *commands);
+
+    MonoFramebuffer _framebuffer;
+private:
+    uint32_t _lastUpdateBytes;
+    uint8_t _lastUpdatePages;
+};
+
+#endif //MONO_DISPLAY_DEVICE_H
@@ -0,0 +1,183 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/device/rgb_display_device.h"
+#include "core/kernel/device/display_device.h"
+#include "core/graphics/rgb565_framebuffer.h"
+#include "core/graphics/bitmap_font.h"
+#include "core/task/gui/gui_text.h"
+#include "core/logging/logging.h"
+
+#include <vector>
+#include <algorithm>
+
+RgbDisplayDevice::RgbDisplayDevice(uint32_t deviceId) :
+    DisplayDevice(deviceId),
+    _nextTileRow(0),
+    _lastUpdatePixels(0),
+    _lastUpdateWindows(0)
+{
+
+}
+
+/**
+ * @brief allocate the framebuffer. Must be called by the driver in init()
+ */
+bool RgbDisplayDevice::initFramebuffer(uint16_t width, uint16_t height){
+    if(!_framebuffer.init(width, height)) return false;
+    if(width > GUI_TEXT_MAX_LENGTH * CESP_FONT_5X7.advance){
+        CESP_LOGW(LogModule::DEVICE, "Display %d: a line of text is limited to %d characters, %d fit on screen",
+            get_device_id(), GUI_TEXT_MAX_LENGTH, width / CESP_FONT_5X7.advance);
+    }
+    _sendBuffer.assign((size_t)width * RGB565_TILE_SIZE * RGB_SEND_BUFFER_TILE_ROWS * 2, 0);
+    _nextTileRow = 0;
+    return true;
+}
+
+int RgbDisplayDevice::updateScreen(){
+    int ret = 0;
+    do{
+        prepareUpdate();
+        if(sendUpdate() < 0) ret = -1;
+    }while(hasPendingUpdate());
+    return ret;
+}
+
+/**
+ * @brief copy the changed tiles to the send buffer, swapping the bytes to the display order
+ * @details dirty tiles next to each other on the same tile row are merged in a single window.
+ * Whole tile rows are copied while they fit in the send buffer; the rest of the update is left for the next call
+ */
+int RgbDisplayDevice::prepareUpdate(){
+    _windows.clear();
+    if(_nextTileRow == 0){
+        _lastUpdatePixels = 0;
+        _lastUpdateWindows = 0;
+    }
+
+    const uint16_t *pixels = _framebuffer.getBuffer();
+    if(pixels == nullptr) return -1;
+    const uint16_t width = _framebuffer.getWidth();
+    const uint16_t height = _framebuffer.getHeight();
+
+    uint32_t offset = 0;
+    uint16_t row = _nextTileRow;
+    _nextTileRow = 0;
+    for(; row < _framebuffer.getTileRows(); row++){
+        //size of the dirty tiles of the row, they are copied only if all of them fit
+        uint32_t rowSize = 0;
+        for(uint16_t column = 0; column < _framebuffer.getTileColumns(); column++){
+            if(!_framebuffer.isTileDirty(column, row)) continue;
+            rowSize += (uint32_t)(std::min<int>((column + 1) * RGB565_TILE_SIZE, width) - column * RGB565_TILE_SIZE) *
+                (std::min<int>((row + 1) * RGB565_TILE_SIZE, height) - row * RGB565_TILE_SIZE) * 2;
+        }
+        if(rowSize == 0) continue;
+        if(offset + rowSize > _sendBuffer.size()){
+            _nextTileRow = row;
+            break;
+        }
+
+        uint16_t column = 0;
+        while(column < _framebuffer.getTileColumns()){
+            if(!_framebuffer.isTileDirty(column, row)){
+                column++;
+                continue;
+            }
+            uint16_t first_column = column;
+            while(column < _framebuffer.getTileColumns() && _framebuffer.isTileDirty(column, row)) column++;
+
+            UpdateWindow window;
+            window.x = first_column * RGB565_TILE_SIZE;
+            window.y = row * RGB565_TILE_SIZE;
+            window.width = std::min<int>(column * RGB565_TILE_SIZE, width) - window.x;
+            window.height = std::min<int>(window.y + RGB565_TILE_SIZE, height) - window.y;
+            window.offset = offset;
+
+            uint32_t size = (uint32_t)window.width * window.height * 2;
+            uint8_t *dst = _sendBuffer.data() + offset;
+            for(int16_t y = window.y; y < window.y + window.height; y++){
+                const uint16_t *src = pixels + y * width + window.x;
+                for(int16_t x = 0; x < window.width; x++){
+                    *dst++ = src[x] >> 8;
+                    *dst++ = src[x] & 0xFF;
+                }
+            }
+            offset += size;
+            _lastUpdatePixels += (uint32_t)window.width * window.height;
+            _lastUpdateWindows++;
+            _windows.push_back(window);
+        }
+        _framebuffer.clearDirtyRow(row);
+    }
+    return 0;
+}
+
+/**
+ * @brief the last prepareUpdate copied only part of the changed tiles
+ */
+bool RgbDisplayDevice::hasPendingUpdate() const{
+    return _nextTileRow != 0;
+}
+
+/**
+ * @brief send the windows copied by prepareUpdate
+ */
+int RgbDisplayDevice::sendUpdate(){
+    int ret = 0;
+    for(const UpdateWindow &window : _windows){
+        if(writeWindow(window.x, window.y, window.width, window.height, _sendBuffer.data() + window.offset) < 0) ret = -1;
+    }
+    return ret;
+}
+
+int RgbDisplayDevice::clearScreen(){
+    _framebuffer.clear({0, 0, 0});
+    return 0;
+}
+
+int RgbDisplayDevice::fillScreen(RGB_Color color){
+    _framebuffer.clear(color);
+    return 0;
+}
+
+int RgbDisplayDevice::drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, RGB_Color color){
+    if(fill){
+        _framebuffer.fillRect(x, y, width, height, color);
+        return 0;
+    }
+    _framebuffer.fillRect(x, y, width, 1, color);
+    _framebuffer.fillRect(x, y + height - 1, width, 1, color);
+    _framebuffer.fillRect(x, y, 1, height, color);
+    _framebuffer.fillRect(x + width - 1, y, 1, height, color);
+    return 0;
+}
+
+int RgbDisplayDevice::drawText(const char* text, int16_t x, int16_t y, int16_t size, RGB_Color bg_color, RGB_Color fg_color){
+    _framebuffer.drawText(text, x, y, size, bg_color, fg_color);
+    return 0;
+}
+
+int RgbDisplayDevice::fillScreen(BW_Color color){
+    return fillScreen(toRgb(color));
+}
+
+int RgbDisplayDevice::drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, BW_Color color){
+    return drawRect(x, y, width, height, fill, toRgb(color));
+}
+
+int RgbDisplayDevice::drawText(const char* text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color){
+    return drawText(text, x, y, size, toRgb(bg_color), toRgb(fg_color));
+}
+
+int RgbDisplayDevice::getTextSize(const char* text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t *width, uint16_t *height){
+    //fixed size font: the text box always starts at the cursor position
+    if(real_x) *real_x = x;
+    if(real_y) *real_y = y;
+    _framebuffer.getTextSize(text, size, width, height);
+    return 0;
+}
+
+RGB_Color RgbDisplayDevice::toRgb(BW_Color color){
+    return color == BW_Color::CESP_WHITE ? RGB_Color{255, 255, 255} : RGB_Color{0, 0, 0};
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef RGB_DISPLAY_DEVICE_H
+#define RGB_DISPLAY_DEVICE_H
+
+#include "core/kernel/device/display_device.h"
+#include "core/graphics/rgb565_framebuffer.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace{
+    const uint8_t RGB_SEND_BUFFER_TILE_ROWS = 1;   //size of the send buffer, in full width tile rows
+};
+
+/**
+ * @brief base class for RGB565 color displays. Drawing is done in a framebuffer, and only the changed
+ * tiles are converted to the display byte order and sent
+ * @details a driver for a specific panel calls initFramebuffer in init() and implements writeWindow
+ * and get_device_info. Monochromatic drawing functions are drawn in black and white.
+ * The send buffer holds RGB_SEND_BUFFER_TILE_ROWS tile rows: a larger update is copied and sent in
+ * several pieces, see hasPendingUpdate()
+ */
+class RgbDisplayDevice : public DisplayDevice{
+public:
+    RgbDisplayDevice(uint32_t deviceId);
+
+    int updateScreen() override;
+    int prepareUpdate() override;
+    int sendUpdate() override;
+    bool hasPendingUpdate() const override;
+    int clearScreen() override;
+
+    //functions for colored displays
+    int fillScreen(RGB_Color color) override;
+    int drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, RGB_Color color) override;
+    int drawText(const char* text, int16_t x, int16_t y, int16_t size, RGB_Color bg_color, RGB_Color fg_color) override;
+
+    //functions for monochromatic displays
+    int fillScreen(BW_Color color) override;
+    int drawRect(int16_t x, int16_t y, int16_t width, int16_t height, bool fill, BW_Color color) override;
+    int drawText(const char* text, int16_t x, int16_t y, int16_t size, BW_Color bg_color, BW_Color fg_color) override;
+
+    int getTextSize(const char* text, int16_t x, int16_t y, int16_t size, int16_t *real_x, int16_t *real_y, uint16_t* width, uint16_t* height) override;
+
+    //statistics of the last update, over all its pieces
+    uint32_t getLastUpdatePixels() const {return _lastUpdatePixels;}
+    uint16_t getLastUpdateWindows() const {return _lastUpdateWindows;}
+protected:
+    bool initFramebuffer(uint16_t width, uint16_t height);
+
+    /**
+     * @brief send a rectangle of pixels to the display
+     * @param pixels width * height RGB565 pixels, row by row, high byte first
+     */
+    virtual int writeWindow(int16_t x, int16_t y, int16_t width, int16_t height, const uint8_t *pixels) = 0;
+
+    Rgb565Framebuffer _framebuffer;
+private:
+    static RGB_Color toRgb(BW_Color color);
+
+    //screen area copied by prepareUpdate, waiting to be sent
+    struct UpdateWindow{
+        int16_t x, y, width, height;
+        uint32_t offset;    //position of the pixels in _sendBuffer
+    };
+    std::vector <UpdateWindow> _windows;
+    std::vector <uint8_t> _sendBuffer;  //fixed size, allocated with the framebuffer
+    uint16_t _nextTileRow;  //first tile row not copied yet by the update in progress, 0 if none
+    uint32_t _lastUpdatePixels;
+    uint16_t _lastUpdateWindows;
+};
+
+#endif //RGB_DISPLAY_DEVICE_H
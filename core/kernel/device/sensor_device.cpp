@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+/**
+ * @file sensor_device.cpp
+ * @brief Sensor device template
+ * @details Template for a generic sensor device. overload this functions to a device for a specific sensor
+ */
+
+#include "core/kernel/device/sensor_device.h"
+
+SensorDevice::SensorDevice(uint32_t deviceId) :
+    _deviceId(deviceId)
+{
+
+}
+
+/**
+ * @brief device initialization function
+ * @details This is called by the kernel when the device is loaded, before the sampling starts
+ */
+int SensorDevice::init(){
+    return 0;
+}
+
+/**
+ * @brief device de-initialization function
+ */
+int SensorDevice::deinit(void* arg){
+    return 0;
+}
+
+/**
+ * @brief read the channels of the sensor. Called by the kernel sampler
+ */
+int SensorDevice::read(float* values){
+    return -1;
+}
+
+/**
+ * @brief Function to get device information
+ */
+int SensorDevice::get_device_info(SensorDeviceInfo_t &info){
+    info.sensorModel = "";
+    info.channelCount = 0;
+    info.minPeriod = 0;
+    return 0;
+}
+
+/**
+ * @brief I2C bus the sensor is on, -1 if it is not on an I2C bus. Used by the sampler to batch the reads of each bus
+ */
+int SensorDevice::getI2cBus() const{
+    return -1;
+}
@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SENSOR_DEVICE_H
+#define SENSOR_DEVICE_H
+
+#include <string>
+#include <stdint.h>
+
+namespace{
+    const uint8_t SENSOR_MAX_CHANNELS = 4;  //values of a sample, like the three axes of an accelerometer
+};
+
+//a reading of all the channels of a sensor
+struct SensorSample{
+    uint32_t timestamp;     //millis() of the reading
+    uint32_t sequence;      //number of the sample since the sensor started, from 1
+    float values[SENSOR_MAX_CHANNELS];
+};
+
+struct SensorDeviceInfo_t{
+    std::string sensorModel;
+    uint8_t channelCount;
+    uint32_t minPeriod;     //fastest sampling period supported, in milliseconds
+};
+
+/**
+ * @brief sensor read by the kernel sampler at the period it was registered with
+ * @details read is called on the sampler task. Sensors on an I2C bus are read together with the others of the
+ * same bus, with the bus reserved: their transfers on it run right away, without waiting in the queue
+ */
+class SensorDevice{
+public:
+    SensorDevice(uint32_t deviceId);
+    SensorDevice() = delete;
+    virtual int init();
+    virtual int deinit(void* arg);
+
+    /**
+     * @brief read the sensor
+     * @param values the channel values, as many as the channel count of the device info
+     * @return 0 on success, -1 on error: no sample is stored
+     */
+    virtual int read(float* values);
+
+    virtual int get_device_info(SensorDeviceInfo_t &info);
+    virtual int getI2cBus() const;
+    uint32_t get_device_id() const { return _deviceId; }
+private:
+    uint32_t _deviceId; // Device ID
+};
+
+#endif  //SENSOR_DEVICE_H
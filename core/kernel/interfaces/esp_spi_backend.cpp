@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/interfaces/esp_spi_backend.h"
+#include "core/logging/logging.h"
+
+#include "driver/spi_master.h"
+
+#include <string.h>
+
+EspSpiBackend::EspSpiBackend(spi_host_device_t host, int sck_pin, int miso_pin, int mosi_pin, size_t maxTransfer) :
+    _host(host),
+    _sck(sck_pin),
+    _miso(miso_pin),
+    _mosi(mosi_pin),
+    _maxTransfer(maxTransfer),
+    _initialized(false)
+{
+}
+
+EspSpiBackend::~EspSpiBackend(){
+    for(spi_device_handle_t device : _devices) spi_bus_remove_device(device);
+    if(_initialized) spi_bus_free(_host);
+}
+
+bool EspSpiBackend::init(){
+    if(_initialized) return true;
+    spi_bus_config_t config;
+    memset(&config, 0, sizeof(config));
+    config.sclk_io_num = _sck;
+    config.miso_io_num = _miso;
+    config.mosi_io_num = _mosi;
+    config.quadwp_io_num = -1;
+    config.quadhd_io_num = -1;
+    config.max_transfer_sz = _maxTransfer;
+
+    esp_err_t result = spi_bus_initialize(_host, &config, SPI_DMA_CH_AUTO);
+    if(result != ESP_OK){
+        CESP_LOGE(LogModule::KERNEL, "SPI host %d: initialization failed (%d)", (int)_host, result);
+        return false;
+    }
+    _initialized = true;
+    return true;
+}
+
+int EspSpiBackend::addDevice(const SpiDeviceConfig &config){
+    if(!_initialized) return SPI_ERROR_DEVICE;
+    spi_device_interface_config_t device;
+    memset(&device, 0, sizeof(device));
+    device.clock_speed_hz = config.frequency;
+    device.mode = config.mode;
+    device.spics_io_num = config.cs_pin;
+    device.queue_size = 1;      //transfers are serialized by the bus
+
+    spi_device_handle_t handle;
+    if(spi_bus_add_device(_host, &device, &handle) != ESP_OK) return SPI_ERROR_DEVICE;
+    _devices.push_back(handle);
+    return _devices.size() - 1;
+}
+
+int EspSpiBackend::write(int device, const uint8_t* data, size_t length){
+    return transfer(device, data, nullptr, length);
+}
+
+int EspSpiBackend::transfer(int device, const uint8_t* tx, uint8_t* rx, size_t length){
+    if(device < 0 || device >= (int)_devices.size()) return SPI_ERROR_DEVICE;
+
+    for(size_t done = 0; done < length; done += _maxTransfer){
+        size_t chunk = length - done < _maxTransfer ? length - done : _maxTransfer;
+        spi_transaction_t transaction;
+        memset(&transaction, 0, sizeof(transaction));
+        transaction.length = chunk * 8;     //in bits
+        transaction.tx_buffer = tx ? tx + done : nullptr;
+        transaction.rx_buffer = rx ? rx + done : nullptr;
+        if(spi_device_transmit(_devices[device], &transaction) != ESP_OK) return SPI_ERROR_BUS;
+    }
+    return SPI_OK;
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef ESP_SPI_BACKEND_H
+#define ESP_SPI_BACKEND_H
+
+#include "core/kernel/interfaces/spi_backend.h"
+
+#include "driver/spi_master.h"
+
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace{
+    const size_t SPI_DEFAULT_MAX_TRANSFER = 4096;  //longest DMA transfer, longer writes are split
+};
+
+/**
+ * @brief backend for the SPI peripherals of the ESP32, through the ESP-IDF spi_master driver with DMA.
+ * @details a transfer blocks the caller until the DMA ends, while the cpu runs the other tasks.
+ * Buffers that DMA cannot read, like the ones in PSRAM, are copied by the driver.
+ * The host must not be used with the Arduino SPIClass at the same time
+ */
+class EspSpiBackend : public SpiBackend{
+public:
+    EspSpiBackend(spi_host_device_t host, int sck_pin, int miso_pin, int mosi_pin, size_t maxTransfer = SPI_DEFAULT_MAX_TRANSFER);
+    ~EspSpiBackend();
+
+    bool init() override;
+    int addDevice(const SpiDeviceConfig &config) override;
+    int write(int device, const uint8_t* data, size_t length) override;
+    int transfer(int device, const uint8_t* tx, uint8_t* rx, size_t length) override;
+private:
+    spi_host_device_t _host;
+    int _sck, _miso, _mosi;
+    size_t _maxTransfer;
+    bool _initialized;
+    std::vector <spi_device_handle_t> _devices;
+};
+
+#endif //ESP_SPI_BACKEND_H
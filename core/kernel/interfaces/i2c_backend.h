@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef I2C_BACKEND_H
+#define I2C_BACKEND_H
+
+#include <Wire.h>
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace{
+    //results of the i2c transfers
+    const int I2C_OK = 0;
+    const int I2C_ERROR_QUEUE_FULL = -1;
+    const int I2C_ERROR_NACK = -2;      //no device at the address, or data refused
+    const int I2C_ERROR_TIMEOUT = -3;
+    const int I2C_ERROR_BUS = -4;
+    const int I2C_ERROR_LENGTH = -5;    //transfer longer than the driver buffer
+
+    //bus clock frequencies
+    const uint32_t I2C_CLOCK_STANDARD = 100000;
+    const uint32_t I2C_CLOCK_FAST = 400000;
+    const uint32_t I2C_CLOCK_FAST_PLUS = 1000000;
+
+    const size_t I2C_DEFAULT_WRITE_LENGTH = 128;   //buffer of the TwoWire driver
+};
+
+/**
+ * @brief the hardware side of an I2cBus: moves bytes on the wire. Called only by the bus, one transfer at a time
+ */
+class I2cBackend{
+public:
+    virtual ~I2cBackend() = default;
+
+    /**
+     * @brief write the bytes to the device
+     * @param stop false to keep the bus for a following read (repeated start)
+     */
+    virtual int write(uint8_t address, const uint8_t* data, size_t length, bool stop) = 0;
+    virtual int read(uint8_t address, uint8_t* buffer, size_t length) = 0;
+
+    virtual void setClock(uint32_t frequency) = 0;
+    virtual uint32_t getClock() const = 0;
+
+    /**
+     * @brief change the longest write that can be sent with a single start and stop
+     * @return the length accepted, that can be lower than the requested one
+     */
+    virtual size_t setMaxWriteLength(size_t length) = 0;
+    virtual size_t getMaxWriteLength() const = 0;
+};
+
+/**
+ * @brief backend for the I2C peripherals of the ESP32, through the Arduino TwoWire driver
+ * @details a write is limited by the TwoWire buffer, 128 bytes by default. setMaxWriteLength resizes it
+ */
+class WireI2cBackend : public I2cBackend{
+public:
+    WireI2cBackend(TwoWire* wire) : _wire(wire), _clock(I2C_CLOCK_STANDARD), _maxWriteLength(I2C_DEFAULT_WRITE_LENGTH) {}
+
+    int write(uint8_t address, const uint8_t* data, size_t length, bool stop) override{
+        _wire->beginTransmission(address);
+        if(_wire->write(data, length) != length){
+            _wire->endTransmission(true);
+            return I2C_ERROR_LENGTH;
+        }
+        return toResult(_wire->endTransmission(stop));
+    }
+
+    int read(uint8_t address, uint8_t* buffer, size_t length) override{
+        if(_wire->requestFrom(address, length, true) != length) return I2C_ERROR_NACK;
+        for(size_t i = 0; i < length; i++) buffer[i] = _wire->read();
+        return I2C_OK;
+    }
+
+    void setClock(uint32_t frequency) override{
+        _wire->setClock(frequency);
+        _clock = frequency;
+    }
+
+    uint32_t getClock() const override {return _clock;}
+
+    size_t setMaxWriteLength(size_t length) override{
+        size_t accepted = _wire->setBufferSize(length);
+        if(accepted > 0) _maxWriteLength = accepted;  //0: not enough memory, the old buffer is kept
+        return _maxWriteLength;
+    }
+
+    size_t getMaxWriteLength() const override {return _maxWriteLength;}
+private:
+    //endTransmission codes: 0 success, 1 data too long, 2 address NACK, 3 data NACK, 4 other error, 5 timeout
+    static int toResult(uint8_t code){
+        switch(code){
+            case 0: return I2C_OK;
+            case 1: return I2C_ERROR_LENGTH;
+            case 2:
+            case 3: return I2C_ERROR_NACK;
+            case 5: return I2C_ERROR_TIMEOUT;
+            default: return I2C_ERROR_BUS;
+        }
+    }
+
+    TwoWire* const _wire;
+    uint32_t _clock;
+    size_t _maxWriteLength;
+};
+
+#endif //I2C_BACKEND_H
@@ -0,0 +1,315 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/interfaces/i2c_bus.h"
+#include "core/kernel/interfaces/i2c_backend.h"
+#include "core/logging/logging.h"
+#include "core/stats/stats_registry.h"
+
+#include <Wire.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <string.h>
+
+I2cBus::I2cBus(int bus, int sda_pin, int scl_pin) :
+    I2cBus(bus, nullptr)
+{
+    _sda = sda_pin;
+    _scl = scl_pin;
+}
+
+I2cBus::I2cBus(int bus, I2cBackend* backend) :
+    _bus(bus),
+    _sda(-1),
+    _scl(-1),
+    _wire(nullptr),
+    _backend(backend),
+    _ownsBackend(false),
+    _chunkSize(I2C_DEFAULT_WRITE_LENGTH),
+    _owner(nullptr),
+    _queueDepth(0),
+    _bypassCounts{},
+    _workerTaskHandle(nullptr),
+    _transactionCount(0),
+    _errorCount(0),
+    _byteCount(0),
+    _busyTime(0),
+    _waitTime(0),
+    _maxQueueDepth(0)
+{
+    _transactionStat = StatsRegistry::counter("i2c.transactions");
+    _errorStat = StatsRegistry::counter("i2c.errors");
+    _busyTimeStat = StatsRegistry::counter("i2c.busy_us");
+    _waitTimeStat = StatsRegistry::histogram("i2c.wait_us");
+}
+
+I2cBus::~I2cBus(){
+    if(_workerTaskHandle) vTaskDelete(_workerTaskHandle);
+    if(_ownsBackend) delete _backend;
+    if(_wire) delete _wire;
+}
+
+/**
+ * @brief start the hardware interface. A bus created with a backend has nothing to start
+ */
+bool I2cBus::init(){
+    if(_backend == nullptr){
+        _wire = new TwoWire(_bus);
+        if(!_wire) return false;
+        _wire->begin(_sda, _scl);
+        _backend = new WireI2cBackend(_wire);
+        _ownsBackend = true;
+    }
+    _chunkSize = _backend->getMaxWriteLength();
+    return true;
+}
+
+/**
+ * @brief start the worker task that runs the queued transactions
+ * @return false if the task could not be created: transactions are then run on the caller task
+ */
+bool I2cBus::start(int coreId){
+    if(_workerTaskHandle) return true;
+    if(xTaskCreatePinnedToCore(workerTaskWrapper, "I2cWorker", 3072, this, 2, &_workerTaskHandle, coreId) != pdPASS){
+        CESP_LOGE(LogModule::KERNEL, "I2c bus %d: could not create the worker task", _bus);
+        _workerTaskHandle = nullptr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief run a transaction and wait for it to end
+ * @return I2C_OK, or the I2C_ERROR code of the first transfer that failed
+ */
+int I2cBus::transfer(const I2cTransaction &transaction){
+    Request request;
+    request.external = &transaction;
+    request.function = nullptr;
+    return wait(request, transaction.getPriority());
+}
+
+/**
+ * @brief run a function with the bus reserved and wait for it to end
+ * @details used by drivers that transfer with the TwoWire interface, so that they are queued with the other clients
+ */
+int I2cBus::run(I2cBusFunction function, void* context, I2cPriority priority){
+    Request request;
+    request.external = nullptr;
+    request.function = function;
+    request.functionContext = context;
+    return wait(request, priority);
+}
+
+/**
+ * @brief queue a transaction without waiting for it
+ * @param callback called on the worker with the result, can be nullptr
+ * @return I2C_OK if queued, I2C_ERROR_QUEUE_FULL if the queue is full
+ */
+int I2cBus::submit(const I2cTransaction &transaction, I2cCallback callback, void* context){
+    Request request;
+    request.transaction = transaction;
+    request.external = nullptr;
+    request.function = nullptr;
+    request.callback = callback;
+    request.context = context;
+    request.completion = nullptr;
+    return enqueue(request, transaction.getPriority());
+}
+
+void I2cBus::setClock(uint32_t frequency){
+    std::lock_guard <std::mutex> lock(_mutex);
+    if(_backend) _backend->setClock(frequency);
+}
+
+uint32_t I2cBus::getClock() const{
+    return _backend ? _backend->getClock() : 0;
+}
+
+/**
+ * @brief set the length of the writes a bulk transfer is split in. Longer chunks send fewer starts, stops and prefixes,
+ * but the TwoWire driver needs a buffer as large
+ * @return the chunk size accepted by the backend
+ */
+size_t I2cBus::setChunkSize(size_t size){
+    std::lock_guard <std::mutex> lock(_mutex);
+    if(_backend == nullptr || size < 2) return _chunkSize;
+    _chunkSize = _backend->setMaxWriteLength(size);
+    return _chunkSize;
+}
+
+I2cBusStats I2cBus::getStats() const{
+    I2cBusStats stats;
+    stats.timestamp = micros();
+    stats.transactions = _transactionCount.load(std::memory_order_relaxed);
+    stats.errors = _errorCount.load(std::memory_order_relaxed);
+    stats.bytes = _byteCount.load(std::memory_order_relaxed);
+    stats.busyTime = _busyTime.load(std::memory_order_relaxed);
+    stats.waitTime = _waitTime.load(std::memory_order_relaxed);
+    stats.maxQueueDepth = _maxQueueDepth.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t I2cBus::getQueueDepth(){
+    std::lock_guard <std::mutex> lock(_queueMutex);
+    return _queueDepth;
+}
+
+//queue a request for the worker, or run it right away when there is no worker
+int I2cBus::enqueue(Request &request, I2cPriority priority){
+    request.queuedTime = micros();
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    if(_workerTaskHandle == nullptr || current == _workerTaskHandle || ownsBus(current)){
+        //the worker and the functions run with the bus cannot wait for the queue: their transfers run inline
+        execute(request);
+        return I2C_OK;
+    }
+
+    {
+        std::lock_guard <std::mutex> lock(_queueMutex);
+        if(_queueDepth >= I2C_QUEUE_CAPACITY) return I2C_ERROR_QUEUE_FULL;
+        _queues[(uint8_t)priority].push_back(std::move(request));
+        _queueDepth++;
+        if(_queueDepth > _maxQueueDepth.load(std::memory_order_relaxed)) _maxQueueDepth.store(_queueDepth, std::memory_order_relaxed);
+    }
+    xTaskNotifyGive(_workerTaskHandle);
+    return I2C_OK;
+}
+
+//queue a blocking request and wait for its result
+int I2cBus::wait(Request &request, I2cPriority priority){
+    Completion completion;
+    request.callback = nullptr;
+    request.context = nullptr;
+    request.completion = &completion;
+
+    int queued = enqueue(request, priority);
+    if(queued != I2C_OK) return queued;
+
+    std::unique_lock <std::mutex> lock(completion.mutex);
+    completion.condition.wait(lock, [&completion]{ return completion.done; });
+    return completion.result;
+}
+
+//take the next request: the highest priority one, unless a lower one was passed too many times
+bool I2cBus::popRequest(Request &request){
+    std::lock_guard <std::mutex> lock(_queueMutex);
+    int first = -1, aged = -1;
+    for(uint8_t priority = 0; priority < (uint8_t)I2cPriority::COUNT; priority++){
+        if(_queues[priority].empty()) continue;
+        if(first < 0) first = priority;
+        //the queue waiting for the most bypasses goes first, on a tie the higher priority one
+        if(_bypassCounts[priority] >= I2C_PRIORITY_BYPASS_LIMIT && (aged < 0 || _bypassCounts[priority] > _bypassCounts[aged])) aged = priority;
+    }
+    if(first < 0) return false;
+    int chosen = aged >= 0 ? aged : first;
+
+    //the first request of every other waiting queue of lower priority was passed once more
+    for(uint8_t priority = chosen + 1; priority < (uint8_t)I2cPriority::COUNT; priority++){
+        if(!_queues[priority].empty()) _bypassCounts[priority]++;
+    }
+    _bypassCounts[chosen] = 0;  //the next request of the queue starts waiting now
+
+    request = std::move(_queues[chosen].front());
+    _queues[chosen].pop_front();
+    _queueDepth--;
+    return true;
+}
+
+void I2cBus::execute(Request &request){
+    const I2cTransaction &transaction = request.external ? *request.external : request.transaction;
+    uint32_t start = micros();
+    uint32_t waited = start - request.queuedTime;
+
+    int result;
+    TaskHandle_t current = xTaskGetCurrentTaskHandle();
+    bool nested = ownsBus(current);     //transfer of a function run with the bus: the time is already counted
+    if(nested){
+        result = request.function ? request.function(request.functionContext) : runTransaction(transaction);
+    }else{
+        std::lock_guard <std::mutex> lock(_mutex);
+        _owner.store(current);
+        result = request.function ? request.function(request.functionContext) : runTransaction(transaction);
+        _owner.store(nullptr);
+    }
+    uint32_t busy = micros() - start;
+
+    _transactionCount.fetch_add(1, std::memory_order_relaxed);
+    if(!request.function) _byteCount.fetch_add(transaction.getByteCount(), std::memory_order_relaxed);
+    if(_transactionStat) _transactionStat->add();
+    if(!nested){
+        _busyTime.fetch_add(busy, std::memory_order_relaxed);
+        _waitTime.fetch_add(waited, std::memory_order_relaxed);
+        if(_busyTimeStat) _busyTimeStat->add(busy);
+        if(_waitTimeStat) _waitTimeStat->record(waited);
+    }
+    if(result != I2C_OK){
+        _errorCount.fetch_add(1, std::memory_order_relaxed);
+        if(_errorStat) _errorStat->add();
+    }
+
+    if(request.callback) request.callback(result, request.context);
+    if(request.completion){
+        std::lock_guard <std::mutex> lock(request.completion->mutex);
+        request.completion->result = result;
+        request.completion->done = true;
+        request.completion->condition.notify_one();
+    }
+}
+
+//run the transfers of a transaction, stopping at the first error. Called with the bus mutex held
+int I2cBus::runTransaction(const I2cTransaction &transaction){
+    if(_backend == nullptr) return I2C_ERROR_BUS;
+    for(const I2cTransaction::Segment &segment : transaction._segments){
+        const uint8_t* data = transaction._data.data() + segment.offset;
+        int result;
+        if(segment.readBuffer) result = _backend->read(transaction._address, segment.readBuffer, segment.length);
+        else if(segment.bulk) result = writeChunks(transaction._address, data, segment.prefixLength, segment.length);
+        else result = _backend->write(transaction._address, data, segment.length, segment.stop);
+        if(result != I2C_OK) return result;
+    }
+    return I2C_OK;
+}
+
+//bulk write: the data is sent in writes of up to _chunkSize bytes, each one starting with the prefix
+int I2cBus::writeChunks(uint8_t address, const uint8_t* data, size_t prefixLength, size_t length){
+    if(prefixLength >= _chunkSize) return I2C_ERROR_LENGTH;
+    const uint8_t* payload = data + prefixLength;
+    size_t payloadChunk = _chunkSize - prefixLength;
+    if(prefixLength > 0 && _chunkBuffer.size() < _chunkSize) _chunkBuffer.resize(_chunkSize);
+
+    for(size_t sent = 0; sent < length; sent += payloadChunk){
+        size_t chunk = length - sent < payloadChunk ? length - sent : payloadChunk;
+        int result;
+        if(prefixLength == 0){
+            result = _backend->write(address, payload + sent, chunk, true);
+        }else{
+            memcpy(_chunkBuffer.data(), data, prefixLength);
+            memcpy(_chunkBuffer.data() + prefixLength, payload + sent, chunk);
+            result = _backend->write(address, _chunkBuffer.data(), prefixLength + chunk, true);
+        }
+        if(result != I2C_OK) return result;
+    }
+    return I2C_OK;
+}
+
+bool I2cBus::ownsBus(TaskHandle_t task) const{
+    return task != nullptr && _owner.load() == task;
+}
+
+void I2cBus::worker_task_function(){
+    while(true){
+        Request request;
+        if(!popRequest(request)){
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        execute(request);
+    }
+}
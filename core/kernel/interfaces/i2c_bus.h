@@ -1,23 +1,185 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
 #ifndef I2C_BUS_H
 #define I2C_BUS_H
 
-#include <Wire.h>
+#include "core/kernel/interfaces/i2c_backend.h"
 
-class I2cBus {
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+class TwoWire;
+class StatCounter;
+class StatHistogram;
+
+namespace{
+    const uint8_t I2C_QUEUE_CAPACITY = 32;      //transactions waiting on a bus, of all the priorities
+    const uint8_t I2C_PRIORITY_BYPASS_LIMIT = 8; //higher priority transactions served before a waiting lower one goes first
+};
+
+//order in which the queued transactions are served
+enum class I2cPriority : uint8_t{
+    INTERACTIVE = 0,    //user interface, like display flushes
+    NORMAL = 1,
+    BACKGROUND = 2,     //background work, like sensor polling
+    COUNT
+};
+
+/**
+ * @brief called on the bus worker when an asynchronous transaction ends
+ * @param result I2C_OK or an I2C_ERROR code
+ */
+typedef void (*I2cCallback)(int result, void* context);
+
+/**
+ * @brief function run with the bus reserved, for drivers that use the TwoWire interface directly
+ * @return I2C_OK or an I2C_ERROR code
+ */
+typedef int (*I2cBusFunction)(void* context);
+
+/**
+ * @brief list of transfers to one device, run on the bus one after the other without other clients in between.
+ * Several writes in the same transaction are a batch: the bus is reserved once for all of them
+ * @details the written bytes are copied in the transaction, the read buffers must stay valid until it ends.
+ * A transaction can be cleared and filled again without allocations.
+ * I2cTransaction(0x3C).write(command, 2).write(data, 64);
+ */
+class I2cTransaction{
 public:
-    I2cBus(int bus, int sda_pin, int scl_pin)
-        : _bus(bus), _sda(sda_pin), _scl(scl_pin), _wire(nullptr) {}
+    I2cTransaction(uint8_t address = 0, I2cPriority priority = I2cPriority::NORMAL) : _address(address), _priority(priority) {}
+
+    /**
+     * @param stop false to read right after, with a repeated start
+     */
+    I2cTransaction& write(const uint8_t* data, size_t length, bool stop = true){
+        _segments.push_back({nullptr, (uint32_t)_data.size(), (uint32_t)length, 0, false, stop});
+        _data.insert(_data.end(), data, data + length);
+        return *this;
+    }
+
+    /**
+     * @brief write a block of any length, split by the bus in writes of its chunk size
+     * @param prefix bytes sent at the start of every chunk, like the data control byte of a display. Can be empty
+     */
+    I2cTransaction& writeBulk(const uint8_t* prefix, size_t prefixLength, const uint8_t* data, size_t length){
+        _segments.push_back({nullptr, (uint32_t)_data.size(), (uint32_t)length, (uint16_t)prefixLength, true, true});
+        _data.insert(_data.end(), prefix, prefix + prefixLength);
+        _data.insert(_data.end(), data, data + length);
+        return *this;
+    }
+
+    //reserve a bulk write of length bytes and return where to copy them, to avoid an intermediate buffer
+    uint8_t* writeBulk(const uint8_t* prefix, size_t prefixLength, size_t length){
+        _segments.push_back({nullptr, (uint32_t)_data.size(), (uint32_t)length, (uint16_t)prefixLength, true, true});
+        _data.insert(_data.end(), prefix, prefix + prefixLength);
+        _data.resize(_data.size() + length);
+        return _data.data() + _data.size() - length;
+    }
+
+    I2cTransaction& read(uint8_t* buffer, size_t length){
+        _segments.push_back({buffer, 0, (uint32_t)length, 0, false, true});
+        return *this;
+    }
+
+    //the usual register read: write the register address, then read from it
+    I2cTransaction& readRegister(uint8_t reg, uint8_t* buffer, size_t length){
+        return write(&reg, 1, false).read(buffer, length);
+    }
 
-    ~I2cBus() {
-        if (_wire) delete _wire;
+    void clear(){
+        _segments.clear();
+        _data.clear();
     }
 
-    bool init() {
-        _wire = new TwoWire(_bus);
-        if(!_wire) return false;
-        _wire->begin(_sda, _scl);
-        return true;
+    uint8_t getAddress() const {return _address;}
+    void setAddress(uint8_t address) {_address = address;}
+    I2cPriority getPriority() const {return _priority;}
+    void setPriority(I2cPriority priority) {_priority = priority;}
+    bool isEmpty() const {return _segments.empty();}
+    size_t getByteCount() const{
+        size_t count = 0;
+        for(const Segment &segment : _segments) count += segment.length;
+        return count;
     }
+private:
+    friend class I2cBus;
+    struct Segment{
+        uint8_t* readBuffer;    //nullptr for a write
+        uint32_t offset;        //of the written bytes in _data, prefix first
+        uint32_t length;        //without the prefix
+        uint16_t prefixLength;  //bulk writes only
+        bool bulk;              //split in chunks by the bus
+        bool stop;
+    };
+
+    uint8_t _address;
+    I2cPriority _priority;
+    std::vector <Segment> _segments;
+    std::vector <uint8_t> _data;
+};
+
+//totals of a bus since it was created
+struct I2cBusStats{
+    uint32_t timestamp;         //micros() of the reading
+    uint32_t transactions;
+    uint32_t errors;
+    uint32_t bytes;
+    uint32_t busyTime;          //microseconds the bus was in use, wraps
+    uint32_t waitTime;          //microseconds the transactions waited in the queue, wraps
+    uint8_t maxQueueDepth;
+};
+
+/**
+ * @brief percentage of time the bus was in use between two readings of the stats
+ */
+inline uint8_t i2cBusUtilization(const I2cBusStats &previous, const I2cBusStats &current){
+    uint32_t elapsed = current.timestamp - previous.timestamp;
+    if(elapsed == 0) return 0;
+    uint32_t busy = current.busyTime - previous.busyTime;
+    return busy >= elapsed ? 100 : (uint64_t)busy * 100 / elapsed;
+}
+
+/**
+ * @brief owns an I2C bus. Clients queue transactions, that a worker task on the kernel core runs one at a time,
+ * higher priority first, so that transfers of different tasks never interleave on the wire
+ * @details each queue counts how many times its first transaction was passed by higher priority ones: past
+ * I2C_PRIORITY_BYPASS_LIMIT it goes first, so that no priority level starves.
+ * Before start, or without the worker, transactions are run right away on the caller task.
+ * Drivers that use the TwoWire interface directly must either send through run or hold getMutex while they transfer.
+ * Transfers made by a function run with the bus run right away, inside it
+ */
+class I2cBus {
+public:
+    I2cBus(int bus, int sda_pin, int scl_pin);
+    I2cBus(int bus, I2cBackend* backend);   //the backend is not owned
+    ~I2cBus();
+
+    bool init();
+    bool start(int coreId);
+
+    //blocking transfers, not to be called from the callbacks
+    int transfer(const I2cTransaction &transaction);
+    int run(I2cBusFunction function, void* context, I2cPriority priority = I2cPriority::NORMAL);
+
+    //the transaction is queued and the call returns
+    int submit(const I2cTransaction &transaction, I2cCallback callback = nullptr, void* context = nullptr);
+
+    void setClock(uint32_t frequency);
+    uint32_t getClock() const;
+    size_t setChunkSize(size_t size);
+    size_t getChunkSize() const {return _chunkSize;}
+    I2cBusStats getStats() const;
+    size_t getQueueDepth();
 
     TwoWire* getWire() const {
         return _wire;
@@ -27,10 +189,67 @@ public:
         return _bus;
     }
 
+    //held while a transaction runs; direct users of the TwoWire hold it during a transfer
+    std::mutex& getMutex() {
+        return _mutex;
+    }
+
+    static void workerTaskWrapper(void* arg){
+        static_cast<I2cBus*>(arg)->worker_task_function();
+    }
 private:
+    //a blocking caller waits for the worker on this
+    struct Completion{
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool done = false;
+        int result = I2C_OK;
+    };
+
+    struct Request{
+        I2cTransaction transaction;     //copied for asynchronous requests
+        const I2cTransaction* external; //blocking requests point to the caller transaction
+        I2cBusFunction function;
+        void* functionContext;
+        I2cCallback callback;
+        void* context;
+        Completion* completion;
+        uint32_t queuedTime;
+    };
+
+    int enqueue(Request &request, I2cPriority priority);
+    int wait(Request &request, I2cPriority priority);
+    bool popRequest(Request &request);
+    void execute(Request &request);
+    int runTransaction(const I2cTransaction &transaction);
+    int writeChunks(uint8_t address, const uint8_t* data, size_t prefixLength, size_t length);
+    bool ownsBus(TaskHandle_t task) const;
+    void worker_task_function();
+
     int _bus;
     int _sda, _scl;
     TwoWire* _wire;
+    I2cBackend* _backend;
+    bool _ownsBackend;
+    size_t _chunkSize;      //longest write of a bulk transfer, prefix included
+    std::mutex _mutex;
+    std::atomic <TaskHandle_t> _owner;  //task running a transaction, that can nest transfers in it
+    std::vector <uint8_t> _chunkBuffer; //a chunk with its prefix
+
+    //queue
+    std::mutex _queueMutex;
+    std::deque <Request> _queues[(uint8_t)I2cPriority::COUNT];
+    size_t _queueDepth;
+    uint8_t _bypassCounts[(uint8_t)I2cPriority::COUNT];    //times the first request of each queue was passed by a higher priority one
+    TaskHandle_t _workerTaskHandle;
+
+    //statistics
+    std::atomic <uint32_t> _transactionCount, _errorCount, _byteCount, _busyTime, _waitTime;
+    std::atomic <uint8_t> _maxQueueDepth;
+    StatCounter* _transactionStat;   //of all the buses
+    StatCounter* _errorStat;
+    StatCounter* _busyTimeStat;
+    StatHistogram* _waitTimeStat;
 };
 
-#endif //I2C_BUS_H
\ No newline at end of file
+#endif //I2C_BUS_H
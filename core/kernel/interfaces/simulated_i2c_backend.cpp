@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/interfaces/simulated_i2c_backend.h"
+
+#include <Arduino.h>
+
+SimulatedI2cBackend::SimulatedI2cBackend(uint32_t clock) :
+    _clock(clock),
+    _maxWriteLength(I2C_DEFAULT_WRITE_LENGTH),
+    _realTime(false),
+    _transferCount(0),
+    _byteCount(0),
+    _busTime(0)
+{
+}
+
+/**
+ * @brief add a device with registerCount registers, all 0
+ * @return false if the address is already used or not a 7 bit address
+ */
+bool SimulatedI2cBackend::addDevice(uint8_t address, size_t registerCount){
+    if(address > 0x7F || registerCount == 0 || _devices.find(address) != _devices.end()) return false;
+    Device &device = _devices[address];
+    device.registers.assign(registerCount, 0);
+    device.pointer = 0;
+    device.failing = false;
+    return true;
+}
+
+/**
+ * @brief direct access to the registers of a device, to set the values read by the clients or check the written ones
+ */
+uint8_t* SimulatedI2cBackend::getRegisters(uint8_t address){
+    Device* device = findDevice(address);
+    return device ? device->registers.data() : nullptr;
+}
+
+void SimulatedI2cBackend::setDeviceFailing(uint8_t address, bool failing){
+    Device* device = findDevice(address);
+    if(device) device->failing = failing;
+}
+
+int SimulatedI2cBackend::write(uint8_t address, const uint8_t* data, size_t length, bool stop){
+    if(length > _maxWriteLength) return I2C_ERROR_LENGTH;
+    transferTime(length);
+    Device* device = findDevice(address);
+    if(device == nullptr || device->failing) return I2C_ERROR_NACK;
+    if(length == 0) return I2C_OK;    //address probe
+
+    device->pointer = data[0] % device->registers.size();
+    for(size_t i = 1; i < length; i++){
+        device->registers[device->pointer] = data[i];
+        device->pointer = (device->pointer + 1) % device->registers.size();
+    }
+    return I2C_OK;
+}
+
+int SimulatedI2cBackend::read(uint8_t address, uint8_t* buffer, size_t length){
+    transferTime(length);
+    Device* device = findDevice(address);
+    if(device == nullptr || device->failing) return I2C_ERROR_NACK;
+
+    for(size_t i = 0; i < length; i++){
+        buffer[i] = device->registers[device->pointer];
+        device->pointer = (device->pointer + 1) % device->registers.size();
+    }
+    return I2C_OK;
+}
+
+SimulatedI2cBackend::Device* SimulatedI2cBackend::findDevice(uint8_t address){
+    auto it = _devices.find(address);
+    return it == _devices.end() ? nullptr : &it->second;
+}
+
+//account the duration of a transfer of the address byte plus bytes, and wait for it in real time mode
+void SimulatedI2cBackend::transferTime(size_t bytes){
+    uint32_t clocks = (bytes + 1) * 9 + 2;
+    uint32_t duration = _clock ? (uint64_t)clocks * 1000000 / _clock : 0;
+    _transferCount++;
+    _byteCount += bytes + 1;
+    _busTime += duration;
+    if(_realTime && duration > 0) delayMicroseconds(duration);
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SIMULATED_I2C_BACKEND_H
+#define SIMULATED_I2C_BACKEND_H
+
+#include "core/kernel/interfaces/i2c_backend.h"
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief i2c bus without hardware, to run and measure the bus service on a board without devices or on a PC.
+ * @details each simulated device is a file of registers: the first byte written after a start sets the register pointer,
+ * the next bytes are written from there, and reads continue from the pointer. The pointer wraps at the end of the file.
+ * The duration of a transfer is computed from the clock (9 clocks per byte, plus start and stop); with real time enabled
+ * the transfer also waits that long, so that the bus can be loaded like a real one.
+ * Writes longer than the max write length fail, as with the TwoWire buffer
+ */
+class SimulatedI2cBackend : public I2cBackend{
+public:
+    SimulatedI2cBackend(uint32_t clock = 400000);
+
+    bool addDevice(uint8_t address, size_t registerCount);
+    uint8_t* getRegisters(uint8_t address);
+    void setDeviceFailing(uint8_t address, bool failing);  //the device stops answering
+    void setRealTime(bool realTime) {_realTime = realTime;}
+
+    int write(uint8_t address, const uint8_t* data, size_t length, bool stop) override;
+    int read(uint8_t address, uint8_t* buffer, size_t length) override;
+    void setClock(uint32_t frequency) override {_clock = frequency;}
+    uint32_t getClock() const override {return _clock;}
+    size_t setMaxWriteLength(size_t length) override {return _maxWriteLength = length;}
+    size_t getMaxWriteLength() const override {return _maxWriteLength;}
+
+    //totals since the creation
+    uint32_t getTransferCount() const {return _transferCount;}
+    uint32_t getByteCount() const {return _byteCount;}     //bytes on the wire, address bytes included
+    uint64_t getBusTime() const {return _busTime;}    //microseconds the bus was driven
+private:
+    struct Device{
+        std::vector <uint8_t> registers;
+        size_t pointer;
+        bool failing;
+    };
+    Device* findDevice(uint8_t address);
+    void transferTime(size_t bytes);
+
+    std::map <uint8_t, Device> _devices;
+    uint32_t _clock;
+    size_t _maxWriteLength;
+    bool _realTime;
+    uint32_t _transferCount;
+    uint32_t _byteCount;
+    uint64_t _busTime;
+};
+
+#endif //SIMULATED_I2C_BACKEND_H
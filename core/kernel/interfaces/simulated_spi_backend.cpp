@@ -0,0 +1,44 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/interfaces/simulated_spi_backend.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+SimulatedSpiBackend::SimulatedSpiBackend() :
+    _realTime(false),
+    _transferCount(0),
+    _byteCount(0),
+    _busTime(0)
+{
+}
+
+int SimulatedSpiBackend::addDevice(const SpiDeviceConfig &config){
+    if(config.frequency == 0) return SPI_ERROR_DEVICE;
+    _devices.push_back(config);
+    return _devices.size() - 1;
+}
+
+int SimulatedSpiBackend::write(int device, const uint8_t* data, size_t length){
+    if(device < 0 || device >= (int)_devices.size()) return SPI_ERROR_DEVICE;
+    transferTime(device, length);
+    return SPI_OK;
+}
+
+int SimulatedSpiBackend::transfer(int device, const uint8_t* tx, uint8_t* rx, size_t length){
+    if(device < 0 || device >= (int)_devices.size()) return SPI_ERROR_DEVICE;
+    if(rx) memset(rx, 0, length);
+    transferTime(device, length);
+    return SPI_OK;
+}
+
+//account the duration of a transfer, and wait for it in real time mode
+void SimulatedSpiBackend::transferTime(int device, size_t bytes){
+    uint32_t duration = (uint64_t)bytes * 8 * 1000000 / _devices[device].frequency;
+    _transferCount++;
+    _byteCount += bytes;
+    _busTime += duration;
+    if(_realTime && duration > 0) delayMicroseconds(duration);
+}
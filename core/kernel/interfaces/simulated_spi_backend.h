@@ -0,0 +1,44 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SIMULATED_SPI_BACKEND_H
+#define SIMULATED_SPI_BACKEND_H
+
+#include "core/kernel/interfaces/spi_backend.h"
+
+#include <vector>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief spi bus without hardware, to run and measure the SPI devices on a board without them or on a PC.
+ * @details writes are discarded and reads return 0. The duration of a transfer is computed from the clock of the device,
+ * 8 clocks per byte; with real time enabled the transfer also waits that long
+ */
+class SimulatedSpiBackend : public SpiBackend{
+public:
+    SimulatedSpiBackend();
+
+    void setRealTime(bool realTime) {_realTime = realTime;}
+
+    bool init() override {return true;}
+    int addDevice(const SpiDeviceConfig &config) override;
+    int write(int device, const uint8_t* data, size_t length) override;
+    int transfer(int device, const uint8_t* tx, uint8_t* rx, size_t length) override;
+
+    //totals since the creation
+    uint32_t getTransferCount() const {return _transferCount;}
+    uint32_t getByteCount() const {return _byteCount;}
+    uint64_t getBusTime() const {return _busTime;}    //microseconds the bus was driven
+private:
+    void transferTime(int device, size_t bytes);
+
+    std::vector <SpiDeviceConfig> _devices;
+    bool _realTime;
+    uint32_t _transferCount;
+    uint32_t _byteCount;
+    uint64_t _busTime;
+};
+
+#endif //SIMULATED_SPI_BACKEND_H
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SPI_BACKEND_H
+#define SPI_BACKEND_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace{
+    //results of the spi transfers
+    const int SPI_OK = 0;
+    const int SPI_ERROR_DEVICE = -1;    //unknown device, or no more devices can be added
+    const int SPI_ERROR_BUS = -2;
+    const int SPI_ERROR_INIT = -3;
+};
+
+//a device on the bus: its chip select and the clock and mode it works with
+struct SpiDeviceConfig{
+    int cs_pin;
+    uint32_t frequency;
+    uint8_t mode;   //clock polarity and phase, 0 to 3
+};
+
+/**
+ * @brief the hardware side of a SpiBus. Called only by the bus, one transfer at a time
+ * @details the chip select of the device is held for the whole length of a write or transfer
+ */
+class SpiBackend{
+public:
+    virtual ~SpiBackend() = default;
+
+    virtual bool init() = 0;
+    /**
+     * @return the id of the new device, or SPI_ERROR_DEVICE
+     */
+    virtual int addDevice(const SpiDeviceConfig &config) = 0;
+    virtual int write(int device, const uint8_t* data, size_t length) = 0;
+    virtual int transfer(int device, const uint8_t* tx, uint8_t* rx, size_t length) = 0;
+};
+
+#endif //SPI_BACKEND_H
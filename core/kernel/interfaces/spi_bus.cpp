@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/kernel/interfaces/spi_bus.h"
+#include "core/kernel/interfaces/spi_backend.h"
+#include "core/kernel/interfaces/esp_spi_backend.h"
+#include "core/logging/logging.h"
+#include "core/stats/stats_registry.h"
+
+#include <Arduino.h>
+
+#include <mutex>
+
+SpiBus::SpiBus(int bus, int sck_pin, int miso_pin, int mosi_pin) :
+    SpiBus(bus, nullptr)
+{
+    _sck = sck_pin;
+    _miso = miso_pin;
+    _mosi = mosi_pin;
+}
+
+SpiBus::SpiBus(int bus, SpiBackend* backend) :
+    _bus(bus),
+    _sck(-1),
+    _miso(-1),
+    _mosi(-1),
+    _backend(backend),
+    _ownsBackend(false),
+    _depth(0),
+    _transactionCount(0),
+    _errorCount(0),
+    _byteCount(0),
+    _busyTime(0)
+{
+    _transactionStat = StatsRegistry::counter("spi.transactions");
+    _errorStat = StatsRegistry::counter("spi.errors");
+    _byteStat = StatsRegistry::counter("spi.bytes");
+    _busyTimeStat = StatsRegistry::counter("spi.busy_us");
+}
+
+SpiBus::~SpiBus(){
+    if(_ownsBackend) delete _backend;
+}
+
+/**
+ * @brief start the hardware interface, with DMA. A bus created with a backend only initializes it
+ */
+bool SpiBus::init(){
+    if(_backend == nullptr){
+        if(_bus < 0 || _bus > 1) return false;
+        _backend = new EspSpiBackend(_bus == 0 ? SPI2_HOST : SPI3_HOST, _sck, _miso, _mosi);
+        if(!_backend) return false;
+        _ownsBackend = true;
+    }
+    return _backend->init();
+}
+
+int SpiBus::addDevice(int cs_pin, uint32_t frequency, uint8_t mode){
+    std::lock_guard <std::recursive_mutex> lock(_mutex);
+    if(_backend == nullptr) return SPI_ERROR_DEVICE;
+    SpiDeviceConfig config = {cs_pin, frequency, mode};
+    return _backend->addDevice(config);
+}
+
+/**
+ * @brief send the bytes to the device, without reading
+ * @return SPI_OK or an SPI_ERROR code
+ */
+int SpiBus::write(int device, const uint8_t* data, size_t length){
+    std::lock_guard <std::recursive_mutex> lock(_mutex);
+    if(_backend == nullptr) return SPI_ERROR_BUS;
+    uint32_t start = micros();
+    _depth++;
+    int result = _backend->write(device, data, length);
+    _depth--;
+    account(result, length, start);
+    return result;
+}
+
+/**
+ * @brief full duplex transfer: rx receives length bytes while tx is sent. Either can be nullptr
+ */
+int SpiBus::transfer(int device, const uint8_t* tx, uint8_t* rx, size_t length){
+    std::lock_guard <std::recursive_mutex> lock(_mutex);
+    if(_backend == nullptr) return SPI_ERROR_BUS;
+    uint32_t start = micros();
+    _depth++;
+    int result = _backend->transfer(device, tx, rx, length);
+    _depth--;
+    account(result, length, start);
+    return result;
+}
+
+/**
+ * @brief run a function with the bus reserved, its transfers are counted as one transaction
+ */
+int SpiBus::run(SpiBusFunction function, void* context){
+    std::lock_guard <std::recursive_mutex> lock(_mutex);
+    uint32_t start = micros();
+    _depth++;
+    int result = function(context);
+    _depth--;
+    account(result, 0, start);
+    return result;
+}
+
+SpiBusStats SpiBus::getStats() const{
+    SpiBusStats stats;
+    stats.timestamp = micros();
+    stats.transactions = _transactionCount.load(std::memory_order_relaxed);
+    stats.errors = _errorCount.load(std::memory_order_relaxed);
+    stats.bytes = _byteCount.load(std::memory_order_relaxed);
+    stats.busyTime = _busyTime.load(std::memory_order_relaxed);
+    return stats;
+}
+
+//update the statistics after a transfer. Called with the bus mutex held
+void SpiBus::account(int result, size_t bytes, uint32_t start){
+    _byteCount.fetch_add(bytes, std::memory_order_relaxed);
+    if(_byteStat) _byteStat->add(bytes);
+    if(result != SPI_OK){
+        _errorCount.fetch_add(1, std::memory_order_relaxed);
+        if(_errorStat) _errorStat->add();
+    }
+    if(_depth > 0) return;     //inside a function run with the bus: counted when it ends
+
+    uint32_t busy = micros() - start;
+    _transactionCount.fetch_add(1, std::memory_order_relaxed);
+    _busyTime.fetch_add(busy, std::memory_order_relaxed);
+    if(_transactionStat) _transactionStat->add();
+    if(_busyTimeStat) _busyTimeStat->add(busy);
+}
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include "core/kernel/interfaces/spi_backend.h"
+
+#include <mutex>
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+class StatCounter;
+
+/**
+ * @brief function run with the bus reserved, for devices that need more than one transfer,
+ * or a pin set between them like the data/command pin of a display
+ * @return SPI_OK or an SPI_ERROR code
+ */
+typedef int (*SpiBusFunction)(void* context);
+
+//totals of a bus since it was created
+struct SpiBusStats{
+    uint32_t timestamp;         //micros() of the reading
+    uint32_t transactions;
+    uint32_t errors;
+    uint32_t bytes;
+    uint32_t busyTime;          //microseconds the bus was in use, wraps
+};
+
+/**
+ * @brief percentage of time the bus was in use between two readings of the stats
+ */
+inline uint8_t spiBusUtilization(const SpiBusStats &previous, const SpiBusStats &current){
+    uint32_t elapsed = current.timestamp - previous.timestamp;
+    if(elapsed == 0) return 0;
+    uint32_t busy = current.busyTime - previous.busyTime;
+    return busy >= elapsed ? 100 : (uint64_t)busy * 100 / elapsed;
+}
+
+/**
+ * @brief owns an SPI bus and the devices on it. Transfers of different tasks are serialized by the bus mutex
+ * and run on the caller task: with the DMA backend the caller blocks while the cpu runs the others,
+ * so a queue and a worker like the I2cBus ones are not needed.
+ * @details the bus number selects the host: 0 is SPI2_HOST, 1 is SPI3_HOST. Chips with one general purpose
+ * SPI host (ESP32-C3) have SPI2_HOST only.
+ * Transfers made by a function run with the bus run inside it
+ */
+class SpiBus {
+public:
+    SpiBus(int bus, int sck_pin, int miso_pin, int mosi_pin);
+    SpiBus(int bus, SpiBackend* backend);   //the backend is not owned
+    ~SpiBus();
+
+    bool init();
+
+    /**
+     * @return the id of the device on this bus, or SPI_ERROR_DEVICE
+     */
+    int addDevice(int cs_pin, uint32_t frequency, uint8_t mode = 0);
+
+    int write(int device, const uint8_t* data, size_t length);
+    int transfer(int device, const uint8_t* tx, uint8_t* rx, size_t length);
+    int run(SpiBusFunction function, void* context);
+
+    SpiBusStats getStats() const;
+
+    int getBus() const {
+        return _bus;
+    }
+
+    //held while a transfer runs
+    std::recursive_mutex& getMutex() {
+        return _mutex;
+    }
+private:
+    void account(int result, size_t bytes, uint32_t start);
+
+    int _bus;
+    int _sck, _miso, _mosi;
+    SpiBackend* _backend;
+    bool _ownsBackend;
+    std::recursive_mutex _mutex;
+    uint8_t _depth;     //nested calls of the task holding the bus, only the outer one is timed
+
+    //statistics
+    std::atomic <uint32_t> _transactionCount, _errorCount, _byteCount, _busyTime;
+    StatCounter* _transactionStat;   //of all the buses
+    StatCounter* _errorStat;
+    StatCounter* _byteStat;
+    StatCounter* _busyTimeStat;
+};
+
+#endif //SPI_BUS_H
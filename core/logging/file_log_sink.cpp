@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/logging/file_log_sink.h"
+
+#include <FS.h>
+
+FileLogSink::FileLogSink(fs::FS &fileSystem, const char* path, uint32_t maxSize) :
+    _fileSystem(fileSystem),
+    _path(path),
+    _maxSize(maxSize),
+    _open(false),
+    _size(0),
+    _unflushed(false),
+    _flushTimer(0),
+    _dropped(0)
+{
+
+}
+
+FileLogSink::~FileLogSink(){
+    if(_open) _file.close();
+}
+
+void FileLogSink::write(const LogRecord &record, const char* line, size_t length){
+    if(!_open && !open()){
+        _dropped++;
+        return;
+    }
+    if(_size + length + 1 > _maxSize) rotate();
+    if(!_open){
+        _dropped++;
+        return;
+    }
+
+    _size += _file.write((const uint8_t*)line, length);
+    _size += _file.write('\n');
+    _unflushed = true;
+}
+
+void FileLogSink::flush(){
+    if(!_open || !_unflushed || millis() - _flushTimer < LOG_FILE_FLUSH_PERIOD_MS) return;
+    _file.flush();
+    _unflushed = false;
+    _flushTimer = millis();
+}
+
+bool FileLogSink::open(){
+    _file = _fileSystem.open(_path.c_str(), FILE_APPEND);
+    _open = (bool)_file;
+    _size = _open ? _file.size() : 0;
+    return _open;
+}
+
+//the current file becomes the old one
+void FileLogSink::rotate(){
+    _file.close();
+    _open = false;
+    std::string oldPath = _path + ".old";
+    _fileSystem.remove(oldPath.c_str());
+    _fileSystem.rename(_path.c_str(), oldPath.c_str());
+    open();
+}
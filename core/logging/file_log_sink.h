@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef FILE_LOG_SINK_H
+#define FILE_LOG_SINK_H
+
+#include "core/logging/log_sink.h"
+
+#include <FS.h>
+#include <stdint.h>
+#include <string>
+
+namespace{
+    const uint32_t LOG_FILE_FLUSH_PERIOD_MS = 1000;  //data is written to flash at most once per period
+};
+
+/**
+ * @brief appends the messages to a file on a mounted file system (LittleFS, SPIFFS, SD)
+ * @details when the file reaches maxSize it is renamed with the ".old" extension and a new one is started,
+ * so at most twice maxSize bytes are used. The file system must be mounted before the sink is added
+ */
+class FileLogSink : public LogSink{
+public:
+    FileLogSink(fs::FS &fileSystem, const char* path, uint32_t maxSize = 64 * 1024);
+    ~FileLogSink();
+
+    void write(const LogRecord &record, const char* line, size_t length) override;
+    void flush() override;
+    uint32_t getDroppedCount() const override {return _dropped;}
+private:
+    bool open();
+    void rotate();
+
+    fs::FS &_fileSystem;
+    std::string _path;
+    uint32_t _maxSize;
+    fs::File _file;
+    bool _open;
+    uint32_t _size;         //bytes in the current file
+    bool _unflushed;
+    uint32_t _flushTimer;
+    uint32_t _dropped;
+};
+
+#endif //FILE_LOG_SINK_H
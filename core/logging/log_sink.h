@@ -0,0 +1,34 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+#include <stddef.h>
+
+struct LogRecord;
+
+/**
+ * @brief destination of the log messages. Sinks are called only by the log writer task, one message at a time
+ * @details a sink must not wait: if its output is busy it drops the message and counts it
+ */
+class LogSink{
+public:
+    virtual ~LogSink() {}
+
+    /**
+     * @brief write a message
+     * @param record the message as logged, for sinks that store it in binary
+     * @param line the formatted message with the level prefix, without line terminator
+     */
+    virtual void write(const LogRecord &record, const char* line, size_t length) = 0;
+
+    //called by the writer after each batch of messages
+    virtual void flush() {}
+
+    //messages dropped by the sink because its output was busy or full
+    virtual uint32_t getDroppedCount() const {return 0;}
+};
+
+#endif //LOG_SINK_H
@@ -3,68 +3,336 @@
 // See LICENSE file in the project root for full license information.
 
 #include "core/logging/logging.h"
+#include "core/logging/log_sink.h"
+#include "core/logging/serial_log_sink.h"
 
 #include <cstdio>
-#include <mutex>
+#include <atomic>
+#include <string.h>
 
-std::mutex Logger::_mutex;
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
-int Logger::init(){
-    Serial.begin(19200);
+MpscRing <LogRecord, LOG_RING_CAPACITY> Logger::_rings[LOG_CORE_COUNT];
+std::atomic <uint32_t> Logger::_dropped[LOG_CORE_COUNT];
+std::atomic <uint32_t> Logger::_droppedTotal(0);
+std::atomic <LogSink*> Logger::_sinks[LOG_MAX_SINKS];
 
-    while(!Serial) delay(10); // wait for serial port to connect
+namespace{
+    SerialLogSink serialLogSink(Serial);
+};
+TaskHandle_t Logger::_writerTaskHandle = nullptr;
+StatCounter* Logger::_messagesStat = nullptr;
+StatCounter* Logger::_droppedStat = nullptr;
 
+static_assert((uint8_t)LogModule::COUNT == 7, "add the level of the new module");
+uint8_t Logger::_moduleLevels[(uint8_t)LogModule::COUNT] = {
+    CESP_LOG_MIN_LEVEL, CESP_LOG_MIN_LEVEL, CESP_LOG_MIN_LEVEL, CESP_LOG_MIN_LEVEL,
+    CESP_LOG_MIN_LEVEL, CESP_LOG_MIN_LEVEL, CESP_LOG_MIN_LEVEL
+};
+
+/**
+ * @brief start the writer task. Does not wait for a host to open the serial port
+ * @param writerCoreId core where the writer task runs. Messages logged before init are written when the task starts
+ * @param serialOutput write the messages on the Serial port
+ */
+int Logger::init(int writerCoreId, bool serialOutput){
+    if(serialOutput){
+        Serial.begin(19200);
+        addSink(&serialLogSink);
+    }
+
+    if(_writerTaskHandle) return 0;
+    _messagesStat = StatsRegistry::counter("log.messages");
+    _droppedStat = StatsRegistry::counter("log.dropped");
+    if(xTaskCreatePinnedToCore(writerTaskWrapper, "LogWriter", 3072, nullptr, 1, &_writerTaskHandle, writerCoreId) != pdPASS){
+        _writerTaskHandle = nullptr;
+        return -1;
+    }
     return 0;
 }
 
-void Logger::info(const char* fmt, ...) {
+/**
+ * @brief add an output for the messages
+ * @return false if the sink was already added or there are too many sinks
+ */
+bool Logger::addSink(LogSink* sink){
+    if(sink == nullptr) return false;
+    for(int i = 0; i < LOG_MAX_SINKS; i++){
+        if(_sinks[i].load() == sink) return false;
+    }
+    for(int i = 0; i < LOG_MAX_SINKS; i++){
+        LogSink* empty = nullptr;
+        if(_sinks[i].compare_exchange_strong(empty, sink)) return true;
+    }
+    return false;
+}
 
-    char msgBuffer[192];
-    char finalBuffer[256];
+void Logger::removeSink(LogSink* sink){
+    for(int i = 0; i < LOG_MAX_SINKS; i++){
+        LogSink* current = sink;
+        _sinks[i].compare_exchange_strong(current, nullptr);
+    }
+}
 
-    std::lock_guard<std::mutex> lock(_mutex); // Lock the mutex for thread safety
+/**
+ * @brief choose if the serial port receives text or binary frames
+ */
+void Logger::setOutput(LogOutput output){
+    serialLogSink.setOutput(output);
+}
 
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(msgBuffer, sizeof(msgBuffer), fmt, args);
-    va_end(args);
+/**
+ * @brief set the minimum level of the messages of a module
+ */
+void Logger::setModuleLevel(LogModule module, LogLevel level){
+    if(module >= LogModule::COUNT) return;
+    _moduleLevels[(uint8_t)module] = (uint8_t)level;
+}
 
-    snprintf(finalBuffer, sizeof(finalBuffer), "Info: %s", msgBuffer);
+/**
+ * @brief set the minimum level of all the modules
+ */
+void Logger::setLevel(LogLevel level){
+    for(uint8_t module = 0; module < (uint8_t)LogModule::COUNT; module++) _moduleLevels[module] = (uint8_t)level;
+}
+
+LogLevel Logger::getModuleLevel(LogModule module){
+    if(module >= LogModule::COUNT) return LogLevel::NONE;
+    return (LogLevel)_moduleLevels[(uint8_t)module];
+}
+
+/**
+ * @brief total number of messages dropped because a ring was full
+ */
+uint32_t Logger::getDroppedCount(){
+    return _droppedTotal.load(std::memory_order_relaxed);
+}
+
+int Logger::currentCore(){
+    int core = xPortGetCoreID();
+    return core >= 0 && core < LOG_CORE_COUNT ? core : 0;
+}
 
-    Serial.println(finalBuffer);
-    Serial.flush();
+void Logger::messageDropped(int core){
+    _dropped[core].fetch_add(1, std::memory_order_relaxed);
+    _droppedTotal.fetch_add(1, std::memory_order_relaxed);
 }
 
-void Logger::warning(const char* fmt, ...){
-    char msgBuffer[192];
-    char finalBuffer[256];
+namespace{
+    //reads the arguments packed by LogArgWriter
+    class LogArgReader{
+    public:
+        LogArgReader(const LogRecord &record) : _record(record), _position(0){}
 
-    std::lock_guard<std::mutex> lock(_mutex); // Lock the mutex for thread safety
+        LogArgType nextType() const{
+            if(_position >= _record.length) return (LogArgType)0;
+            return (LogArgType)_record.payload[_position];
+        }
 
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(msgBuffer, sizeof(msgBuffer), fmt, args);
-    va_end(args);
+        //integer arguments of both sizes. 32 bit values are sign extended, wide tells the size
+        bool readInteger(int64_t &value, bool* wide = nullptr){
+            LogArgType type = nextType();
+            if(wide) *wide = type == LogArgType::INT64;
+            if(type == LogArgType::INT32){
+                int32_t v;
+                memcpy(&v, _record.payload + _position + 1, sizeof(v));
+                _position += 1 + sizeof(v);
+                value = v;
+                return true;
+            }
+            if(type == LogArgType::INT64){
+                memcpy(&value, _record.payload + _position + 1, sizeof(value));
+                _position += 1 + sizeof(value);
+                return true;
+            }
+            return false;
+        }
 
-    snprintf(finalBuffer, sizeof(finalBuffer), "Warning: %s", msgBuffer);
+        bool readDouble(double &value){
+            if(nextType() != LogArgType::DOUBLE) return false;
+            memcpy(&value, _record.payload + _position + 1, sizeof(value));
+            _position += 1 + sizeof(value);
+            return true;
+        }
 
-    Serial.println(finalBuffer);
-    Serial.flush();
+        bool readString(const char* &value){
+            if(nextType() != LogArgType::STRING) return false;
+            value = (const char*)_record.payload + _position + 1;
+            _position += 1 + strlen(value) + 1;
+            return true;
+        }
+    private:
+        const LogRecord &_record;
+        uint8_t _position;
+    };
+};
+
+/**
+ * @brief format a record like printf would have done when it was logged
+ * @details each conversion is formatted by snprintf with the argument read from the payload;
+ * length modifiers are replaced by the size the argument was stored with
+ * @return the length of the text
+ */
+int Logger::formatRecord(const LogRecord &record, char* buffer, size_t size){
+    if(size == 0) return 0;
+    LogArgReader reader(record);
+    size_t length = 0;
+    bool missing = false;
+    const char* c = record.format;
+
+    auto append = [&](int written){
+        if(written > 0) length += written;
+        if(length >= size) length = size - 1;
+    };
+
+    while(*c != '\0' && length < size - 1){
+        if(*c != '%'){
+            buffer[length++] = *c++;
+            continue;
+        }
+        if(c[1] == '%'){
+            buffer[length++] = '%';
+            c += 2;
+            continue;
+        }
+
+        //copy flags, width and precision, then the conversion without length modifiers
+        char spec[24];
+        size_t specLength = 0;
+        spec[specLength++] = *c++;
+        while(*c != '\0' && strchr("-+ #0123456789.*", *c) && specLength < sizeof(spec) - 4){
+            if(*c == '*'){
+                //width or precision passed as argument
+                int64_t value = 0;
+                if(!reader.readInteger(value)) missing = true;
+                specLength += snprintf(spec + specLength, sizeof(spec) - 4 - specLength, "%d", (int)value);
+                if(specLength > sizeof(spec) - 4) specLength = sizeof(spec) - 4;
+                c++;
+                continue;
+            }
+            spec[specLength++] = *c++;
+        }
+        while(*c != '\0' && strchr("hlLqjzt", *c)) c++;
+        char conversion = *c;
+        if(conversion == '\0') break;
+        c++;
+
+        char* out = buffer + length;
+        size_t space = size - length;
+        if(strchr("diuoxXc", conversion)){
+            int64_t value;
+            bool wide;
+            if(!reader.readInteger(value, &wide)){ missing = true; break; }
+            spec[specLength++] = 'l';
+            spec[specLength++] = 'l';
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            if(conversion == 'd' || conversion == 'i'){
+                append(snprintf(out, space, spec, (long long)value));
+            }else if(conversion == 'c'){
+                append(snprintf(out, space, "%c", (char)value));
+            }else{
+                unsigned long long bits = wide ? (unsigned long long)value : (uint32_t)value;
+                append(snprintf(out, space, spec, bits));
+            }
+        }else if(strchr("fFeEgGaA", conversion)){
+            double value;
+            if(!reader.readDouble(value)){ missing = true; break; }
+            spec[specLength++] = conversion;
+            spec[specLength] = '\0';
+            append(snprintf(out, space, spec, value));
+        }else if(conversion == 's'){
+            const char* value;
+            if(!reader.readString(value)){ missing = true; break; }
+            spec[specLength++] = 's';
+            spec[specLength] = '\0';
+            append(snprintf(out, space, spec, value));
+        }else if(conversion == 'p'){
+            int64_t value;
+            bool wide;
+            if(!reader.readInteger(value, &wide)){ missing = true; break; }
+            append(snprintf(out, space, "0x%llx", wide ? (unsigned long long)value : (uint32_t)value));
+        }
+    }
+    if((missing || record.truncated) && length + 4 < size){
+        memcpy(buffer + length, "...", 3);
+        length += 3;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+/**
+ * @brief replace the format and the arguments of a record with the formatted text
+ * @details for formats that are not string literals: the record must not point to memory that can change
+ * before the writer reads it. The text is a string argument of a literal format, so binary frames can be decoded too
+ */
+void Logger::formatNow(LogRecord &record){
+    char text[LOG_PAYLOAD_SIZE];
+    formatRecord(record, text, sizeof(text));   //adds "..." if the arguments were truncated
+    record.format = "%s";
+    LogArgWriter writer(record);
+    writer.add(text);
+}
+
+// Static wrapper function for the writer task
+void Logger::writerTaskWrapper(void* arg){
+    writer_task_function();
 }
 
-void Logger::error(const char* fmt, ...){
-    char msgBuffer[192];
-    char finalBuffer[256];
+void Logger::writer_task_function(){
+    while(true){
+        //write the messages of both cores in the order they were logged
+        while(true){
+            LogRecord* oldest = nullptr;
+            int oldestCore = -1;
+            for(int core = 0; core < LOG_CORE_COUNT; core++){
+                LogRecord* record = _rings[core].front();
+                if(record == nullptr) continue;
+                if(oldest == nullptr || (int32_t)(record->timestamp - oldest->timestamp) < 0){
+                    oldest = record;
+                    oldestCore = core;
+                }
+            }
+            if(oldest == nullptr) break;
+            writeRecord(*oldest);
+            _rings[oldestCore].pop();
+            if(_messagesStat) _messagesStat->add();
+        }
 
-    std::lock_guard<std::mutex> lock(_mutex); // Lock the mutex for thread safety
+        for(int core = 0; core < LOG_CORE_COUNT; core++){
+            uint32_t dropped = _dropped[core].exchange(0, std::memory_order_relaxed);
+            if(dropped == 0) continue;
+            if(_droppedStat) _droppedStat->add(dropped);
+            LogRecord record;
+            fillRecord(record, LogLevel::WARNING, "%u log messages dropped on core %d", dropped, core);
+            writeRecord(record);
+        }
+
+        for(int i = 0; i < LOG_MAX_SINKS; i++){
+            LogSink* sink = _sinks[i].load();
+            if(sink) sink->flush();
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(LOG_WRITER_PERIOD_MS));
+    }
+}
 
-    va_list args;
-    va_start(args, fmt);
-    vsnprintf(msgBuffer, sizeof(msgBuffer), fmt, args);
-    va_end(args);
+//format the message once and pass it to every sink
+void Logger::writeRecord(const LogRecord &record){
+    const char* prefix = "Info: ";
+    if(record.level == LogLevel::DEBUG) prefix = "Debug: ";
+    else if(record.level == LogLevel::WARNING) prefix = "Warning: ";
+    else if(record.level == LogLevel::ERROR) prefix = "Error: ";
 
-    snprintf(finalBuffer, sizeof(finalBuffer), "Error: %s", msgBuffer);
+    char line[LOG_LINE_SIZE];
+    size_t length = strlen(prefix);
+    memcpy(line, prefix, length);
+    length += formatRecord(record, line + length, sizeof(line) - length);
 
-    Serial.println(finalBuffer);
-    Serial.flush();
+    for(int i = 0; i < LOG_MAX_SINKS; i++){
+        LogSink* sink = _sinks[i].load();
+        if(sink) sink->write(record, line, length);
+    }
 }
@@ -5,18 +5,268 @@
 #ifndef LOGGING_H
 #define LOGGING_H
 
+#include "core/structs/mpsc_ring.h"
+#include "core/stats/stats_registry.h"
+
 #include <string>
-#include <mutex>
+#include <atomic>
+#include <initializer_list>
+#include <type_traits>
+#include <stdint.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#if __has_include("esp_memory_utils.h")
+#include "esp_memory_utils.h"
+#else
+#include "soc/soc_memory_layout.h"   //ESP-IDF 4
+#endif
+
+class LogSink;
+
+//log levels, usable in preprocessor conditions
+#define CESP_LOG_LEVEL_DEBUG 0
+#define CESP_LOG_LEVEL_INFO 1
+#define CESP_LOG_LEVEL_WARNING 2
+#define CESP_LOG_LEVEL_ERROR 3
+#define CESP_LOG_LEVEL_NONE 4
+
+//messages below this level are not compiled. Define it as CESP_LOG_LEVEL_DEBUG in development builds
+#ifndef CESP_LOG_MIN_LEVEL
+#define CESP_LOG_MIN_LEVEL CESP_LOG_LEVEL_INFO
+#endif
+
+namespace{
+  const uint8_t LOG_CORE_COUNT = 2;         //one ring for each core
+  const size_t LOG_RING_CAPACITY = 32;      //messages for each core, must be a power of two
+  const uint8_t LOG_PAYLOAD_SIZE = 116;     //bytes for the arguments of a message
+  const uint32_t LOG_WRITER_PERIOD_MS = 10;
+  const uint16_t LOG_LINE_SIZE = 192;       //longer lines are truncated when formatted
+  const uint8_t LOG_MAX_SINKS = 4;
+
+  //binary frames start with these two bytes
+  const uint8_t LOG_FRAME_SYNC_0 = 0xA5;
+  const uint8_t LOG_FRAME_SYNC_1 = 0x5A;
+  const uint8_t LOG_FRAME_HEADER_SIZE = 12;  //sync, level, timestamp, format address, payload length
+};
+
+enum class LogLevel : uint8_t{
+  DEBUG = CESP_LOG_LEVEL_DEBUG,
+  INFO = CESP_LOG_LEVEL_INFO,
+  WARNING = CESP_LOG_LEVEL_WARNING,
+  ERROR = CESP_LOG_LEVEL_ERROR,
+  NONE = CESP_LOG_LEVEL_NONE    //only to disable a module
+};
+
+//part of the library a message comes from, each one with its own runtime level
+enum class LogModule : uint8_t{
+  KERNEL,     //kernel, program manager and interfaces
+  TASK,       //task manager and tasks
+  INPUTS,     //input manager, listeners and input devices
+  DEVICE,     //device manager, displays and compositors
+  GRAPHICS,   //framebuffers
+  GUI,        //views and renderers
+  USER,       //messages logged by programs with Logger::info, warning and error
+  COUNT
+};
+
+enum class LogOutput{
+  TEXT,     //the writer task formats the messages
+  BINARY    //the serial sink sends format address and raw arguments, decoded on the host by tools/log_decoder.py
+};
+
+//type tag written before each argument in the payload
+enum class LogArgType : uint8_t{
+  INT32 = 1,
+  INT64 = 2,
+  DOUBLE = 3,
+  STRING = 4    //copied, NUL terminated
+};
+
+/**
+ * @brief message waiting in a log ring: the format string and the raw arguments, formatted later
+ */
+struct LogRecord{
+  uint32_t timestamp;  //micros() when the message was logged
+  const char* format;  //string literal in flash, its address identifies the message
+  LogLevel level;
+  uint8_t length;      //bytes used in payload
+  bool truncated;      //some arguments did not fit in the payload
+  uint8_t payload[LOG_PAYLOAD_SIZE];
+};
+
+/**
+ * @brief packs the arguments of a message in the payload of a record
+ */
+class LogArgWriter{
+public:
+  LogArgWriter(LogRecord &record) : _record(record){
+    _record.length = 0;
+    _record.truncated = false;
+  }
+
+  template <typename T>
+  typename std::enable_if <std::is_integral <T>::value || std::is_enum <T>::value>::type add(T value){
+    if(sizeof(T) <= 4){
+      int32_t v = (int32_t)value;
+      write(LogArgType::INT32, &v, sizeof(v));
+    }else{
+      int64_t v = (int64_t)value;
+      write(LogArgType::INT64, &v, sizeof(v));
+    }
+  }
 
+  template <typename T>
+  typename std::enable_if <std::is_floating_point <T>::value>::type add(T value){
+    double v = value;
+    write(LogArgType::DOUBLE, &v, sizeof(v));
+  }
+
+  void add(const char* text){
+    if(text == nullptr) text = "(null)";
+    size_t length = strlen(text);
+    size_t space = LOG_PAYLOAD_SIZE - _record.length;
+    if(space < 2){
+      _record.truncated = true;
+      return;
+    }
+    if(length > space - 2){
+      length = space - 2;   //tag and terminator
+      _record.truncated = true;
+    }
+    _record.payload[_record.length++] = (uint8_t)LogArgType::STRING;
+    memcpy(_record.payload + _record.length, text, length);
+    _record.length += length;
+    _record.payload[_record.length++] = '\0';
+  }
+  void add(char* text){ add((const char*)text); }
+
+  template <typename T>
+  void add(T* pointer){
+    add((uintptr_t)pointer);
+  }
+
+private:
+  void write(LogArgType type, const void* value, size_t size){
+    if(_record.length + 1 + size > LOG_PAYLOAD_SIZE){
+      _record.truncated = true;
+      return;
+    }
+    _record.payload[_record.length++] = (uint8_t)type;
+    memcpy(_record.payload + _record.length, value, size);
+    _record.length += size;
+  }
+
+  LogRecord &_record;
+};
+
+/**
+ * @brief asynchronous logger. A message is stored in a lock free ring of the core of the caller as the address of
+ * its format string plus the raw arguments, without formatting. A low priority writer task formats the messages and
+ * passes them to the sinks: serial port, RAM ring, file, standard output. Logging never waits for an output.
+ * @details the format should be a string literal: a format that is not in flash (built at run time, on the stack
+ * or in the heap) may be gone when the writer reads it, so that message is formatted when logged and stored as text.
+ * When a ring is full the message is dropped and counted; the writer reports the dropped messages
+ */
 class Logger{
 public:
-  static int init();
+  static int init(int writerCoreId, bool serialOutput = true);
+
+  //outputs of the messages. A sink must stay valid until it is removed and the writer completed a cycle
+  static bool addSink(LogSink* sink);
+  static void removeSink(LogSink* sink);
+
+  //messages of programs, filtered by the level of LogModule::USER. The library logs with the CESP_LOG macros
+  template <typename... Args> static void info(const char* fmt, Args... args){ logModule(LogModule::USER, LogLevel::INFO, fmt, args...); }
+  template <typename... Args> static void warning(const char* fmt, Args... args){ logModule(LogModule::USER, LogLevel::WARNING, fmt, args...); }
+  template <typename... Args> static void error(const char* fmt, Args... args){ logModule(LogModule::USER, LogLevel::ERROR, fmt, args...); }
+
+  template <typename... Args>
+  static void logModule(LogModule module, LogLevel level, const char* fmt, Args... args){
+    if(isEnabled(module, level)) log(level, fmt, args...);
+  }
+
+  template <typename... Args>
+  static void log(LogLevel level, const char* fmt, Args... args){
+    int core = currentCore();
+    bool added = _rings[core].emplace([&](LogRecord &record){
+      fillRecord(record, level, fmt, args...);
+    });
+    if(!added) messageDropped(core);
+  }
 
-  static void info(const char* fmt, ...);
-  static void warning(const char* fmt, ...);
-  static void error(const char* fmt, ...);
+  //runtime level of each module. Messages below CESP_LOG_MIN_LEVEL are not compiled and cannot be enabled
+  static void setModuleLevel(LogModule module, LogLevel level);
+  static void setLevel(LogLevel level);
+  static LogLevel getModuleLevel(LogModule module);
+  static bool isEnabled(LogModule module, LogLevel level){
+    return (uint8_t)level >= _moduleLevels[(uint8_t)module];
+  }
+
+  static void setOutput(LogOutput output);   //of the serial port
+  static uint32_t getDroppedCount();
+
+  static int formatRecord(const LogRecord &record, char* buffer, size_t size);
 private:
-  static std::mutex _mutex; // Mutex for thread safety
+  template <typename... Args>
+  static void fillRecord(LogRecord &record, LogLevel level, const char* fmt, Args... args){
+    record.timestamp = micros();
+    record.format = fmt;
+    record.level = level;
+    LogArgWriter writer(record);
+    (void)std::initializer_list <int>{(writer.add(args), 0)...};
+    if(!esp_ptr_in_drom(fmt)) formatNow(record);
+  }
+  static void formatNow(LogRecord &record);
+
+  static int currentCore();
+  static void messageDropped(int core);
+
+  static void writerTaskWrapper(void* arg);
+  static void writer_task_function();
+  static void writeRecord(const LogRecord &record);
+
+  static MpscRing <LogRecord, LOG_RING_CAPACITY> _rings[LOG_CORE_COUNT];
+  static std::atomic <uint32_t> _dropped[LOG_CORE_COUNT];  //messages dropped since the writer last reported them
+  static std::atomic <uint32_t> _droppedTotal;
+  static std::atomic <LogSink*> _sinks[LOG_MAX_SINKS];
+  static TaskHandle_t _writerTaskHandle;
+  static StatCounter* _messagesStat;  //messages written
+  static StatCounter* _droppedStat;
+  static uint8_t _moduleLevels[(uint8_t)LogModule::COUNT]; //a byte, read without locks
 };
 
-#endif //LOGGING_H
\ No newline at end of file
+/**
+ * @brief log from the library. The level is checked before the arguments are evaluated,
+ * and levels below CESP_LOG_MIN_LEVEL compile to nothing
+ * @details CESP_LOGI(LogModule::TASK, "Task %d started", id);
+ */
+#define CESP_LOG(module, level, fmt, ...) \
+  do{ if(Logger::isEnabled(module, level)) Logger::log(level, fmt, ##__VA_ARGS__); }while(0)
+
+#if CESP_LOG_MIN_LEVEL <= CESP_LOG_LEVEL_DEBUG
+#define CESP_LOGD(module, fmt, ...) CESP_LOG(module, LogLevel::DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define CESP_LOGD(module, fmt, ...) do{}while(0)
+#endif
+
+#if CESP_LOG_MIN_LEVEL <= CESP_LOG_LEVEL_INFO
+#define CESP_LOGI(module, fmt, ...) CESP_LOG(module, LogLevel::INFO, fmt, ##__VA_ARGS__)
+#else
+#define CESP_LOGI(module, fmt, ...) do{}while(0)
+#endif
+
+#if CESP_LOG_MIN_LEVEL <= CESP_LOG_LEVEL_WARNING
+#define CESP_LOGW(module, fmt, ...) CESP_LOG(module, LogLevel::WARNING, fmt, ##__VA_ARGS__)
+#else
+#define CESP_LOGW(module, fmt, ...) do{}while(0)
+#endif
+
+#if CESP_LOG_MIN_LEVEL <= CESP_LOG_LEVEL_ERROR
+#define CESP_LOGE(module, fmt, ...) CESP_LOG(module, LogLevel::ERROR, fmt, ##__VA_ARGS__)
+#else
+#define CESP_LOGE(module, fmt, ...) do{}while(0)
+#endif
+
+#endif //LOGGING_H
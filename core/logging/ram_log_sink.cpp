@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/logging/ram_log_sink.h"
+
+#include "esp_attr.h"
+
+#include <string.h>
+
+namespace{
+    //survives a reset: checked with the magic number at boot
+    struct RamLogBuffer{
+        uint32_t magic;
+        uint32_t head;      //where the next byte is written
+        uint32_t size;      //bytes used, up to LOG_RAM_BUFFER_SIZE
+        char data[LOG_RAM_BUFFER_SIZE];
+    };
+
+    __NOINIT_ATTR RamLogBuffer ramLogBuffer;
+};
+
+RamLogSink::RamLogSink(){
+    if(ramLogBuffer.magic != LOG_RAM_MAGIC || ramLogBuffer.head >= LOG_RAM_BUFFER_SIZE || ramLogBuffer.size > LOG_RAM_BUFFER_SIZE){
+        clear();    //power on: the memory content is random
+        return;
+    }
+    const char marker[] = "--- reset ---\n";   //separates the messages of the previous run
+    append(marker, sizeof(marker) - 1);
+}
+
+void RamLogSink::write(const LogRecord &record, const char* line, size_t length){
+    append(line, length);
+    append("\n", 1);
+}
+
+/**
+ * @brief bytes stored in the ring
+ */
+size_t RamLogSink::getSize() const{
+    return ramLogBuffer.size;
+}
+
+/**
+ * @brief copy the stored messages, oldest first
+ * @return the bytes copied. The buffer is not terminated
+ */
+size_t RamLogSink::read(char* buffer, size_t size) const{
+    size_t length = ramLogBuffer.size < size ? ramLogBuffer.size : size;
+    size_t start = (ramLogBuffer.head + LOG_RAM_BUFFER_SIZE - ramLogBuffer.size) % LOG_RAM_BUFFER_SIZE;
+    size_t first = LOG_RAM_BUFFER_SIZE - start;
+    if(first > length) first = length;
+    memcpy(buffer, ramLogBuffer.data + start, first);
+    memcpy(buffer + first, ramLogBuffer.data, length - first);
+    return length;
+}
+
+/**
+ * @brief print the stored messages, oldest first
+ */
+size_t RamLogSink::dump(Print &out) const{
+    size_t start = (ramLogBuffer.head + LOG_RAM_BUFFER_SIZE - ramLogBuffer.size) % LOG_RAM_BUFFER_SIZE;
+    size_t first = LOG_RAM_BUFFER_SIZE - start;
+    if(first > ramLogBuffer.size) first = ramLogBuffer.size;
+    size_t written = out.write((const uint8_t*)ramLogBuffer.data + start, first);
+    written += out.write((const uint8_t*)ramLogBuffer.data, ramLogBuffer.size - first);
+    return written;
+}
+
+void RamLogSink::clear(){
+    ramLogBuffer.head = 0;
+    ramLogBuffer.size = 0;
+    ramLogBuffer.magic = LOG_RAM_MAGIC;
+}
+
+//the oldest bytes are overwritten when the ring is full
+void RamLogSink::append(const char* data, size_t length){
+    if(length > LOG_RAM_BUFFER_SIZE){
+        data += length - LOG_RAM_BUFFER_SIZE;
+        length = LOG_RAM_BUFFER_SIZE;
+    }
+    size_t first = LOG_RAM_BUFFER_SIZE - ramLogBuffer.head;
+    if(first > length) first = length;
+    memcpy(ramLogBuffer.data + ramLogBuffer.head, data, first);
+    memcpy(ramLogBuffer.data, data + first, length - first);
+    ramLogBuffer.head = (ramLogBuffer.head + length) % LOG_RAM_BUFFER_SIZE;
+    ramLogBuffer.size = ramLogBuffer.size + length > LOG_RAM_BUFFER_SIZE ? LOG_RAM_BUFFER_SIZE : ramLogBuffer.size + length;
+}
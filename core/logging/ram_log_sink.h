@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef RAM_LOG_SINK_H
+#define RAM_LOG_SINK_H
+
+#include "core/logging/log_sink.h"
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Print;
+
+namespace{
+    const uint16_t LOG_RAM_BUFFER_SIZE = 4096;      //the last messages that fit are kept
+    const uint32_t LOG_RAM_MAGIC = 0xC1B10C6A;
+};
+
+/**
+ * @brief keeps the last messages in a RAM ring that is not cleared by a software reset, a panic or the watchdog.
+ * After a crash the messages written before it can be read with dump
+ * @details the ring is in .noinit memory, shared by all the instances: create only one.
+ * Its content is lost when power is removed
+ */
+class RamLogSink : public LogSink{
+public:
+    RamLogSink();
+
+    void write(const LogRecord &record, const char* line, size_t length) override;
+
+    size_t getSize() const;
+    size_t read(char* buffer, size_t size) const;
+    size_t dump(Print &out) const;
+    void clear();
+private:
+    void append(const char* data, size_t length);
+};
+
+#endif //RAM_LOG_SINK_H
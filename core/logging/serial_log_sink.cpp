@@ -0,0 +1,62 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/logging/serial_log_sink.h"
+#include "core/logging/logging.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+SerialLogSink::SerialLogSink(Print &port, LogOutput output) :
+    _port(port),
+    _output(output),
+    _pending(0),
+    _dropped(0)
+{
+
+}
+
+void SerialLogSink::write(const LogRecord &record, const char* line, size_t length){
+    bool queued;
+    if(_output.load() == LogOutput::BINARY){
+        //sync, level, timestamp, format address, payload length, payload. Little endian
+        uint8_t frame[LOG_FRAME_HEADER_SIZE + LOG_PAYLOAD_SIZE];
+        uint32_t format = (uint32_t)(uintptr_t)record.format;
+        frame[0] = LOG_FRAME_SYNC_0;
+        frame[1] = LOG_FRAME_SYNC_1;
+        frame[2] = (uint8_t)record.level | (record.truncated ? 0x80 : 0);
+        memcpy(frame + 3, &record.timestamp, 4);
+        memcpy(frame + 7, &format, 4);
+        frame[11] = record.length;
+        memcpy(frame + LOG_FRAME_HEADER_SIZE, record.payload, record.length);
+        queued = queue(frame, LOG_FRAME_HEADER_SIZE + record.length);
+    }else{
+        queued = _pending + length + 2 <= LOG_SERIAL_BUFFER_SIZE;
+        if(queued){
+            queue((const uint8_t*)line, length);
+            queue((const uint8_t*)"\r\n", 2);
+        }
+    }
+    if(!queued) _dropped++;
+    flush();
+}
+
+//send what the port can take without waiting
+void SerialLogSink::flush(){
+    if(_pending == 0) return;
+    int room = _port.availableForWrite();
+    if(room <= 0) return;
+    size_t sent = _port.write(_buffer, room < _pending ? room : _pending);
+    if(sent == 0) return;
+    _pending -= sent;
+    memmove(_buffer, _buffer + sent, _pending);
+}
+
+//queue the whole message or nothing
+bool SerialLogSink::queue(const uint8_t* data, size_t length){
+    if(_pending + length > LOG_SERIAL_BUFFER_SIZE) return false;
+    memcpy(_buffer + _pending, data, length);
+    _pending += length;
+    return true;
+}
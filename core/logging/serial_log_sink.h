@@ -0,0 +1,45 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SERIAL_LOG_SINK_H
+#define SERIAL_LOG_SINK_H
+
+#include "core/logging/log_sink.h"
+#include "core/logging/logging.h"
+
+#include <stdint.h>
+#include <atomic>
+
+class Print;
+
+namespace{
+    const uint16_t LOG_SERIAL_BUFFER_SIZE = 1024;   //bytes waiting for the serial port
+};
+
+/**
+ * @brief writes the messages on a serial port without waiting for it
+ * @details the messages are queued in a buffer and sent as the port has room, a little on each call.
+ * When the buffer is full, the message is dropped. Messages are sent as text or as binary frames for tools/log_decoder.py.
+ * The port is a Print, so it can be a UART or the native USB port of USB CDC On Boot boards (HWCDC, USBCDC)
+ */
+class SerialLogSink : public LogSink{
+public:
+    SerialLogSink(Print &port, LogOutput output = LogOutput::TEXT);
+
+    void write(const LogRecord &record, const char* line, size_t length) override;
+    void flush() override;
+    uint32_t getDroppedCount() const override {return _dropped;}
+
+    void setOutput(LogOutput output) {_output.store(output);}
+private:
+    bool queue(const uint8_t* data, size_t length);
+
+    Print &_port;
+    std::atomic <LogOutput> _output;
+    uint8_t _buffer[LOG_SERIAL_BUFFER_SIZE];
+    uint16_t _pending;      //bytes in _buffer not sent yet
+    uint32_t _dropped;
+};
+
+#endif //SERIAL_LOG_SINK_H
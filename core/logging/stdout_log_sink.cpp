@@ -0,0 +1,16 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/logging/stdout_log_sink.h"
+
+#include <cstdio>
+
+void StdoutLogSink::write(const LogRecord &record, const char* line, size_t length){
+    fwrite(line, 1, length, stdout);
+    fputc('\n', stdout);
+}
+
+void StdoutLogSink::flush(){
+    fflush(stdout);
+}
@@ -0,0 +1,20 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef STDOUT_LOG_SINK_H
+#define STDOUT_LOG_SINK_H
+
+#include "core/logging/log_sink.h"
+
+/**
+ * @brief writes the messages on the C standard output: the console of the host when the library runs in a simulation,
+ * the ESP-IDF console otherwise
+ */
+class StdoutLogSink : public LogSink{
+public:
+    void write(const LogRecord &record, const char* line, size_t length) override;
+    void flush() override;
+};
+
+#endif //STDOUT_LOG_SINK_H
@@ -0,0 +1,178 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/programs/top_program.h"
+#include "core/task/task.h"
+#include "core/task/task_memory.h"
+#include "core/task/gui/view.h"
+#include "core/stats/stats_registry.h"
+#include "core/logging/logging.h"
+#include <chibiESP.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace{
+    const uint32_t TOP_UPDATE_PERIOD_MS = 1000;
+    //7 lines of 9 px fit a 128x64 display: two values on each system line, the tasks one page at a time
+    const int TOP_SYSTEM_LINES = 4;
+    const int TOP_TASK_LINES = 3;
+    const int TOP_CONTAINER_ID = 0;
+    const int TOP_TASK_ELEMENT_ID = TOP_SYSTEM_LINES;   //ids of the task lines, the system lines come first
+};
+
+//values of the previous update, to compute the rates
+class TopMemory : public CESP_TaskMemory{
+public:
+    uint32_t lastUpdate = 0;
+    uint32_t frames = 0, renderTimeSum = 0, renderCount = 0;
+    uint32_t inputEvents = 0, logMessages = 0, logDropped = 0, flushes = 0;
+    uint32_t i2cBusyTime = 0, i2cTransactions = 0;
+    std::vector<CESP_TaskInfo_t> tasks;
+    std::vector<std::string> taskLines;    //text of every task, shown TOP_TASK_LINES at a time
+    int taskPage = 0;
+
+    StatCounter *framesStat, *inputStat, *logStat, *logDroppedStat, *flushStat, *i2cBusyStat, *i2cTransactionStat;
+    StatHistogram *renderTimeStat;
+    StatGauge *freeHeapStat, *minFreeHeapStat, *queueStat;
+};
+
+namespace{
+    //per second rate of a counter
+    uint32_t topRate(uint32_t current, uint32_t previous, uint32_t elapsed_ms){
+        return elapsed_ms ? (uint64_t)(current - previous) * 1000 / elapsed_ms : 0;
+    }
+
+    uint32_t topValue(const StatCounter* stat) {return stat ? stat->get() : 0;}
+    int32_t topValue(const StatGauge* stat) {return stat ? stat->get() : 0;}
+
+    void topSetLine(View* view, int elementId, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+    void topSetLine(View* view, int elementId, const char* fmt, ...){
+        char line[GUI_TEXT_MAX_LENGTH + 1];
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(line, sizeof(line), fmt, args);
+        va_end(args);
+        view->gui_set_text(elementId, line);
+    }
+
+    //show the task lines of the current page
+    void topShowTaskPage(View* view, TopMemory* memory){
+        int pages = (memory->taskLines.size() + TOP_TASK_LINES - 1) / TOP_TASK_LINES;
+        if(memory->taskPage >= pages) memory->taskPage = 0;
+        for(int line = 0; line < TOP_TASK_LINES; line++){
+            size_t task = memory->taskPage * TOP_TASK_LINES + line;
+            view->gui_set_text(TOP_TASK_ELEMENT_ID + line, task < memory->taskLines.size() ? memory->taskLines[task] : "");
+        }
+    }
+};
+
+const void top_program_setup(CESP_UserTaskData &taskData){
+    TopMemory* memory = new TopMemory();
+    memory->framesStat = StatsRegistry::counter("gui.frames");
+    memory->renderTimeStat = StatsRegistry::histogram("gui.render_us");
+    memory->inputStat = StatsRegistry::counter("input.events");
+    memory->queueStat = StatsRegistry::gauge("input.queue_max");
+    memory->logStat = StatsRegistry::counter("log.messages");
+    memory->logDroppedStat = StatsRegistry::counter("log.dropped");
+    memory->flushStat = StatsRegistry::counter("display.flushes");
+    memory->i2cBusyStat = StatsRegistry::counter("i2c.busy_us");
+    memory->i2cTransactionStat = StatsRegistry::counter("i2c.transactions");
+    memory->freeHeapStat = StatsRegistry::gauge("heap.free");
+    memory->minFreeHeapStat = StatsRegistry::gauge("heap.min_free");
+    taskData.userDataPtr.reset(memory);
+
+    taskData.taskInterface.createView();
+    View* view = taskData.taskInterface.getActiveView();
+    if(view == nullptr) return;
+    view->create_container(TOP_CONTAINER_ID, Gui_ContainerType::VERTICAL_STACK, -1, 0, 0, 1);
+    for(int id = 0; id < TOP_SYSTEM_LINES + TOP_TASK_LINES; id++){
+        view->create_generic_element(id, "", 0, 0);
+        view->gui_set_container(id, TOP_CONTAINER_ID);
+    }
+    view->gui_set_text(0, "top: collecting..");
+}
+
+const void top_program_loop(CESP_UserTaskData &taskData){
+    TopMemory* memory = static_cast<TopMemory*>(taskData.userDataPtr.get());
+    View* view = taskData.taskInterface.getActiveView();
+
+    //the wheel moves through the pages of tasks
+    InputEvent event;
+    while(taskData.taskInterface.getInputEvent(event)){
+        if(memory == nullptr || view == nullptr || event.type != InputEventType::INPUT_EVENT_WHEEL || event.eventData == 0) continue;
+        int pages = (memory->taskLines.size() + TOP_TASK_LINES - 1) / TOP_TASK_LINES;
+        if(pages == 0) continue;
+        memory->taskPage = (memory->taskPage + (event.eventData > 0 ? 1 : pages - 1)) % pages;
+        topShowTaskPage(view, memory);
+    }
+
+    uint32_t now = millis();
+    if(memory == nullptr || view == nullptr || now - memory->lastUpdate < TOP_UPDATE_PERIOD_MS){
+        delay(50);
+        return;
+    }
+    uint32_t elapsed = memory->lastUpdate ? now - memory->lastUpdate : 0;  //no rates on the first update
+    memory->lastUpdate = now;
+
+    //system lines
+    uint32_t frames = topValue(memory->framesStat);
+    uint32_t renderCount = memory->renderTimeStat ? memory->renderTimeStat->getCount() : 0;
+    uint32_t renderTimeSum = memory->renderTimeStat ? memory->renderTimeStat->getSum() : 0;
+    uint32_t renderMean = renderCount != memory->renderCount ?
+        (renderTimeSum - memory->renderTimeSum) / (renderCount - memory->renderCount) : 0;
+    uint32_t inputEvents = topValue(memory->inputStat);
+    uint32_t logMessages = topValue(memory->logStat);
+    uint32_t logDropped = topValue(memory->logDroppedStat);
+    uint32_t flushes = topValue(memory->flushStat);
+    uint32_t i2cBusyTime = topValue(memory->i2cBusyStat);
+    uint32_t i2cTransactions = topValue(memory->i2cTransactionStat);
+
+    //rates are per second, 21 characters fit the width of a 128 px display
+    topSetLine(view, 0, "heap %dk min %dk", topValue(memory->freeHeapStat) / 1024, topValue(memory->minFreeHeapStat) / 1024);
+    topSetLine(view, 1, "fps %u render %uus", topRate(frames, memory->frames, elapsed), renderMean);
+    topSetLine(view, 2, "in %u q%d log %u d%u", topRate(inputEvents, memory->inputEvents, elapsed), topValue(memory->queueStat),
+        topRate(logMessages, memory->logMessages, elapsed), logDropped - memory->logDropped);
+    //busy time of all the buses: more than 100% with two busy buses
+    topSetLine(view, 3, "flush %u i2c %u %u%%", topRate(flushes, memory->flushes, elapsed),
+        topRate(i2cTransactions, memory->i2cTransactions, elapsed), elapsed ? (i2cBusyTime - memory->i2cBusyTime) / (elapsed * 10) : 0);
+
+    memory->frames = frames;
+    memory->renderCount = renderCount;
+    memory->renderTimeSum = renderTimeSum;
+    memory->inputEvents = inputEvents;
+    memory->logMessages = logMessages;
+    memory->logDropped = logDropped;
+    memory->flushes = flushes;
+    memory->i2cBusyTime = i2cBusyTime;
+    memory->i2cTransactions = i2cTransactions;
+
+    //task lines: loop rate and share of the cpu time (run time stats count microseconds)
+    std::vector<CESP_TaskInfo_t> tasks;
+    chibiESP.getTaskInfoList(tasks);
+    memory->taskLines.resize(tasks.size());
+    for(size_t index = 0; index < tasks.size(); index++){
+        const CESP_TaskInfo_t &task = tasks[index];
+        uint32_t loopRate = 0, cpu = 0;
+        for(const CESP_TaskInfo_t &previous : memory->tasks){
+            if(previous.taskID != task.taskID || previous.programName != task.programName) continue;
+            loopRate = topRate(task.loop_count, previous.loop_count, elapsed);
+            cpu = elapsed ? (uint64_t)(task.cpu_time - previous.cpu_time) / (elapsed * 10) : 0;
+            break;
+        }
+        char line[GUI_TEXT_MAX_LENGTH + 1];
+        snprintf(line, sizeof(line), "%u %.8s %u/s %u%%", task.taskID, task.programName.c_str(), loopRate, cpu);
+        memory->taskLines[index] = line;
+    }
+    topShowTaskPage(view, memory);
+    memory->tasks.swap(tasks);
+    delay(50);
+}
+
+const void top_program_closeup(CESP_UserTaskData &taskData){
+    CESP_LOGI(LogModule::USER, "Closing top program");
+}
@@ -0,0 +1,20 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef TOP_PROGRAM_H
+#define TOP_PROGRAM_H
+
+#include "core/task/user_task.h"
+
+/**
+ * @brief built-in "top" program: shows the free heap, the frame rate, the input, log and i2c rates and
+ * the loop rate and cpu usage of each task, updated every second
+ * @details registered by the kernel, start it with chibiESP.startProgram("top").
+ * The tasks are shown three at a time, the wheel moves to the next or previous page
+ */
+const void top_program_setup(CESP_UserTaskData &taskData);
+const void top_program_loop(CESP_UserTaskData &taskData);
+const void top_program_closeup(CESP_UserTaskData &taskData);
+
+#endif //TOP_PROGRAM_H
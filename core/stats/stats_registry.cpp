@@ -0,0 +1,145 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/stats/stats_registry.h"
+
+#include <mutex>
+#include <string.h>
+
+StatEntry StatsRegistry::_entries[STATS_MAX_ENTRIES];
+std::atomic <size_t> StatsRegistry::_size(0);
+std::mutex StatsRegistry::_mutex;
+
+StatHistogram::StatHistogram(){
+    reset();
+}
+
+void StatHistogram::record(uint32_t value){
+    uint8_t bucket = value == 0 ? 0 : 32 - __builtin_clz(value);
+    if(bucket >= STATS_HISTOGRAM_BUCKETS) bucket = STATS_HISTOGRAM_BUCKETS - 1;
+
+    CoreData &data = _cores[stats_internal::core()];
+    data.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    data.count.fetch_add(1, std::memory_order_relaxed);
+    data.sum.fetch_add(value, std::memory_order_relaxed);
+    uint32_t max = data.max.load(std::memory_order_relaxed);
+    while(value > max && !data.max.compare_exchange_weak(max, value, std::memory_order_relaxed)){}
+}
+
+uint32_t StatHistogram::getCount() const{
+    uint32_t count = 0;
+    for(const CoreData &data : _cores) count += data.count.load(std::memory_order_relaxed);
+    return count;
+}
+
+uint32_t StatHistogram::getMax() const{
+    uint32_t max = 0;
+    for(const CoreData &data : _cores){
+        uint32_t value = data.max.load(std::memory_order_relaxed);
+        if(value > max) max = value;
+    }
+    return max;
+}
+
+uint32_t StatHistogram::getSum() const{
+    uint32_t sum = 0;
+    for(const CoreData &data : _cores) sum += data.sum.load(std::memory_order_relaxed);
+    return sum;
+}
+
+uint32_t StatHistogram::getMean() const{
+    uint32_t count = getCount();
+    return count ? getSum() / count : 0;
+}
+
+uint32_t StatHistogram::getBucket(uint8_t bucket) const{
+    if(bucket >= STATS_HISTOGRAM_BUCKETS) return 0;
+    uint32_t count = 0;
+    for(const CoreData &data : _cores) count += data.buckets[bucket].load(std::memory_order_relaxed);
+    return count;
+}
+
+/**
+ * @brief upper bound of the bucket that contains the percentile
+ */
+uint32_t StatHistogram::getPercentile(uint8_t percent) const{
+    uint32_t count = getCount();
+    if(count == 0) return 0;
+    uint32_t target = ((uint64_t)count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for(uint8_t bucket = 0; bucket < STATS_HISTOGRAM_BUCKETS; bucket++){
+        seen += getBucket(bucket);
+        if(seen >= target){
+            if(bucket == STATS_HISTOGRAM_BUCKETS - 1) return getMax();
+            uint32_t bound = bucket == 0 ? 0 : (1UL << bucket) - 1;
+            return bound < getMax() ? bound : getMax();
+        }
+    }
+    return getMax();
+}
+
+void StatHistogram::reset(){
+    for(CoreData &data : _cores){
+        for(auto &bucket : data.buckets) bucket.store(0);
+        data.count.store(0);
+        data.sum.store(0);
+        data.max.store(0);
+    }
+}
+
+/**
+ * @brief get the counter with the given name, creating it
+ * @return nullptr if the name is used by another type of statistic or the registry is full
+ */
+StatCounter* StatsRegistry::counter(const char* name){
+    return static_cast<StatCounter*>(lookup(name, StatType::COUNTER));
+}
+
+StatGauge* StatsRegistry::gauge(const char* name){
+    return static_cast<StatGauge*>(lookup(name, StatType::GAUGE));
+}
+
+StatHistogram* StatsRegistry::histogram(const char* name){
+    return static_cast<StatHistogram*>(lookup(name, StatType::HISTOGRAM));
+}
+
+size_t StatsRegistry::size(){
+    return _size.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief entries are only added: they can be read while other statistics are registered
+ */
+const StatEntry* StatsRegistry::getEntry(size_t index){
+    if(index >= size()) return nullptr;
+    return &_entries[index];
+}
+
+const StatEntry* StatsRegistry::find(const char* name){
+    size_t count = size();
+    for(size_t i = 0; i < count; i++){
+        if(strcmp(_entries[i].name, name) == 0) return &_entries[i];
+    }
+    return nullptr;
+}
+
+void* StatsRegistry::lookup(const char* name, StatType type){
+    std::lock_guard <std::mutex> lock(_mutex);
+    const StatEntry* existing = find(name);
+    if(existing) return existing->type == type ? existing->stat : nullptr;
+
+    size_t index = _size.load(std::memory_order_relaxed);
+    if(index >= STATS_MAX_ENTRIES) return nullptr;
+
+    StatEntry &entry = _entries[index];
+    entry.name = name;
+    entry.type = type;
+    switch(type){
+        case StatType::COUNTER: entry.stat = new StatCounter(); break;
+        case StatType::GAUGE: entry.stat = new StatGauge(); break;
+        case StatType::HISTOGRAM: entry.stat = new StatHistogram(); break;
+    }
+    _size.store(index + 1, std::memory_order_release);
+    return entry.stat;
+}
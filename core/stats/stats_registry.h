@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef STATS_REGISTRY_H
+#define STATS_REGISTRY_H
+
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "freertos/FreeRTOS.h"
+
+namespace{
+    const uint8_t STATS_CORE_COUNT = 2;
+    const uint8_t STATS_MAX_ENTRIES = 48;
+    const uint8_t STATS_HISTOGRAM_BUCKETS = 24;    //bucket i counts values below 2^i, the last one everything else
+};
+
+enum class StatType : uint8_t{
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+};
+
+namespace stats_internal{
+    inline int core(){
+        int core = xPortGetCoreID();
+        return core >= 0 && core < STATS_CORE_COUNT ? core : 0;
+    }
+};
+
+/**
+ * @brief value that only grows, like events handled or bytes sent. Each core increments its own slot
+ */
+class StatCounter{
+public:
+    StatCounter() {for(auto &value : _values) value.store(0);}
+    void add(uint32_t amount = 1) {_values[stats_internal::core()].fetch_add(amount, std::memory_order_relaxed);}
+    uint32_t get() const{
+        uint32_t total = 0;
+        for(auto &value : _values) total += value.load(std::memory_order_relaxed);
+        return total;
+    }
+private:
+    std::atomic <uint32_t> _values[STATS_CORE_COUNT];
+};
+
+/**
+ * @brief value that goes up and down, like a queue depth or the free heap
+ */
+class StatGauge{
+public:
+    StatGauge() : _value(0) {}
+    void set(int32_t value) {_value.store(value, std::memory_order_relaxed);}
+    int32_t get() const {return _value.load(std::memory_order_relaxed);}
+private:
+    std::atomic <int32_t> _value;
+};
+
+/**
+ * @brief distribution of a value, like a duration in microseconds, in power of two buckets
+ */
+class StatHistogram{
+public:
+    StatHistogram();
+    void record(uint32_t value);
+
+    uint32_t getCount() const;
+    uint32_t getSum() const;    //wraps: use the difference of two readings
+    uint32_t getMax() const;
+    uint32_t getMean() const;
+    uint32_t getPercentile(uint8_t percent) const;
+    uint32_t getBucket(uint8_t bucket) const;
+    void reset();
+private:
+    struct CoreData{
+        std::atomic <uint32_t> buckets[STATS_HISTOGRAM_BUCKETS];
+        std::atomic <uint32_t> count;
+        std::atomic <uint32_t> sum;
+        std::atomic <uint32_t> max;
+    };
+    CoreData _cores[STATS_CORE_COUNT];
+};
+
+struct StatEntry{
+    const char* name;   //string literal
+    StatType type;
+    void* stat;
+};
+
+/**
+ * @brief named statistics of the kernel and the programs. A statistic is looked up once, usually at init,
+ * then updated through its pointer without locks.
+ * @details statistics are never deleted. When the registry is full the lookup returns nullptr
+ */
+class StatsRegistry{
+public:
+    static StatCounter* counter(const char* name);
+    static StatGauge* gauge(const char* name);
+    static StatHistogram* histogram(const char* name);
+
+    static size_t size();
+    static const StatEntry* getEntry(size_t index);
+    static const StatEntry* find(const char* name);
+private:
+    static void* lookup(const char* name, StatType type);
+
+    static StatEntry _entries[STATS_MAX_ENTRIES];
+    static std::atomic <size_t> _size;
+    static std::mutex _mutex;   //only for lookups
+};
+
+#endif //STATS_REGISTRY_H
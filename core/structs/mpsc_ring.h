@@ -0,0 +1,87 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief fixed capacity ring buffer for many producers and one consumer. No locks and no allocations
+ * @details producers claim a slot moving _head with a compare and swap, fill it and then publish it through
+ * the slot sequence number, so a producer preempted while filling a slot never blocks the other producers.
+ * The consumer stops at the first slot that is not published yet. The capacity must be a power of two
+ */
+template <typename T, size_t CAPACITY>
+class MpscRing{
+    static_assert(CAPACITY > 1 && (CAPACITY & (CAPACITY - 1)) == 0, "MpscRing capacity must be a power of two");
+public:
+    MpscRing() : _head(0), _tail(0){
+        for(uint32_t i = 0; i < CAPACITY; i++) _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief add an item filled in place by fill(T&). Producer side, can be called from any task or interrupt
+     * @return false if the ring is full, fill is not called
+     */
+    template <typename F>
+    bool emplace(F fill){
+        uint32_t pos = _head.load(std::memory_order_relaxed);
+        Cell* cell;
+        while(true){
+            cell = &_cells[pos & (CAPACITY - 1)];
+            int32_t diff = (int32_t)(cell->sequence.load(std::memory_order_acquire) - pos);
+            if(diff == 0){
+                if(_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            }else if(diff < 0){
+                return false;   //the slot still holds an item of the previous lap
+            }else{
+                pos = _head.load(std::memory_order_relaxed);    //another producer took the slot
+            }
+        }
+        fill(cell->item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T &item){
+        return emplace([&item](T &slot){ slot = item; });
+    }
+
+    /**
+     * @brief the oldest item, or nullptr if the ring is empty or the oldest slot is still being filled. Consumer side
+     */
+    T* front(){
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        Cell &cell = _cells[tail & (CAPACITY - 1)];
+        if(cell.sequence.load(std::memory_order_acquire) != tail + 1) return nullptr;
+        return &cell.item;
+    }
+
+    /**
+     * @brief release the item returned by front(). Consumer side
+     */
+    void pop(){
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        _cells[tail & (CAPACITY - 1)].sequence.store(tail + CAPACITY, std::memory_order_release);
+        _tail.store(tail + 1, std::memory_order_release);
+    }
+
+    size_t size() const {return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);}
+    bool empty() const {return size() == 0;}
+    static constexpr size_t capacity() {return CAPACITY;}
+
+private:
+    struct Cell{
+        std::atomic <uint32_t> sequence;    //pos + 1 when the item at pos is published, pos + CAPACITY when it is free again
+        T item;
+    };
+    Cell _cells[CAPACITY];
+    std::atomic <uint32_t> _head;   //next slot to claim
+    std::atomic <uint32_t> _tail;   //next slot to read
+};
+
+#endif //MPSC_RING_H
@@ -0,0 +1,57 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief fixed capacity ring buffer for one producer and one consumer thread. No locks and no allocations
+ * @details the indexes run freely and wrap on the capacity, that must be a power of two.
+ * Only the producer writes _head and only the consumer writes _tail
+ */
+template <typename T, size_t CAPACITY>
+class SpscRing{
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscRing capacity must be a power of two");
+public:
+    SpscRing() : _head(0), _tail(0){}
+
+    /**
+     * @brief add an item. Producer side
+     * @return false if the ring is full, the item is not added
+     */
+    bool push(const T &item){
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if(head - _tail.load(std::memory_order_acquire) >= CAPACITY) return false;
+        _items[head & (CAPACITY - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief remove the oldest item. Consumer side
+     * @return false if the ring is empty
+     */
+    bool pop(T &item){
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if(tail == _head.load(std::memory_order_acquire)) return false;
+        item = _items[tail & (CAPACITY - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);}
+    bool empty() const {return size() == 0;}
+    static constexpr size_t capacity() {return CAPACITY;}
+
+private:
+    T _items[CAPACITY];
+    std::atomic <uint32_t> _head;   //next slot to write
+    std::atomic <uint32_t> _tail;   //next slot to read
+};
+
+#endif //SPSC_RING_H
@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef GUI_ANIMATION_H
+#define GUI_ANIMATION_H
+
+#include <stdint.h>
+
+/**
+ * @brief a value that moves from one position to another in a fixed time, with an ease out curve.
+ * @details the value is computed from the frame time, so it does not depend on how often frames are drawn
+ */
+class GuiAnimation{
+public:
+    GuiAnimation() : _from(0), _to(0), _start(0), _duration(0), _running(false) {}
+
+    void start(int16_t from, int16_t to, uint32_t now, uint16_t duration){
+        _from = from;
+        _to = to;
+        _start = now;
+        _duration = duration;
+        _running = from != to && duration > 0;
+    }
+
+    //jump to the final value
+    void stop(int16_t value){
+        _from = _to = value;
+        _running = false;
+    }
+
+    //value at the frame time. The animation stops when it reaches the end
+    int16_t value(uint32_t now){
+        if(!_running) return _to;
+        uint32_t elapsed = now - _start;
+        if(elapsed >= _duration){
+            _running = false;
+            return _to;
+        }
+        float t = 1.0f - (float)elapsed / _duration;
+        float progress = 1.0f - t * t * t;  //ease out cubic: fast start, slow end
+        return _from + (int16_t)((_to - _from) * progress);
+    }
+
+    int16_t target() const {return _to;}
+    bool isRunning() const {return _running;}
+private:
+    int16_t _from, _to;
+    uint32_t _start;    //frame time when the animation started
+    uint16_t _duration; //in ms
+    bool _running;
+};
+
+#endif //GUI_ANIMATION_H
@@ -0,0 +1,272 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/task/gui/gui_container.h"
+#include "core/task/gui/gui_element.h"
+
+#include <algorithm>
+
+GuiContainer::GuiContainer(uint16_t id, Gui_ContainerType type, int view_x, int view_y, int spacing) :
+    _type(type),
+    _id(id)
+{
+    _parent = nullptr;
+    _x = view_x;
+    _y = view_y;
+    _width = 0;
+    _height = 0;
+    _contentHeight = 0;
+    _spacing = spacing;
+    _activePage = 0;
+    _visibleHeight = 0;
+    _scroll = 0;
+    _visibility = Gui_Visibility::VISIBLE;
+    _layoutDirty = true;
+    _placed = false;
+}
+
+GuiContainer::~GuiContainer(){
+    detachChildren();
+    if(_parent) _parent->removeChild(this);
+}
+
+void GuiContainer::addChild(CESP_GuiElement* element){
+    _children.push_back({element, nullptr});
+    element->setContainer(this);
+    markLayoutDirty();
+}
+
+void GuiContainer::addChild(GuiContainer* container){
+    _children.push_back({nullptr, container});
+    container->_parent = this;
+    markLayoutDirty();
+}
+
+void GuiContainer::removeChild(CESP_GuiElement* element){
+    for(auto it = _children.begin(); it != _children.end(); ++it){
+        if(it->element == element){
+            removePage(it - _children.begin());
+            _children.erase(it);
+            element->setContainer(nullptr);
+            markLayoutDirty();
+            return;
+        }
+    }
+}
+
+void GuiContainer::removeChild(GuiContainer* container){
+    for(auto it = _children.begin(); it != _children.end(); ++it){
+        if(it->container == container){
+            removePage(it - _children.begin());
+            _children.erase(it);
+            container->_parent = nullptr;
+            container->markLayoutDirty();
+            markLayoutDirty();
+            return;
+        }
+    }
+}
+
+/**
+ * @brief keep the active page of a PAGES container on the same child when the child at index is removed
+ * @details if the active page itself is removed the next one is shown, or the previous one if it was the last
+ */
+void GuiContainer::removePage(int index){
+    if(index < _activePage || (index == _activePage && _activePage == _children.size() - 1 && _activePage > 0)){
+        _activePage--;
+    }
+}
+
+/**
+ * @brief remove all the children. They keep the last position they had
+ */
+void GuiContainer::detachChildren(){
+    for(Child &child : _children){
+        if(child.element){
+            child.element->setContainer(nullptr);
+        }else{
+            child.container->_parent = nullptr;
+            child.container->markLayoutDirty();    //placed again as a top level container
+        }
+    }
+    _children.clear();
+    _activePage = 0;
+    markLayoutDirty();
+}
+
+/**
+ * @brief the size or the children of the container changed: it must be measured and placed again, and so its parents
+ */
+void GuiContainer::markLayoutDirty(){
+    for(GuiContainer* container = this; container != nullptr && !container->_layoutDirty; container = container->_parent){
+        container->_layoutDirty = true;
+    }
+    //parents of a dirty container are already dirty
+}
+
+/**
+ * @brief select the visible page of a PAGES container
+ * @return 0 on success, -1 if the page does not exist
+ */
+int GuiContainer::setActivePage(int page){
+    if(page < 0 || page >= _children.size()) return -1;
+    if(page == _activePage) return 0;
+    _activePage = page;
+    markLayoutDirty();
+    return 0;
+}
+
+/**
+ * @brief set the height of a scroll region. 0 means no limit
+ */
+void GuiContainer::setVisibleHeight(int height){
+    _visibleHeight = height > 0 ? height : 0;
+    markLayoutDirty();
+}
+
+/**
+ * @brief compute the size of the container. Only dirty subtrees are measured again
+ */
+void GuiContainer::measure(const GuiLayoutMetrics &metrics){
+    if(!_layoutDirty) return;
+
+    int width = 0, height = 0;
+    for(int i = 0; i < _children.size(); i++){
+        Child &child = _children[i];
+        if(child.container) child.container->measure(metrics);
+        int child_width = childWidth(child, metrics);
+        int child_height = childHeight(child, metrics);
+
+        switch(_type){
+        case Gui_ContainerType::VERTICAL_STACK:
+        case Gui_ContainerType::SCROLL_REGION:
+            width = std::max(width, child_width);
+            height += child_height + (i > 0 ? _spacing : 0);
+            break;
+        case Gui_ContainerType::HORIZONTAL_STACK:
+            width += child_width + (i > 0 ? _spacing : 0);
+            height = std::max(height, child_height);
+            break;
+        case Gui_ContainerType::PAGES:
+            if(i == _activePage){
+                width = child_width;
+                height = child_height;
+            }
+            break;
+        }
+    }
+
+    _contentHeight = height;
+    if(_type == Gui_ContainerType::SCROLL_REGION && _visibleHeight > 0) height = _visibleHeight;
+    _width = width;
+    _height = height;
+}
+
+/**
+ * @brief place the container and its children. Subtrees that are not dirty, did not move and
+ * did not change visibility are skipped
+ * @details must be called after measure()
+ */
+void GuiContainer::place(int x, int y, Gui_Visibility visibility, GuiLayoutContext &context){
+    if(_placed && !_layoutDirty && x == _x && y == _y && visibility == _visibility) return;
+    _x = x;
+    _y = y;
+    _visibility = visibility;
+    _placed = true;
+
+    //scroll regions follow the focused element
+    if(_type == Gui_ContainerType::SCROLL_REGION && _visibleHeight > 0){
+        int focused_child = findFocusedChild(context.focused);
+        if(focused_child >= 0){
+            int offset = 0;
+            for(int i = 0; i < focused_child; i++){
+                offset += childHeight(_children[i], context.metrics) + _spacing;
+            }
+            int height = childHeight(_children[focused_child], context.metrics);
+            if(offset < _scroll) _scroll = offset;
+            if(offset + height > _scroll + _visibleHeight) _scroll = offset + height - _visibleHeight;
+        }
+        _scroll = std::min(_scroll, _contentHeight - _visibleHeight);
+        _scroll = std::max(_scroll, 0);
+    }
+
+    int cursor = 0;
+    for(int i = 0; i < _children.size(); i++){
+        Child &child = _children[i];
+        int child_width = childWidth(child, context.metrics);
+        int child_height = childHeight(child, context.metrics);
+
+        switch(_type){
+        case Gui_ContainerType::VERTICAL_STACK:
+            placeChild(child, x, y + cursor, visibility, context);
+            cursor += child_height + _spacing;
+            break;
+        case Gui_ContainerType::HORIZONTAL_STACK:
+            placeChild(child, x + cursor, y, visibility, context);
+            cursor += child_width + _spacing;
+            break;
+        case Gui_ContainerType::PAGES:
+            placeChild(child, x, y, i == _activePage ? visibility : Gui_Visibility::HIDDEN, context);
+            break;
+        case Gui_ContainerType::SCROLL_REGION:{
+            int child_y = cursor - _scroll;
+            bool inside = _visibleHeight == 0 || (child_y >= 0 && child_y + child_height <= _visibleHeight);
+            placeChild(child, x, y + child_y, inside ? visibility : std::max(visibility, Gui_Visibility::CLIPPED), context);
+            cursor += child_height + _spacing;
+            break;
+        }
+        }
+    }
+    _layoutDirty = false;
+}
+
+void GuiContainer::placeChild(Child &child, int x, int y, Gui_Visibility visibility, GuiLayoutContext &context){
+    if(child.container){
+        child.container->place(x, y, visibility, context);
+        return;
+    }
+    bool moved = child.element->setPosition(x, y);
+    bool shown = child.element->setVisibility(visibility);
+    if(moved || shown) context.moved = true;
+}
+
+//index of the child that is or contains the focused element, -1 if none
+int GuiContainer::findFocusedChild(const CESP_GuiElement* focused) const{
+    if(focused == nullptr) return -1;
+
+    //walk up from the focused element until the direct child of this container
+    const GuiContainer* container = focused->getContainer();
+    const GuiContainer* child_container = nullptr;
+    while(container != nullptr && container != this){
+        child_container = container;
+        container = container->_parent;
+    }
+    if(container == nullptr) return -1;
+
+    for(int i = 0; i < _children.size(); i++){
+        if(child_container == nullptr && _children[i].element == focused) return i;
+        if(child_container != nullptr && _children[i].container == child_container) return i;
+    }
+    return -1;
+}
+
+int GuiContainer::elementWidth(const CESP_GuiElement* element, const GuiLayoutMetrics &metrics){
+    const GuiText* text = element->getDisplayText();
+    return text ? text->length() * metrics.char_width : 0;
+}
+
+int GuiContainer::elementHeight(const CESP_GuiElement* element, const GuiLayoutMetrics &metrics){
+    if(element->_element_type == Gui_ElementType::VIRTUAL_LIST){
+        return element->getVirtualListVisibleRows() * element->getRowHeight();
+    }
+    return metrics.line_height;
+}
+
+int GuiContainer::childWidth(const Child &child, const GuiLayoutMetrics &metrics) const{
+    return child.container ? child.container->_width : elementWidth(child.element, metrics);
+}
+
+int GuiContainer::childHeight(const Child &child, const GuiLayoutMetrics &metrics) const{
+    return child.container ? child.container->_height : elementHeight(child.element, metrics);
+}
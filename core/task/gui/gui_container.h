@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef GUI_CONTAINER_H
+#define GUI_CONTAINER_H
+
+#include <stdint.h>
+#include <vector>
+
+class CESP_GuiElement;
+
+enum class Gui_ContainerType{
+    VERTICAL_STACK = 0,     //children one below the other
+    HORIZONTAL_STACK = 1,   //children side by side
+    PAGES = 2,              //children in the same place, only the active page is visible
+    SCROLL_REGION = 3,      //vertical stack with a fixed height, scrolls to keep the focused child visible
+};
+
+//size of the text used to compute the size of the elements
+struct GuiLayoutMetrics{
+    uint8_t char_width;
+    uint8_t line_height;
+};
+
+//data shared by the containers during a layout pass
+struct GuiLayoutContext{
+    GuiLayoutMetrics metrics;
+    const CESP_GuiElement* focused;    //focused element, scroll regions keep it visible
+    bool moved;     //some element changed position or visibility
+};
+
+/**
+ * @brief internal class that groups gui elements and other containers and computes their position.
+ * @details the layout is incremental: only containers marked dirty (and their parents) are measured again,
+ * and only subtrees that are dirty, moved or changed visibility are placed again
+ */
+class GuiContainer{
+public:
+    GuiContainer(uint16_t id, Gui_ContainerType type, int view_x, int view_y, int spacing);
+    ~GuiContainer();
+
+    void addChild(CESP_GuiElement* element);
+    void addChild(GuiContainer* container);
+    void removeChild(CESP_GuiElement* element);
+    void removeChild(GuiContainer* container);
+    void detachChildren();
+
+    void markLayoutDirty();
+    void measure(const GuiLayoutMetrics &metrics);
+    void place(int x, int y, Gui_Visibility visibility, GuiLayoutContext &context);
+
+    int setActivePage(int page);
+    void setVisibleHeight(int height);
+    GuiContainer* getParent() const {return _parent;}
+    bool isLayoutDirty() const {return _layoutDirty;}
+    int getX() const {return _x;}
+    int getY() const {return _y;}
+    int getWidth() const {return _width;}
+    int getHeight() const {return _height;}
+
+    const Gui_ContainerType _type;
+    const uint16_t _id;
+private:
+    struct Child{
+        CESP_GuiElement* element;   //one of the two is nullptr
+        GuiContainer* container;
+    };
+
+    static int elementWidth(const CESP_GuiElement* element, const GuiLayoutMetrics &metrics);
+    static int elementHeight(const CESP_GuiElement* element, const GuiLayoutMetrics &metrics);
+    int childWidth(const Child &child, const GuiLayoutMetrics &metrics) const;
+    int childHeight(const Child &child, const GuiLayoutMetrics &metrics) const;
+    int findFocusedChild(const CESP_GuiElement* focused) const;
+    void removePage(int index);
+    void placeChild(Child &child, int x, int y, Gui_Visibility visibility, GuiLayoutContext &context);
+
+    std::vector <Child> _children;
+    GuiContainer* _parent;
+    int _x, _y;     //position in the view (relative to the view for top level containers)
+    int _width, _height;
+    int _spacing;
+    int _activePage;
+    int _visibleHeight, _scroll;    //scroll regions only
+    int _contentHeight;
+    Gui_Visibility _visibility;
+    bool _layoutDirty;  //size or children changed
+    bool _placed;       //placed at least once
+};
+
+#endif //GUI_CONTAINER_H
@@ -5,6 +5,8 @@
 #include "core/task/gui/gui_element.h"
 #include "core/task/gui/view_error.h"
 
+#include <algorithm>
+
 /**
  * @brief constructor used for every element except lists. Also include a text
  */
@@ -13,7 +15,16 @@ CESP_GuiElement::CESP_GuiElement(const uint16_t id, Gui_ElementType type, std::s
     _id(id)
 {
     _active = false;
+    _visibility = Gui_Visibility::VISIBLE;
+    _container = nullptr;
+    _eventCallback = nullptr;
+    _eventCallbackContext = nullptr;
+    _eventMask = 0;
     _display_text_index = -1;
+    _dataSource = {nullptr, nullptr, nullptr};
+    _rowCacheValid = false;
+    _itemCount = _firstRow = _cursor = _cacheFirstRow = 0;
+    _visibleRows = _rowHeight = 0;
     _view_pos_x = view_pos_x;
     _view_pos_y = view_pos_y;
     //everything other than a list should always have a text
@@ -31,17 +42,56 @@ CESP_GuiElement::CESP_GuiElement(uint16_t id, Gui_ElementType type, bool selecta
     _id(id)
 {
     _active = false;
+    _visibility = Gui_Visibility::VISIBLE;
+    _container = nullptr;
+    _eventCallback = nullptr;
+    _eventCallbackContext = nullptr;
+    _eventMask = 0;
     _display_text_index = -1;
+    _dataSource = {nullptr, nullptr, nullptr};
+    _rowCacheValid = false;
+    _itemCount = _firstRow = _cursor = _cacheFirstRow = 0;
+    _visibleRows = _rowHeight = 0;
     _view_pos_x = view_pos_x;
     _view_pos_y = view_pos_y;
 
     //everything other than a list should always have a text
     if(_element_type != Gui_ElementType::LIST){
-        _text_list.push_back("");
+        _text_list.push_back(GuiText());
     }
     _selectable = selectable;
 }
 
+/**
+ * @brief constructor used for virtual lists: the text comes from the data source
+ */
+CESP_GuiElement::CESP_GuiElement(uint16_t id, const GuiListDataSource &source, uint8_t visible_rows, uint8_t row_height, int view_pos_x, int view_pos_y) :
+    _element_type(Gui_ElementType::VIRTUAL_LIST),
+    _id(id)
+{
+    _active = false;
+    _visibility = Gui_Visibility::VISIBLE;
+    _container = nullptr;
+    _eventCallback = nullptr;
+    _eventCallbackContext = nullptr;
+    _eventMask = 0;
+    _display_text_index = -1;
+    _view_pos_x = view_pos_x;
+    _view_pos_y = view_pos_y;
+    _selectable = true;
+
+    _dataSource = source;
+    _visibleRows = visible_rows;
+    _rowHeight = row_height;
+    _rowCache.resize(_visibleRows); //the only allocation of the list
+    _rowCacheValid = false;
+    _firstRow = 0;
+    _cacheFirstRow = 0;
+    _cursor = 0;
+    _itemCount = 0;
+    refreshVirtualList();
+}
+
 ViewError CESP_GuiElement::add_text(const std::string &new_string){
     if(_element_type != Gui_ElementType::LIST)
         return ViewError::FUNCTION_NOT_AVAILABLE;  //invalid function for this element
@@ -58,19 +108,41 @@ ViewError CESP_GuiElement::setText(const std::string &new_string){
         return ViewError::FUNCTION_NOT_AVAILABLE;  //invalid function for this element
 
     _text_list[0] = new_string;
-    ViewError::NO_ERROR;
+    return ViewError::NO_ERROR;
 }
 
 ViewError CESP_GuiElement::getText(std::string &text) const{
+    if(_element_type == Gui_ElementType::VIRTUAL_LIST){
+        if(_itemCount == 0) return ViewError::EMPTY_FIELD;
+        GuiText item;
+        if(!_dataSource.getItem(_dataSource.context, _cursor, item)) return ViewError::EMPTY_FIELD;
+        text = item.c_str();   //return the text of the item under the cursor
+        return ViewError::NO_ERROR;
+    }
     if(_element_type == Gui_ElementType::LIST){
         if(_text_list.size() == 0) return ViewError::EMPTY_FIELD;   //nothing available
-        text = _text_list[_display_text_index]; //return current displayed string
+        text = _text_list[_display_text_index].c_str(); //return current displayed string
         return ViewError::NO_ERROR;
     }
-    text = _text_list[0];
+    text = _text_list[0].c_str();
     return ViewError::NO_ERROR;
 }
 
+/**
+ * @brief get the text currently shown by the element without copying it
+ * @return nullptr if the element has no text (empty list)
+ */
+const GuiText* CESP_GuiElement::getDisplayText() const{
+    if(_element_type == Gui_ElementType::VIRTUAL_LIST){
+        return nullptr;   //rows are read with getVirtualListRow()
+    }
+    if(_element_type == Gui_ElementType::LIST){
+        if(_text_list.size() == 0) return nullptr;
+        return &_text_list[_display_text_index];
+    }
+    return &_text_list[0];
+}
+
 ViewError CESP_GuiElement::selectListTextIndex(int index){
     if(_element_type != Gui_ElementType::LIST)
         return ViewError::FUNCTION_NOT_AVAILABLE;  //invalid function for this element
@@ -113,3 +185,144 @@ int CESP_GuiElement::decrementShownedText(const int step){
 void CESP_GuiElement::setSelectable(bool selectable){
     _selectable = selectable;
 }
+
+/**
+ * @brief reads again the number of items from the data source and discards the cached rows
+ * @details call it when the data of the list changes
+ */
+ViewError CESP_GuiElement::refreshVirtualList(){
+    if(_element_type != Gui_ElementType::VIRTUAL_LIST)
+        return ViewError::FUNCTION_NOT_AVAILABLE;  //invalid function for this element
+
+    _itemCount = _dataSource.getCount ? _dataSource.getCount(_dataSource.context) : 0;
+    if(_itemCount < 0) _itemCount = 0;
+    if(_cursor >= _itemCount) _cursor = _itemCount > 0 ? _itemCount - 1 : 0;
+    scrollToCursor();
+    _rowCacheValid = false;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief move the list cursor by step items (negative to go back). The cursor stops at the list boundaries
+ * @return 0 if the cursor moved, -1 if the function is not available, -2 if nothing changed
+ */
+int CESP_GuiElement::moveVirtualListCursor(const int step){
+    if(_element_type != Gui_ElementType::VIRTUAL_LIST)
+        return -1;  //invalid function for this element
+
+    int new_cursor = _cursor + step;
+    if(new_cursor >= _itemCount) new_cursor = _itemCount - 1;
+    if(new_cursor < 0) new_cursor = 0;
+    if(new_cursor == _cursor) return -2;    //nothing to change
+
+    _cursor = new_cursor;
+    scrollToCursor();
+    return 0;
+}
+
+ViewError CESP_GuiElement::selectVirtualListIndex(int index){
+    if(_element_type != Gui_ElementType::VIRTUAL_LIST)
+        return ViewError::FUNCTION_NOT_AVAILABLE;  //invalid function for this element
+
+    if(index < 0 || index >= _itemCount){
+        return ViewError::INVALID_PARAM; //invalid parameter
+    }
+    _cursor = index;
+    scrollToCursor();
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief number of rows the list shows on screen
+ */
+uint8_t CESP_GuiElement::getVirtualListRowCount() const{
+    if(_element_type != Gui_ElementType::VIRTUAL_LIST) return 0;
+    int rows = _itemCount - _firstRow;
+    return rows < _visibleRows ? rows : _visibleRows;
+}
+
+/**
+ * @brief get the text of a visible row. Items are requested to the data source only when the visible window changes
+ */
+const GuiText* CESP_GuiElement::getVirtualListRow(uint8_t row){
+    if(_element_type != Gui_ElementType::VIRTUAL_LIST || row >= getVirtualListRowCount()) return nullptr;
+
+    if(!_rowCacheValid || _cacheFirstRow != _firstRow){
+        int rows = getVirtualListRowCount();
+        int delta = _firstRow - _cacheFirstRow;
+        int fetch_start = 0, fetch_end = rows;
+
+        //the window scrolled by less than its size: keep the rows already available
+        if(_rowCacheValid && delta > 0 && delta < _visibleRows){
+            std::move(_rowCache.begin() + delta, _rowCache.end(), _rowCache.begin());
+            fetch_start = _visibleRows - delta;
+        }else if(_rowCacheValid && delta < 0 && -delta < _visibleRows){
+            std::move_backward(_rowCache.begin(), _rowCache.end() + delta, _rowCache.end());
+            fetch_end = -delta < rows ? -delta : rows;
+        }
+
+        for(int i = fetch_start; i < fetch_end; i++){
+            if(!_dataSource.getItem(_dataSource.context, _firstRow + i, _rowCache[i])){
+                _rowCache[i].assign("", 0);
+            }
+        }
+        _cacheFirstRow = _firstRow;
+        _rowCacheValid = true;
+    }
+    return &_rowCache[row];
+}
+
+//move the visible window the least possible to show the cursor
+void CESP_GuiElement::scrollToCursor(){
+    int first_row = _firstRow;
+    if(_cursor < first_row) first_row = _cursor;
+    if(_cursor >= first_row + _visibleRows) first_row = _cursor - _visibleRows + 1;
+
+    //do not leave empty rows at the end if the list is long enough
+    if(first_row > _itemCount - _visibleRows) first_row = _itemCount - _visibleRows;
+    if(first_row < 0) first_row = 0;
+
+    _firstRow = first_row;   //the cached rows are updated when they are read
+}
+
+/**
+ * @brief move the element
+ * @return true if the position changed
+ */
+bool CESP_GuiElement::setPosition(int view_pos_x, int view_pos_y){
+    if(view_pos_x == _view_pos_x && view_pos_y == _view_pos_y) return false;
+    _view_pos_x = view_pos_x;
+    _view_pos_y = view_pos_y;
+    return true;
+}
+
+/**
+ * @brief show, clip or hide the element. Only visible elements are drawn
+ * @return true if the visibility changed
+ */
+bool CESP_GuiElement::setVisibility(Gui_Visibility visibility){
+    if(visibility == _visibility) return false;
+    _visibility = visibility;
+    return true;
+}
+
+/**
+ * @brief set the function called when the element generates one of the events in the mask
+ * @param callback the function, nullptr to remove it
+ * @param eventMask events handled by the callback, built with guiEventMask
+ */
+void CESP_GuiElement::setEventCallback(GuiEventCallback callback, void* context, uint8_t eventMask){
+    _eventCallback = callback;
+    _eventCallbackContext = context;
+    _eventMask = callback ? eventMask : 0;
+}
+
+/**
+ * @brief call the event callback if it handles the event
+ * @return true if the event was handled
+ */
+bool CESP_GuiElement::dispatchEvent(const GuiEventData &event) const{
+    if((_eventMask & guiEventMask(event.type)) == 0) return false;
+    _eventCallback(event, _eventCallbackContext);
+    return true;
+}
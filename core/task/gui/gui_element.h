@@ -11,11 +11,32 @@
 
 #include "core/task/gui/view_error.h"
 #include "core/task/gui/gui_event.h"
+#include "core/task/gui/gui_text.h"
+
+class GuiContainer;
 
 enum class Gui_ElementType{
     GENERIC = 0,    //no special functions
     BUTTON = 1,
     LIST = 2,
+    VIRTUAL_LIST = 3,   //list with items provided by a data source, only the visible ones are kept in memory
+};
+
+/**
+ * @brief data source of a virtual list. The functions are called from the task thread,
+ * only for the items that are shown on screen
+ */
+struct GuiListDataSource{
+    int (*getCount)(void* context);  //number of items in the list
+    bool (*getItem)(void* context, int index, GuiText &text);   //copy the text of the item, false if not available
+    void* context;  //user pointer passed to the functions
+};
+
+//visibility set by the container of the element, ordered from the most to the least visible
+enum class Gui_Visibility{
+    VISIBLE = 0,
+    CLIPPED = 1,    //outside of a scroll region: not drawn, but can be selected to scroll it into view
+    HIDDEN = 2      //inactive page: not drawn and not selectable
 };
 
 /**
@@ -25,16 +46,41 @@ class CESP_GuiElement{
 public:
     CESP_GuiElement(uint16_t ID, Gui_ElementType type, std::string text, bool selectable, int view_pos_x, int view_pos_y);
     CESP_GuiElement(uint16_t ID, Gui_ElementType type, bool selectable, int view_pos_x, int view_pos_y);
+    CESP_GuiElement(uint16_t ID, const GuiListDataSource &source, uint8_t visible_rows, uint8_t row_height, int view_pos_x, int view_pos_y);
     ViewError add_text(const std::string &new_string);
     ViewError setText(const std::string &new_string);
     ViewError getText(std::string &text) const;
+    const GuiText* getDisplayText() const;
     ViewError selectListTextIndex(int index);
     int incrementShownedText(const int step);
     int decrementShownedText(const int step);
-    bool isSelectable() {return _selectable;}
+    bool isSelectable() const {return _selectable && _visibility != Gui_Visibility::HIDDEN;}
     void setSelectable(bool selectable);
-    int getX(){return _view_pos_x;}
-    int getY(){return _view_pos_y;}
+
+    //event callback
+    void setEventCallback(GuiEventCallback callback, void* context, uint8_t eventMask);
+    bool dispatchEvent(const GuiEventData &event) const;
+
+    //virtual list functions
+    ViewError refreshVirtualList();
+    int moveVirtualListCursor(const int step);
+    ViewError selectVirtualListIndex(int index);
+    int getVirtualListIndex() const {return _cursor;}
+    uint8_t getVirtualListRowCount() const;
+    uint8_t getVirtualListCursorRow() const {return _cursor - _firstRow;}
+    uint8_t getRowHeight() const {return _rowHeight;}
+    uint8_t getVirtualListVisibleRows() const {return _visibleRows;}
+    const GuiText* getVirtualListRow(uint8_t row);
+    int getX() const {return _view_pos_x;}
+    int getY() const {return _view_pos_y;}
+
+    //layout functions: the position of elements in a container is set by the container
+    bool setPosition(int view_pos_x, int view_pos_y);
+    bool setVisibility(Gui_Visibility visibility);
+    bool isVisible() const {return _visibility == Gui_Visibility::VISIBLE;}
+    bool isHidden() const {return _visibility == Gui_Visibility::HIDDEN;}
+    GuiContainer* getContainer() const {return _container;}
+    void setContainer(GuiContainer* container) {_container = container;}
 
     bool _active;  //user is interacting with it
     const Gui_ElementType _element_type;
@@ -42,8 +88,22 @@ public:
 private:
     int _view_pos_x, _view_pos_y;
     int16_t _display_text_index;
-    std::vector <std::string> _text_list;
+    std::vector <GuiText> _text_list;
     bool _selectable; //user selected it
+    Gui_Visibility _visibility;
+    GuiContainer* _container;   //container that places the element, nullptr if the position is set by the user
+    GuiEventCallback _eventCallback;
+    void* _eventCallbackContext;
+    uint8_t _eventMask;     //events handled by the callback, see guiEventMask
+
+    //virtual list data
+    void scrollToCursor();
+    GuiListDataSource _dataSource;
+    std::vector <GuiText> _rowCache;    //text of the visible rows
+    bool _rowCacheValid;
+    int _itemCount, _firstRow, _cursor;
+    int _cacheFirstRow;     //item shown in the first row of the cache
+    uint8_t _visibleRows, _rowHeight;
 };
 
 #endif  //GUI_ELEMENT_H
\ No newline at end of file
@@ -5,13 +5,38 @@
 #ifndef GUI_EVENT_H
 #define GUI_EVENT_H
 
+#include <stdint.h>
+
 enum class GuiEvent{
     NONE = 0,
     BUTTON_PRESSED = 1,
     BUTTON_RELEASED = 2,
     CHANGED_FOCUS = 3,
     LIST_FOCUS_START = 4,
-    LIST_FOCUS_END = 5
+    LIST_FOCUS_END = 5,
+    LIST_CHANGED = 6    //the shown item of a list changed
+};
+
+//gui event with the element that generated it
+struct GuiEventData{
+    GuiEvent type;
+    int16_t elementId;      //-1 if no element is involved (e.g. focus lost)
+    uint32_t timestamp;     //millis() when the event was generated
+};
+
+/**
+ * @brief function called on the task thread when an element generates an event. The event is not queued
+ * @details it runs inside the input handling of the task: it can change the view, but should be quick
+ */
+typedef void (*GuiEventCallback)(const GuiEventData &event, void* context);
+
+//bit of an event in a callback event mask
+inline uint8_t guiEventMask(GuiEvent event){
+    return 1 << static_cast<uint8_t>(event);
+}
+
+namespace{
+    const uint8_t GUI_EVENT_MASK_ALL = 0xFE;   //every event except NONE
 };
 
 #endif //GUI_EVENT_H
\ No newline at end of file
@@ -0,0 +1,52 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef GUI_TEXT_H
+#define GUI_TEXT_H
+
+#include "core/task/gui/text_metrics_cache.h"   //for the text hash
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+namespace{
+    //sized for the widest display supported: a 320 pixels wide screen fits 53 characters of the 5x7 font.
+    //Longer texts are truncated, RgbDisplayDevice warns about wider screens
+    const int GUI_TEXT_MAX_LENGTH = 53;
+};
+
+/**
+ * @brief fixed capacity string used by gui elements and render snapshots.
+ * @details it never allocates memory, so copying it in the render data is just a copy of the struct.
+ * The hash used by the renderer metrics cache is computed once when the text changes
+ */
+class GuiText{
+public:
+    GuiText() { assign("", 0); }
+    GuiText(const char* text) { assign(text, strlen(text)); }
+    GuiText(const std::string &text) { assign(text.c_str(), text.length()); }
+
+    void assign(const char* text, size_t length){
+        if(length > GUI_TEXT_MAX_LENGTH) length = GUI_TEXT_MAX_LENGTH;
+        memcpy(_data, text, length);
+        _data[length] = '\0';
+        _length = length;
+        _hash = TextMetricsCache::hashText(_data, _length);
+    }
+
+    const char* c_str() const { return _data; }
+    uint8_t length() const { return _length; }
+    uint32_t hash() const { return _hash; }
+    bool operator==(const GuiText &other) const {
+        return _hash == other._hash && _length == other._length && memcmp(_data, other._data, _length) == 0;
+    }
+    bool operator!=(const GuiText &other) const { return !(*this == other); }
+private:
+    char _data[GUI_TEXT_MAX_LENGTH + 1];
+    uint8_t _length;
+    uint32_t _hash;
+};
+
+#endif //GUI_TEXT_H
@@ -4,15 +4,47 @@
 
 #include "core/task/gui/task_view_renderer.h"
 #include "core/task/gui/view_render.h"
+#include "core/task/gui/text_metrics_cache.h"
 #include "core/logging/logging.h"
 
 #include "core/kernel/device/display_device.h"
+#include "core/kernel/components/display_compositor.h"
+#include "core/tracing/tracer.h"
+#include "core/stats/stats_registry.h"
 #include "chibiESP.h"
 
-TaskViewRenderer::TaskViewRenderer(){
-    _displayDevice = chibiESP.getDisplayDevice(0);
+#include <algorithm>
+#include <vector>
+
+namespace{
+    //colors used on RGB displays
+    const RGB_Color GUI_RGB_BACKGROUND = {0, 0, 0};
+    const RGB_Color GUI_RGB_TEXT = {255, 255, 255};
+    const RGB_Color GUI_RGB_FOCUS_BACKGROUND = {0, 120, 215};
+    const RGB_Color GUI_RGB_FOCUS_TEXT = {255, 255, 255};
+
+    //animation durations in ms
+    const uint16_t GUI_SCROLL_ANIMATION_MS = 120;
+    const uint16_t GUI_TRANSITION_ANIMATION_MS = 200;
+};
+
+/**
+ * @brief create a renderer that draws on a display
+ * @param displayId id of the display device
+ */
+TaskViewRenderer::TaskViewRenderer(uint32_t displayId){
+    _scrollY = 0;
+    _offsetX = 0;
+    _animationsEnabled = true;
+    _lineHeight = 8;
+    _invalid = true;
+    _colorDisplay = false;
+    _framesStat = StatsRegistry::counter("gui.frames");
+    _renderTimeStat = StatsRegistry::histogram("gui.render_us");
+    _compositor = chibiESP.getDisplayCompositor(displayId);
+    _displayDevice = chibiESP.getDisplayDevice(displayId);
     if(!_displayDevice){
-        Logger::error("View renderer: No available display device");
+        CESP_LOGE(LogModule::GUI, "View renderer: display device %d not available", displayId);
         _screenWidth = 0;
         _screenHeight = 0;
         return;
@@ -20,60 +52,205 @@ TaskViewRenderer::TaskViewRenderer(){
 
     DisplayDeviceInfo_t info;
     if(_displayDevice->get_device_info(info) < 0){
-        Logger::error("View renderer: Could not get device info");
+        CESP_LOGE(LogModule::GUI, "View renderer: Could not get device info");
         _screenWidth = 0;
         _screenHeight = 0;
         _displayDevice = nullptr;
+        _compositor = nullptr;
         return;
     } 
     _screenWidth = info.screenWidth;
     _screenHeight = info.screenHeight;
+    _colorDisplay = info.colorType == DisplayColorType::RGB;
+
+    //height of a text line, used to cull the items before measuring them
+    uint16_t width = 0, height = 0;
+    _displayDevice->getTextSize("A", 0, 0, 1, nullptr, nullptr, &width, &height);
+    if(height > 0) _lineHeight = height;
 }
 
-bool TaskViewRenderer::renderView(ViewRenderStruct &renderView){
+/**
+ * @brief draw a frame of the view
+ * @param newFrame true if the frame changed since the last call
+ * @param frameTime time of the frame in ms, drives the animations
+ * @details only the region of the screen that changed is drawn again, unless the view moved.
+ * The frame is sent to the screen by the display compositor, in its own task
+ */
+bool TaskViewRenderer::renderView(ViewRenderStruct &renderView, bool newFrame, uint32_t frameTime){
+    CESP_TRACE_SCOPE("render_view");
     if(_displayDevice == nullptr) return false;
-    if(renderView.elements.size() == 0) return true;
+    uint32_t start = micros();
+    bool changed;
+    if(_compositor == nullptr){
+        changed = drawFrame(renderView, newFrame, frameTime);
+        if(changed){
+            CESP_TRACE_SCOPE("display_update");
+            _displayDevice->updateScreen();
+        }
+    }else{
+        //another renderer may have drawn on the same display
+        if(!_compositor->beginFrame(this)) _invalid = true;
+        changed = drawFrame(renderView, newFrame, frameTime);
+        _compositor->endFrame(changed);
+    }
 
-    //get text offsets and size
-    for(int i = 0; i < renderView.elements.size(); i++){
-        ItemRenderStruct &item = renderView.elements[i];
-        _displayDevice->getTextSize(item.text, item.view_x, item.view_y, 1, &item.real_x, &item.real_y, &item.width, &item.height);
+    if(changed){
+        if(_framesStat) _framesStat->add();
+        if(_renderTimeStat) _renderTimeStat->record(micros() - start);
     }
-    
-    //for now hardcoded. TODO: should come from the device
-    int half_screen_size =  _screenHeight / 2;
-    int upperTextScreenPixel;
-    int firstElementOnScreen = 0;
-
-    //find out if the selected element can stay in the center
-    for(int i = renderView.focusedItemIndex-1; i >= 0; i--){
-        int upperTextScreenPixel = half_screen_size - renderView.elements[renderView.focusedItemIndex].height / 2 - 
-            (renderView.elements[renderView.focusedItemIndex].real_y - renderView.elements[i].real_y);
-        int lowerTextScreenPixel = upperTextScreenPixel + renderView.elements[renderView.focusedItemIndex].height;
-        if(upperTextScreenPixel < 0 && lowerTextScreenPixel < 0){ //done
-            firstElementOnScreen = i+1;
-            break;
-        }
+    return true;
+}
+
+/**
+ * @brief draw the changes of the view in the display buffer
+ * @return true if something was drawn
+ */
+bool TaskViewRenderer::drawFrame(ViewRenderStruct &renderView, bool newFrame, uint32_t frameTime){
+    //a view drawn from scratch starts already scrolled, otherwise the scroll moves smoothly to the focused item
+    int16_t target = getScrollTarget(renderView);
+    if(_invalid || !_animationsEnabled){
+        _scrollAnimation.stop(target);
+    }else if(target != _scrollAnimation.target()){
+        _scrollAnimation.start(_scrollY, target, frameTime, GUI_SCROLL_ANIMATION_MS);
     }
+    int16_t scroll = _scrollAnimation.value(frameTime);
+    int16_t offset = _slideAnimation.value(frameTime);
 
-    //draws the elements until done
-    int offsetY = renderView.elements[firstElementOnScreen].view_y;
+    //when the view moves every item moves: everything is drawn again
+    bool fullRedraw = _invalid || renderView.fullRedraw || scroll != _scrollY || offset != _offsetX;
+    if(!newFrame && !fullRedraw) return false;  //the screen is up to date
+    _scrollY = scroll;
+    _offsetX = offset;
 
-    _displayDevice->clearScreen();
-    for(int i = firstElementOnScreen; i < renderView.elements.size(); i++){
-        BW_Color bg_color = renderView.focusedItemIndex == i ? BW_Color::CESP_WHITE : BW_Color::CESP_BLACK;
-        BW_Color fg_color = renderView.focusedItemIndex == i ? BW_Color::CESP_BLACK : BW_Color::CESP_WHITE;
+    if(fullRedraw){
+        _displayDevice->clearScreen();
+        drawItems(renderView, 0, _screenHeight);
+    }else if(renderView.dirtyTop <= renderView.dirtyBottom){
+        //clear the lines that changed and draw again the items on them
+        int top = std::max(renderView.dirtyTop - _scrollY, 0);
+        int bottom = std::min(renderView.dirtyBottom + _lineHeight - _scrollY, (int)_screenHeight);
+        if(top >= bottom) return false;  //the changes are offscreen
+        clearLines(top, bottom);
+        drawItems(renderView, top, bottom);
+    }else{
+        return false;    //nothing visible changed
+    }
+    _invalid = false;
+    return true;
+}
+
+/**
+ * @brief slide the next view in
+ * @param direction 1 to enter from the right (a view was pushed), -1 to enter from the left (a view was popped)
+ */
+void TaskViewRenderer::startTransition(int direction){
+    _invalid = true;
+    if(!_animationsEnabled || direction == 0) return;
+    _slideAnimation.start(direction > 0 ? _screenWidth : -_screenWidth, 0, millis(), GUI_TRANSITION_ANIMATION_MS);
+}
 
-        int displayItemRectY = renderView.elements[i].real_y - offsetY;
-        if(displayItemRectY > _screenHeight){   //done drawing stuff
-            break;
+/**
+ * @brief true while the view is moving: frames must be drawn even if the view did not change
+ */
+bool TaskViewRenderer::isAnimating() const{
+    return _scrollAnimation.isRunning() || _slideAnimation.isRunning();
+}
+
+/**
+ * @brief enable or disable the animations. When disabled the view jumps to its final position
+ */
+void TaskViewRenderer::setAnimationsEnabled(bool enabled){
+    _animationsEnabled = enabled;
+    if(!enabled){
+        _scrollAnimation.stop(_scrollAnimation.target());
+        _slideAnimation.stop(0);
+    }
+}
+
+/**
+ * @brief the screen content is lost (another view was drawn): draw everything on the next frame
+ */
+void TaskViewRenderer::invalidate(){
+    _invalid = true;
+}
+
+/**
+ * @brief draw the items that intersect the screen lines between top (included) and bottom (excluded)
+ */
+void TaskViewRenderer::drawItems(ViewRenderStruct &renderView, int16_t top, int16_t bottom){
+    std::vector <ItemRenderStruct> &elements = renderView.elements;
+
+    //items are sorted by view_y: binary search for the first one that reaches the region
+    int16_t region_top = top + _scrollY;
+    auto first = std::partition_point(elements.begin(), elements.end(), [this, region_top](const ItemRenderStruct &item){
+        return item.view_y + _lineHeight <= region_top;
+    });
+
+    for(auto it = first; it != elements.end(); ++it){
+        ItemRenderStruct &item = *it;
+        int16_t screen_y = item.view_y - _scrollY;
+        if(screen_y >= bottom) break;  //done drawing stuff
+        int16_t screen_x = item.view_x + _offsetX;
+        if(screen_x >= _screenWidth || item.text.length() == 0) continue;    //offscreen or nothing to draw
+
+        //only the items on screen are measured
+        measureItem(item, 1);
+        if(screen_x + (int16_t)item.width <= 0) continue;   //slid out on the left
+
+        bool focused = renderView.focusedItemIndex == (it - elements.begin());
+        if(_colorDisplay){
+            RGB_Color bg_color = focused ? GUI_RGB_FOCUS_BACKGROUND : GUI_RGB_BACKGROUND;
+            RGB_Color fg_color = focused ? GUI_RGB_FOCUS_TEXT : GUI_RGB_TEXT;
+            _displayDevice->drawText(item.text.c_str(), screen_x, screen_y, 1, bg_color, fg_color);
+        }else{
+            BW_Color bg_color = focused ? BW_Color::CESP_WHITE : BW_Color::CESP_BLACK;
+            BW_Color fg_color = focused ? BW_Color::CESP_BLACK : BW_Color::CESP_WHITE;
+            _displayDevice->drawText(item.text.c_str(), screen_x, screen_y, 1, bg_color, fg_color);
         }
-        //Logger::info("%d, %d, %d, %d, %s", renderView.elements[i].view_x, renderView.elements[i].view_y - offsetY, 
-         //   renderView.elements[i].width,  renderView.elements[i].height, renderView.elements[i].text.c_str() );
-        _displayDevice->drawText(renderView.elements[i].text, 
-            renderView.elements[i].view_x, renderView.elements[i].view_y - offsetY, 
-            1, bg_color, fg_color);
     }
-    _displayDevice->updateScreen();
-    return true;
+}
+
+//fill the screen lines between top (included) and bottom (excluded) with the background
+void TaskViewRenderer::clearLines(int16_t top, int16_t bottom){
+    if(_colorDisplay){
+        _displayDevice->drawRect(0, top, _screenWidth, bottom - top, true, GUI_RGB_BACKGROUND);
+    }else{
+        _displayDevice->drawRect(0, top, _screenWidth, bottom - top, true, BW_Color::CESP_BLACK);
+    }
+}
+
+/**
+ * @brief get the vertical scroll offset in pixels that keeps the focused item in the center of the screen
+ * @details the offset is clamped so that the view never scrolls above its first item or below its last one
+ */
+int16_t TaskViewRenderer::getScrollTarget(const ViewRenderStruct &renderView) const{
+    const std::vector <ItemRenderStruct> &elements = renderView.elements;
+    if(renderView.focusedItemIndex < 0 || renderView.focusedItemIndex >= elements.size()) return 0;
+
+    int target = elements[renderView.focusedItemIndex].view_y + _lineHeight / 2 - _screenHeight / 2;
+    int max_scroll = elements.back().view_y + _lineHeight - _screenHeight;
+    if(target > max_scroll) target = max_scroll;
+    if(target < 0) target = 0;
+    return target;
+}
+
+/**
+ * @brief fill the real position and size of the item text, using the metrics cache when possible
+ */
+void TaskViewRenderer::measureItem(ItemRenderStruct &item, int16_t size){
+    uint32_t hash = item.text.hash();  //computed when the text was set
+    TextMetrics metrics;
+    if(!_metricsCache.get(hash, item.text.length(), size, metrics)){
+        _displayDevice->getTextSize(item.text.c_str(), item.view_x, item.view_y, size, &item.real_x, &item.real_y, &item.width, &item.height);
+        metrics.offset_x = item.real_x - item.view_x;
+        metrics.offset_y = item.real_y - item.view_y;
+        metrics.width = item.width;
+        metrics.height = item.height;
+        _metricsCache.put(hash, item.text.length(), size, metrics);
+        return;
+    }
+    item.real_x = item.view_x + metrics.offset_x;
+    item.real_y = item.view_y + metrics.offset_y;
+    item.width = metrics.width;
+    item.height = metrics.height;
 }
\ No newline at end of file
@@ -6,16 +6,48 @@
 #define TASK_VIEW_RENDERER_H
 
 #include "core/task/gui/view_render.h"
+#include "core/task/gui/text_metrics_cache.h"
+#include "core/task/gui/gui_animation.h"
 
 class DisplayDevice;
+class DisplayCompositor;
+class StatCounter;
+class StatHistogram;
 
 class TaskViewRenderer{
 public:
-    TaskViewRenderer();
-    bool renderView(ViewRenderStruct &renderView);
+    TaskViewRenderer(uint32_t displayId);
+    bool renderView(ViewRenderStruct &renderView, bool newFrame, uint32_t frameTime);
+    void invalidate();
+
+    //animations
+    void startTransition(int direction);
+    bool isAnimating() const;
+    void setAnimationsEnabled(bool enabled);
 private:
+    void measureItem(ItemRenderStruct &item, int16_t size);
+    void drawItems(ViewRenderStruct &renderView, int16_t top, int16_t bottom);
+    void clearLines(int16_t top, int16_t bottom);
+    bool drawFrame(ViewRenderStruct &renderView, bool newFrame, uint32_t frameTime);
+    int16_t getScrollTarget(const ViewRenderStruct &renderView) const;
+
     DisplayDevice *_displayDevice;
+    DisplayCompositor *_compositor;     //nullptr if the display has no compositor: the renderer draws directly
+    TextMetricsCache _metricsCache;
     uint16_t _screenWidth, _screenHeight;
+    uint16_t _lineHeight;
+    bool _colorDisplay;     //draw with RGB colors instead of black and white
+    int16_t _scrollY;   //vertical scroll offset of the view in pixels, as drawn on screen
+    int16_t _offsetX;   //horizontal offset of the view during a transition, as drawn on screen
+    bool _invalid;      //the screen content is unknown, the next frame is drawn from scratch
+
+    bool _animationsEnabled;
+    GuiAnimation _scrollAnimation;  //scroll towards the focused item
+    GuiAnimation _slideAnimation;   //view sliding in when it is pushed or popped
+
+    //statistics of all the renderers
+    StatCounter* _framesStat;           //frames drawn
+    StatHistogram* _renderTimeStat;     //microseconds to draw a frame
 
 };
 
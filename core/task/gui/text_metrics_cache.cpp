@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/task/gui/text_metrics_cache.h"
+
+TextMetricsCache::TextMetricsCache(){
+    clear();
+}
+
+void TextMetricsCache::clear(){
+    for(int i = 0; i < TEXT_METRICS_CACHE_SIZE; i++){
+        _entries[i].last_use = 0;
+    }
+    _useCounter = 0;
+}
+
+/**
+ * @brief look for the measurement of a text
+ * @return true if the text was found, false otherwise
+ */
+bool TextMetricsCache::get(uint32_t text_hash, uint16_t text_length, int16_t size, TextMetrics &metrics){
+    for(int i = 0; i < TEXT_METRICS_CACHE_SIZE; i++){
+        Entry &entry = _entries[i];
+        if(entry.last_use != 0 && entry.hash == text_hash && entry.length == text_length && entry.size == size){
+            entry.last_use = ++_useCounter;
+            metrics = entry.metrics;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief store the measurement of a text, replacing the least recently used entry if the cache is full
+ */
+void TextMetricsCache::put(uint32_t text_hash, uint16_t text_length, int16_t size, const TextMetrics &metrics){
+    int victim = 0;
+    for(int i = 0; i < TEXT_METRICS_CACHE_SIZE; i++){
+        if(_entries[i].last_use == 0){ //free entry
+            victim = i;
+            break;
+        }
+        if(_entries[i].last_use < _entries[victim].last_use) victim = i;
+    }
+
+    //use counter wrapped around: start again from an empty cache
+    if(_useCounter == UINT32_MAX) clear();
+
+    Entry &entry = _entries[victim];
+    entry.hash = text_hash;
+    entry.length = text_length;
+    entry.size = size;
+    entry.metrics = metrics;
+    entry.last_use = ++_useCounter;
+}
+
+//FNV-1a hash
+uint32_t TextMetricsCache::hashText(const char* text, size_t length){
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < length; i++){
+        hash ^= static_cast<uint8_t>(text[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
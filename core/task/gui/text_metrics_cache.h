@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef TEXT_METRICS_CACHE_H
+#define TEXT_METRICS_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace{
+    const int TEXT_METRICS_CACHE_SIZE = 32;
+};
+
+//size of a text on screen. Offsets are relative to the cursor position
+struct TextMetrics{
+    int16_t offset_x, offset_y;
+    uint16_t width, height;
+};
+
+/**
+ * @brief small LRU cache of text measurements, keyed by text size and text hash.
+ * @details Used by the renderer to avoid asking the display to measure the same strings every frame
+ */
+class TextMetricsCache{
+public:
+    TextMetricsCache();
+    bool get(uint32_t text_hash, uint16_t text_length, int16_t size, TextMetrics &metrics);
+    void put(uint32_t text_hash, uint16_t text_length, int16_t size, const TextMetrics &metrics);
+    void clear();
+
+    static uint32_t hashText(const char* text, size_t length);
+private:
+    struct Entry{
+        uint32_t hash;
+        uint16_t length;
+        int16_t size;
+        uint32_t last_use;  //0 means empty entry
+        TextMetrics metrics;
+    };
+
+    Entry _entries[TEXT_METRICS_CACHE_SIZE];
+    uint32_t _useCounter;
+};
+
+#endif //TEXT_METRICS_CACHE_H
@@ -4,6 +4,7 @@
 
 #include "core/task/gui/view.h"
 #include "core/task/gui/gui_element.h"
+#include "core/task/gui/gui_container.h"
 #include "core/task/gui/gui_event.h"
 #include "core/task/gui/view_error.h"
 #include "core/logging/logging.h"
@@ -11,14 +12,37 @@
 #include <mutex>
 #include <atomic>
 #include <string>
+#include <algorithm>
 
-View::View(){
+View::View(uint32_t displayId) :
+    _displayId(displayId),
+    _droppedEvents(0)
+{
     _requireViewUpdate = false;
     _selectedElement = -1;
-    _updateFrame = 0;
+    _selectableDirty = true;
+    _frontFrame = 0;
+    _readingFrame = -1;
+    _newFrameAvailable = false;
+    _layoutMetrics = {6, 8};    //5x7 font
+    for(int i = 0; i < 2; i++){
+        _drawFrame[i].focusedItemIndex = -1;
+        _drawFrame[i].fullRedraw = true;
+        _drawFrame[i].dirtyTop = 0;
+        _drawFrame[i].dirtyBottom = -1;
+    }
 }
 
 View::~View(){
+    //detach everything first, so that no container refers to deleted objects
+    for(GuiContainer* container : _containersById){
+        if(container) container->detachChildren();
+    }
+    for(GuiContainer* container : _containersById){
+        if(container) delete container;
+    }
+    _containersById.clear();
+
     for(int i = 0; i < _elements.size(); i++){
         delete _elements[i];
     }
@@ -30,12 +54,12 @@ View::~View(){
  * @return return ViewError::NO_ERROR if the text was added, an error otherwise
  */
 ViewError View::gui_list_add_text(const int elementId, const std::string &text){
-    int elementIndex = findElement(elementId);
-    if(elementIndex < 0) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
 
-    ViewError error = _elements[elementIndex]->add_text(text);
+    ViewError error = element->add_text(text);
     if(error != ViewError::NO_ERROR) return error;
-    _requireViewUpdate = true;
+    elementChanged(element);
     return ViewError::NO_ERROR;
 }
 
@@ -45,12 +69,12 @@ ViewError View::gui_list_add_text(const int elementId, const std::string &text){
  * @details this function works only for GENERIC and BUTTON gui element. You cannot change text of a LIST element
  */
 ViewError View::gui_set_text(const int elementId, const std::string &text){
-    int elementIndex = findElement(elementId);
-    if(elementIndex < 0) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
 
-    ViewError error = _elements[elementIndex]->setText(text);
+    ViewError error = element->setText(text);
     if(error != ViewError::NO_ERROR) return error;
-    _requireViewUpdate = true;
+    elementChanged(element);
     return ViewError::NO_ERROR;
 }
 
@@ -60,34 +84,39 @@ ViewError View::gui_set_text(const int elementId, const std::string &text){
  * @details LISTs can have no text
  */
 ViewError View::gui_get_Text(const int elementId, std::string &text) const{
-    int elementIndex = findElement(elementId);
-    if(elementIndex < 0) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
 
-    ViewError error = _elements[elementIndex]->getText(text);
+    ViewError error = element->getText(text);
     if(error != ViewError::NO_ERROR) return error;
     return ViewError::NO_ERROR;
 }
 
 ViewError View::gui_list_select_text_index(const int elementId, const int index){
-    int elementIndex = findElement(elementId);
-    if(elementIndex < 0) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
 
-    return _elements[elementIndex]->selectListTextIndex(index);
+    ViewError error = element->selectListTextIndex(index);
+    if(error != ViewError::NO_ERROR) return error;
+    elementChanged(element);
+    return ViewError::NO_ERROR;
 }
 
 ViewError View::gui_set_selectable(const int elementId, const bool selectable){
-    int elementIndex = findElement(elementId);
-    if(elementIndex < 0) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
-    _elements[elementIndex]->setSelectable(selectable);
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    element->setSelectable(selectable);
+    _selectableDirty = true;
+    _requireViewUpdate = true;
     return ViewError::NO_ERROR;
 }
 
 ViewError View::gui_get_position(const int elementId, int &view_x, int&view_y){
-    int elementIndex = findElement(elementId);
-    if(elementIndex < 0) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
 
-    view_x = _elements[elementIndex]->getX();
-    view_y = _elements[elementIndex]->getY();
+    view_x = element->getX();
+    view_y = element->getY();
     return ViewError::NO_ERROR;
 }
 
@@ -96,45 +125,84 @@ ViewError View::gui_get_position(const int elementId, int &view_x, int&view_y){
  * @param event a reference where the function will copy the new event
  * @return returns false if no event is present, true otherwise
  */
+bool View::getEvent(GuiEventData& event){
+    return _guiEvents.pop(event);
+}
+
+/**
+ * @brief get the type of the next gui event. The element that generated it is lost
+ * @return returns false if no event is present, true otherwise
+ */
 bool View::getEvent(GuiEvent& event){
-    if(_guiEvents.size() == 0) return false;
-    event = _guiEvents.front();
-    _guiEvents.pop_front();
+    GuiEventData data;
+    if(!_guiEvents.pop(data)) return false;
+    event = data.type;
     return true;
 }
 
-int View::pushGuiEvent(GuiEvent event){
+/**
+ * @brief number of gui events dropped because the task did not read them in time
+ */
+uint32_t View::getDroppedEventCount() const{
+    return _droppedEvents.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief call a function when the element generates an event, instead of queuing it for getEvent
+ * @param callback the function, called on the task thread. nullptr to queue the events again
+ * @param context user pointer passed to the callback
+ * @param eventMask events handled by the callback, e.g. guiEventMask(GuiEvent::BUTTON_RELEASED)
+ */
+ViewError View::gui_set_event_callback(const int elementId, GuiEventCallback callback, void* context, const uint8_t eventMask){
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+
+    element->setEventCallback(callback, context, eventMask);
+    return ViewError::NO_ERROR;
+}
 
-    if(_guiEvents.size() >= MAX_GUI_EVENT_COUNT) return -1;
-    _guiEvents.push_back(event);
+/**
+ * @brief dispatch an event to the callback of its element, or queue it if there is none
+ */
+int View::pushGuiEvent(GuiEvent event, int elementId){
+    GuiEventData data = {event, static_cast<int16_t>(elementId), static_cast<uint32_t>(millis())};
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element && element->dispatchEvent(data)) return 0;
+
+    if(!_guiEvents.push(data)){
+        _droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return -1;
+    }
     return 0;
 }
 
 
 //functions to create new gui elements
 ViewError View::create_generic_element(const int elementId, std::string text, const int view_x, const int view_y){
-    int elementIndex = findElement(elementId);
-    if(elementIndex >= 0) return ViewError::ITEM_ALREADY_EXISTS;    //element already exists
+    if(elementId < 0 || elementId >= MAX_GUI_ELEMENT_ID) return ViewError::INVALID_PARAM;
+    if(getElementById(elementId) != nullptr) return ViewError::ITEM_ALREADY_EXISTS;    //element already exists
 
     CESP_GuiElement *new_element = new CESP_GuiElement(elementId, Gui_ElementType::GENERIC, text, false, view_x, view_y);
     int new_idem_index = insertElementSorted(new_element);
 
     //update selected element index to accomodate new element
     if(new_idem_index <= _selectedElement && _selectedElement >= 0) _selectedElement++;
+    _selectableDirty = true;
     //if(_elements.size() == 1) _selectedElement = 0; //just to make sure _selectedElement is fine
     _requireViewUpdate = true;
     return ViewError::NO_ERROR;
 }
 
 ViewError View::create_button_element(const int elementId, std::string text, const int view_x, const int view_y){
-    int elementIndex = findElement(elementId);
-    if(elementIndex >= 0) return ViewError::ITEM_ALREADY_EXISTS;    //element already exists
+    if(elementId < 0 || elementId >= MAX_GUI_ELEMENT_ID) return ViewError::INVALID_PARAM;
+    if(getElementById(elementId) != nullptr) return ViewError::ITEM_ALREADY_EXISTS;    //element already exists
 
     CESP_GuiElement *new_element = new CESP_GuiElement(elementId, Gui_ElementType::BUTTON, text, true, view_x, view_y);
     int new_idem_index = insertElementSorted(new_element);
-    //Logger::info("New pos: %d", new_idem_index);
+    //CESP_LOGI(LogModule::GUI, "New pos: %d", new_idem_index);
     //update selected element index to accomodate new element
     if(new_idem_index <= _selectedElement && _selectedElement >= 0) _selectedElement++;
+    _selectableDirty = true;
     //if(_elements.size() == 1) _selectedElement = 0; //just to make sure _selectedElement is fine
     _requireViewUpdate = true;
     
@@ -142,43 +210,207 @@ ViewError View::create_button_element(const int elementId, std::string text, con
 }
 
 ViewError View::create_list_element(const int elementId, const int view_x, const int view_y){
-    int elementIndex = findElement(elementId);
-    if(elementIndex >= 0) return ViewError::ITEM_ALREADY_EXISTS;    //element already exists
+    if(elementId < 0 || elementId >= MAX_GUI_ELEMENT_ID) return ViewError::INVALID_PARAM;
+    if(getElementById(elementId) != nullptr) return ViewError::ITEM_ALREADY_EXISTS;    //element already exists
 
     CESP_GuiElement *new_element = new CESP_GuiElement(elementId, Gui_ElementType::LIST, true, view_x, view_y);
     int new_idem_index = insertElementSorted(new_element);
 
     //update selected element index to accomodate new element
     if(new_idem_index <= _selectedElement && _selectedElement >= 0) _selectedElement++;
+    _selectableDirty = true;
     //if(_elements.size() == 1) _selectedElement = 0; //just to make sure _selectedElement is fine
     _requireViewUpdate = true;
     return ViewError::NO_ERROR;
 }
 
 
-int View::insertElementSorted(CESP_GuiElement* element) {
-    auto it = _elements.begin();
-    while (it != _elements.end()) {
-        if ((*it)->getY() > element->getY()) break;
-        if ((*it)->getY() == element->getY() && (*it)->getX() > element->getX()) break;
-        ++it;
+/**
+ * @brief create a list whose items are provided by a data source
+ * @param visible_rows number of items shown on screen, starting from view_y
+ * @param row_height vertical distance in pixels between two items
+ * @details the list occupies the view from view_y to view_y + visible_rows*row_height: do not place other elements there.
+ * Only the visible items are requested to the data source and kept in memory
+ */
+ViewError View::create_virtual_list_element(const int elementId, const GuiListDataSource &source, const int visible_rows, const int row_height, const int view_x, const int view_y){
+    if(elementId < 0 || elementId >= MAX_GUI_ELEMENT_ID) return ViewError::INVALID_PARAM;
+    if(getElementById(elementId) != nullptr) return ViewError::ITEM_ALREADY_EXISTS;    //element already exists
+    if(source.getCount == nullptr || source.getItem == nullptr) return ViewError::INVALID_PARAM;
+    if(visible_rows <= 0 || visible_rows > 255 || row_height <= 0 || row_height > 255) return ViewError::INVALID_PARAM;
+
+    CESP_GuiElement *new_element = new CESP_GuiElement(elementId, source, visible_rows, row_height, view_x, view_y);
+    int new_idem_index = insertElementSorted(new_element);
+
+    //update selected element index to accomodate new element
+    if(new_idem_index <= _selectedElement && _selectedElement >= 0) _selectedElement++;
+    _selectableDirty = true;
+    _requireViewUpdate = true;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief reload the item count of a virtual list and discard its cached items. Call it when the list data changes
+ */
+ViewError View::gui_virtual_list_refresh(const int elementId){
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+
+    ViewError error = element->refreshVirtualList();
+    if(error != ViewError::NO_ERROR) return error;
+    elementChanged(element);
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief get the index of the item under the virtual list cursor
+ */
+ViewError View::gui_virtual_list_get_index(const int elementId, int &index) const{
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    if(element->_element_type != Gui_ElementType::VIRTUAL_LIST) return ViewError::FUNCTION_NOT_AVAILABLE;
+
+    index = element->getVirtualListIndex();
+    return ViewError::NO_ERROR;
+}
+
+ViewError View::gui_virtual_list_select_index(const int elementId, const int index){
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+
+    ViewError error = element->selectVirtualListIndex(index);
+    if(error != ViewError::NO_ERROR) return error;
+    _requireViewUpdate = true;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief create a container that places its children automatically
+ * @param parentContainerId container to add the new container to, -1 to create a top level container
+ * @param view_x, view_y position of top level containers in the view. Ignored for children containers
+ * @param spacing distance in pixels between the children
+ */
+ViewError View::create_container(const int containerId, const Gui_ContainerType type, const int parentContainerId, const int view_x, const int view_y, const int spacing){
+    if(containerId < 0 || containerId >= MAX_GUI_ELEMENT_ID) return ViewError::INVALID_PARAM;
+    if(getContainerById(containerId) != nullptr) return ViewError::ITEM_ALREADY_EXISTS;
+    GuiContainer* parent = nullptr;
+    if(parentContainerId >= 0){
+        parent = getContainerById(parentContainerId);
+        if(parent == nullptr) return ViewError::ITEM_NOT_AVAILABLE;
     }
+
+    GuiContainer* container = new GuiContainer(containerId, type, view_x, view_y, spacing);
+    if(containerId >= _containersById.size()) _containersById.resize(containerId + 1, nullptr);
+    _containersById[containerId] = container;
+    if(parent) parent->addChild(container);
+    _requireViewUpdate = true;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief delete a container. Its children are not deleted: they stay where they are
+ */
+ViewError View::gui_delete_container(const int containerId){
+    GuiContainer* container = getContainerById(containerId);
+    if(container == nullptr) return ViewError::ITEM_NOT_AVAILABLE;
+
+    _containersById[containerId] = nullptr;
+    delete container;
+    _requireViewUpdate = true;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief add an element at the end of a container. From now on the position of the element is set by the container
+ * @param containerId the container, -1 to remove the element from its container
+ */
+ViewError View::gui_set_container(const int elementId, const int containerId){
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;    //element not available
+    GuiContainer* container = nullptr;
+    if(containerId >= 0){
+        container = getContainerById(containerId);
+        if(container == nullptr) return ViewError::ITEM_NOT_AVAILABLE;
+    }
+
+    if(element->getContainer()) element->getContainer()->removeChild(element);
+    if(container) container->addChild(element);
+    _requireViewUpdate = true;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief select the child shown by a PAGES container
+ */
+ViewError View::gui_container_set_page(const int containerId, const int page){
+    GuiContainer* container = getContainerById(containerId);
+    if(container == nullptr) return ViewError::ITEM_NOT_AVAILABLE;
+    if(container->_type != Gui_ContainerType::PAGES) return ViewError::FUNCTION_NOT_AVAILABLE;
+    if(container->setActivePage(page) < 0) return ViewError::INVALID_PARAM;
+    _requireViewUpdate = true;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief set the height of a SCROLL_REGION container. Children outside of it are hidden
+ */
+ViewError View::gui_container_set_visible_height(const int containerId, const int height){
+    GuiContainer* container = getContainerById(containerId);
+    if(container == nullptr) return ViewError::ITEM_NOT_AVAILABLE;
+    if(container->_type != Gui_ContainerType::SCROLL_REGION) return ViewError::FUNCTION_NOT_AVAILABLE;
+    if(height < 0) return ViewError::INVALID_PARAM;
+    container->setVisibleHeight(height);
+    _requireViewUpdate = true;
+    return ViewError::NO_ERROR;
+}
+
+/**
+ * @brief set the size of a character, used by containers to compute the size of the elements
+ */
+void View::set_layout_metrics(const GuiLayoutMetrics &metrics){
+    _layoutMetrics = metrics;
+    for(GuiContainer* container : _containersById){
+        if(container) container->markLayoutDirty();
+    }
+    _requireViewUpdate = true;
+}
+
+//true if element a comes before element b in the view (sorted by y, then by x)
+static bool elementPositionLess(const CESP_GuiElement* a, const CESP_GuiElement* b){
+    if(a->getY() != b->getY()) return a->getY() < b->getY();
+    return a->getX() < b->getX();
+}
+
+/**
+ * @brief insert the element in the position sorted list and in the id table
+ * @return the index of the element in the sorted list
+ */
+int View::insertElementSorted(CESP_GuiElement* element) {
+    //after the elements with the same position
+    auto it = std::upper_bound(_elements.begin(), _elements.end(), element, elementPositionLess);
     int index = it - _elements.begin();
     _elements.insert(it, element);
+
+    if(element->_id >= _elementsById.size()) _elementsById.resize(element->_id + 1, nullptr);
+    _elementsById[element->_id] = element;
     return index;
 }
 
 
 //function to delete and element
 ViewError View::gui_delete_element(const int elementId){
-    int elementIndex = findElement(elementId);
-    if(elementIndex < 0) return ViewError::ITEM_NOT_AVAILABLE;
+    CESP_GuiElement* element = getElementById(elementId);
+    if(element == nullptr) return ViewError::ITEM_NOT_AVAILABLE;
+    int elementIndex = findElementIndex(element);
+    if(element->getContainer()) element->getContainer()->removeChild(element);
 
     //delete the element
-    delete _elements[elementIndex];
+    _elementsById[elementId] = nullptr;
     _elements.erase(_elements.begin() + elementIndex);
+    delete element;
 
-    //the selected element index remains the same. The only case where is changed is if it goes out of range
+    //the selected element stays the same if it was after the deleted one. Otherwise the index remains the same, unless it goes out of range
+    if(elementIndex < _selectedElement) _selectedElement--;
+    _selectableDirty = true;
     if(_elements.size() == 0){
         _selectedElement = -1;
     }else if(_selectedElement >= _elements.size()){
@@ -206,7 +438,13 @@ void View::_gui_navigation_down(const int step){
         CESP_GuiElement *selected_element = _elements[_selectedElement];
         if(selected_element->_element_type == Gui_ElementType::LIST){
             if(gui_list_decrement_text_index(selected_element, step) == 0){
-                _requireViewUpdate = true;
+                elementChanged(selected_element);
+                pushGuiEvent(GuiEvent::LIST_CHANGED, selected_element->_id);
+            }
+        }else if(selected_element->_element_type == Gui_ElementType::VIRTUAL_LIST){
+            if(selected_element->moveVirtualListCursor(-step) == 0){
+                elementChanged(selected_element);
+                pushGuiEvent(GuiEvent::LIST_CHANGED, selected_element->_id);
             }
         }
         return;
@@ -217,22 +455,11 @@ void View::_gui_navigation_down(const int step){
         return;
     }
 
-    int16_t new_selected = _selectedElement;
-    for(int i = 0; i < step; i++){
-        new_selected--;
-        if(new_selected < 0) new_selected =  _elements.size() - 1;
-        if(new_selected == _selectedElement){   //did a full round
-            if(i == 0){  //there is nothing selectable
-                new_selected = -1;
-                break;
-            }
-        }
-        if(!_elements[new_selected]->isSelectable()) i--;
-    }
-    _selectedElement = new_selected;
+    _selectedElement = stepSelection(-step);
+    if(_selectedElement >= 0) elementChanged(_elements[_selectedElement]);   //scroll regions follow the focus
 
     //generate a gui event for the new element
-    pushGuiEvent(GuiEvent::CHANGED_FOCUS);
+    pushGuiEvent(GuiEvent::CHANGED_FOCUS, _selectedElement >= 0 ? _elements[_selectedElement]->_id : -1);
     _requireViewUpdate = true;  //trigger a view update
 }
 
@@ -242,7 +469,13 @@ void View::_gui_navigation_up(const int step){
         CESP_GuiElement *selected_element = _elements[_selectedElement];
         if(selected_element->_element_type == Gui_ElementType::LIST){
             if(gui_list_increment_text_index(selected_element, step) == 0){
-                _requireViewUpdate = true;
+                elementChanged(selected_element);
+                pushGuiEvent(GuiEvent::LIST_CHANGED, selected_element->_id);
+            }
+        }else if(selected_element->_element_type == Gui_ElementType::VIRTUAL_LIST){
+            if(selected_element->moveVirtualListCursor(step) == 0){
+                elementChanged(selected_element);
+                pushGuiEvent(GuiEvent::LIST_CHANGED, selected_element->_id);
             }
         }
         return;
@@ -253,22 +486,11 @@ void View::_gui_navigation_up(const int step){
         return;
     }
 
-    int16_t new_selected = _selectedElement;
-    for(int i = 0; i < step; i++){
-        new_selected++;
-        if(new_selected >= _elements.size()) new_selected = 0;
-        if(new_selected == _selectedElement){   //did a full round
-            if(i == 0){  //there is nothing selectable
-                new_selected = -1;
-                break;
-            }
-        }
-        if(!_elements[new_selected]->isSelectable()) i--;
-    }
-    _selectedElement = new_selected;
+    _selectedElement = stepSelection(step);
+    if(_selectedElement >= 0) elementChanged(_elements[_selectedElement]);   //scroll regions follow the focus
 
     //generate a gui event for the new element
-    pushGuiEvent(GuiEvent::CHANGED_FOCUS);
+    pushGuiEvent(GuiEvent::CHANGED_FOCUS, _selectedElement >= 0 ? _elements[_selectedElement]->_id : -1);
     _requireViewUpdate = true;  //trigger a view update
 }
 
@@ -281,14 +503,15 @@ void View::_gui_navigation_release(){
     CESP_GuiElement *selected_element = _elements[_selectedElement];
     
     if(selected_element->_element_type == Gui_ElementType::BUTTON){
-        pushGuiEvent(GuiEvent::BUTTON_RELEASED);
+        pushGuiEvent(GuiEvent::BUTTON_RELEASED, selected_element->_id);
         return;
-    }else if (selected_element->_element_type == Gui_ElementType::LIST){
+    }else if (selected_element->_element_type == Gui_ElementType::LIST ||
+        selected_element->_element_type == Gui_ElementType::VIRTUAL_LIST){
         selected_element->_active = !selected_element->_active;
         if(selected_element->_active){
-            pushGuiEvent(GuiEvent::LIST_FOCUS_START);
+            pushGuiEvent(GuiEvent::LIST_FOCUS_START, selected_element->_id);
         }else{
-            pushGuiEvent(GuiEvent::LIST_FOCUS_END);
+            pushGuiEvent(GuiEvent::LIST_FOCUS_END, selected_element->_id);
         }
         _requireViewUpdate = true;  //trigger a view update
     }
@@ -304,7 +527,7 @@ void View::_gui_navigation_press(){
     CESP_GuiElement *selected_element = _elements[_selectedElement];
     
     if(selected_element->_element_type == Gui_ElementType::BUTTON){
-        pushGuiEvent(GuiEvent::BUTTON_PRESSED);
+        pushGuiEvent(GuiEvent::BUTTON_PRESSED, selected_element->_id);
         return;
     }
 }
@@ -319,52 +542,267 @@ ViewError View::gui_get_selected_element(int &item){
     return ViewError::NO_ERROR;
 }
 
-int View::findElement(const int elementId) const{
-    for(int index = 0; index < _elements.size(); index++){
-        CESP_GuiElement* element = _elements[index];
-        if(element->_id == elementId){
-            return index;
-        }
+/**
+ * @brief get an element from its id in constant time
+ * @return nullptr if the element does not exist
+ */
+CESP_GuiElement* View::getElementById(const int elementId) const{
+    if(elementId < 0 || elementId >= _elementsById.size()) return nullptr;
+    return _elementsById[elementId];
+}
+
+/**
+ * @brief get the index of an element in the position sorted list with a binary search
+ * @return -1 if the element is not in the list
+ */
+int View::findElementIndex(const CESP_GuiElement* element) const{
+    auto it = std::lower_bound(_elements.begin(), _elements.end(), element, elementPositionLess);
+    for(; it != _elements.end() && !elementPositionLess(element, *it); ++it){
+        if(*it == element) return it - _elements.begin();
     }
     return -1;
 }
 
 /**
- * @brief updates the view render data
- * @return true if the render data was updated, false if nothing changed
+ * @brief move the selection by a number of selectable elements
+ * @param step positive to move forward in the element list, negative to move backward. Wraps around
+ * @return the index of the new selected element, -1 if nothing is selectable
+ * @details the selectable elements are kept in a sorted array of indexes, rebuilt only when elements
+ * are added, removed, moved or change selectability: a step of any size is a single modular computation
+ */
+int View::stepSelection(const int step){
+    if(_selectableDirty){
+        _selectableIndexes.clear();
+        for(int i = 0; i < _elements.size(); i++){
+            if(_elements[i]->isSelectable()) _selectableIndexes.push_back(i);
+        }
+        _selectableDirty = false;
+    }
+
+    int count = _selectableIndexes.size();
+    if(count == 0) return -1;
+
+    //position of the selected element, or of the first selectable element after it
+    int position = std::lower_bound(_selectableIndexes.begin(), _selectableIndexes.end(), _selectedElement) - _selectableIndexes.begin();
+    bool selectable = position < count && _selectableIndexes[position] == _selectedElement;
+
+    //moving forward from a non selectable element, the first step lands on the next selectable one
+    int target = position + step;
+    if(step > 0 && !selectable) target--;
+    target %= count;
+    if(target < 0) target += count;
+    return _selectableIndexes[target];
+}
+
+GuiContainer* View::getContainerById(const int containerId) const{
+    if(containerId < 0 || containerId >= _containersById.size()) return nullptr;
+    return _containersById[containerId];
+}
+
+/**
+ * @brief the content of an element changed: its container may need a new layout
+ */
+void View::elementChanged(CESP_GuiElement* element){
+    if(element->getContainer()) element->getContainer()->markLayoutDirty();
+    _requireViewUpdate = true;
+}
+
+/**
+ * @brief layout pass: measure and place the dirty containers, then sort again the elements that moved
+ */
+void View::updateLayout(){
+    GuiLayoutContext context;
+    context.metrics = _layoutMetrics;
+    context.focused = _selectedElement >= 0 ? _elements[_selectedElement] : nullptr;
+    context.moved = false;
+
+    for(GuiContainer* container : _containersById){
+        if(container == nullptr || container->getParent() != nullptr || !container->isLayoutDirty()) continue;
+        container->measure(_layoutMetrics);
+        container->place(container->getX(), container->getY(), Gui_Visibility::VISIBLE, context);
+    }
+    //elements removed from a container are shown again where they were
+    for(CESP_GuiElement* element : _elements){
+        if(element->getContainer() == nullptr && element->setVisibility(Gui_Visibility::VISIBLE)) context.moved = true;
+    }
+    if(!context.moved) return;
+    _selectableDirty = true;    //indexes or visibility changed
+
+    //insertion sort: after a layout pass the elements are almost sorted
+    CESP_GuiElement* selected = _selectedElement >= 0 ? _elements[_selectedElement] : nullptr;
+    for(int i = 1; i < _elements.size(); i++){
+        CESP_GuiElement* element = _elements[i];
+        int j = i - 1;
+        while(j >= 0 && elementPositionLess(element, _elements[j])){
+            _elements[j + 1] = _elements[j];
+            j--;
+        }
+        _elements[j + 1] = element;
+    }
+    if(selected) _selectedElement = findElementIndex(selected);
+
+    //the focused element was hidden with its page: the focus moves to the next selectable element
+    if(selected && selected->isHidden()){
+        if(selected->_active){
+            selected->_active = false;
+            pushGuiEvent(GuiEvent::LIST_FOCUS_END, selected->_id);
+        }
+        _selectedElement = stepSelection(1);
+        pushGuiEvent(GuiEvent::CHANGED_FOCUS, _selectedElement >= 0 ? _elements[_selectedElement]->_id : -1);
+        if(_selectedElement >= 0){
+            elementChanged(_elements[_selectedElement]);
+            updateLayout();     //scroll regions follow the focus. The new element is visible, so this runs once
+        }
+    }
+}
+
+//two render items look the same on screen
+static bool sameRenderItem(const ItemRenderStruct &a, bool a_focused, const ItemRenderStruct &b, bool b_focused){
+    return a_focused == b_focused && a.view_x == b.view_x && a.view_y == b.view_y && a.text == b.text;
+}
+
+/**
+ * @brief compute the vertical range of the items that changed between the published frame and the new one
+ * @details the items are sorted by view_y: everything between the first and the last different item is dirty
+ */
+void View::computeDirtyRegion(ViewRenderStruct &newFrame, const ViewRenderStruct &oldFrame){
+    const std::vector <ItemRenderStruct> &new_items = newFrame.elements;
+    const std::vector <ItemRenderStruct> &old_items = oldFrame.elements;
+    int new_count = new_items.size(), old_count = old_items.size();
+
+    //common items at the beginning
+    int first = 0;
+    while(first < new_count && first < old_count &&
+        sameRenderItem(new_items[first], first == newFrame.focusedItemIndex, old_items[first], first == oldFrame.focusedItemIndex)){
+        first++;
+    }
+
+    newFrame.dirtyTop = 0;
+    newFrame.dirtyBottom = -1;
+    if(first == new_count && first == old_count) return;    //nothing changed
+
+    //common items at the end
+    int last = 0;
+    while(last < new_count - first && last < old_count - first &&
+        sameRenderItem(new_items[new_count - 1 - last], new_count - 1 - last == newFrame.focusedItemIndex,
+            old_items[old_count - 1 - last], old_count - 1 - last == oldFrame.focusedItemIndex)){
+        last++;
+    }
+
+    int top = INT16_MAX, bottom = INT16_MIN;
+    if(first < new_count - last){
+        top = std::min<int>(top, new_items[first].view_y);
+        bottom = std::max<int>(bottom, new_items[new_count - 1 - last].view_y);
+    }
+    if(first < old_count - last){
+        top = std::min<int>(top, old_items[first].view_y);
+        bottom = std::max<int>(bottom, old_items[old_count - 1 - last].view_y);
+    }
+    newFrame.dirtyTop = top;
+    newFrame.dirtyBottom = bottom;
+}
+
+/**
+ * @brief publish the current state of the view for the renderer
+ * @return true if a new frame was published, false if nothing changed or the renderer is still using the frame to update
+ * @details runs in the task thread. The frame not published is rebuilt in place: once its vector has grown to the
+ * number of elements no memory is allocated. The renderer only reads the published frame, so no lock is held while building it
  */
-bool View::update_render_view(){
+bool View::publish_render_view(){
     if(!_requireViewUpdate) return false; //nothing to update
 
-    //std::lock_guard <std::mutex> lock(_drawMutex);
-    ViewRenderStruct &updateFrame =  _drawFrame[_updateFrame];
-    updateFrame.elements.clear();
-    updateFrame.focusedItemIndex = _selectedElement;
-
-    for(auto& item : _elements){
-        ItemRenderStruct render_item;
-        render_item.height = 0;
-        render_item.real_x = 0;
-        render_item.real_y = 0;
-        render_item.text = "";
-        render_item.width = 0;
-        render_item.view_x = item->getX();
-        render_item.view_y = item->getY();
-        item->getText(render_item.text);
-        updateFrame.elements.push_back(render_item);
+    uint8_t backFrame;
+    {
+        std::lock_guard <std::mutex> lock(_drawMutex);
+        backFrame = 1 - _frontFrame;
+        if(_readingFrame == backFrame) return false;    //the renderer still has it, retry on the next update
+    }
+
+    updateLayout();
+
+    //virtual lists are expanded in one render item for each visible row
+    int itemCount = 0;
+    for(int i = 0; i < _elements.size(); i++){
+        CESP_GuiElement* item = _elements[i];
+        if(!item->isVisible()) continue;
+        itemCount += item->_element_type == Gui_ElementType::VIRTUAL_LIST ? item->getVirtualListRowCount() : 1;
+    }
+
+    ViewRenderStruct &updateFrame = _drawFrame[backFrame];
+    updateFrame.elements.resize(itemCount);
+    updateFrame.focusedItemIndex = -1;
+
+    int renderIndex = 0;
+    for(int i = 0; i < _elements.size(); i++){
+        CESP_GuiElement* item = _elements[i];
+        if(!item->isVisible()) continue;   //hidden by its container
+
+        if(item->_element_type == Gui_ElementType::VIRTUAL_LIST){
+            uint8_t rows = item->getVirtualListRowCount();
+            if(i == _selectedElement && rows > 0) updateFrame.focusedItemIndex = renderIndex + item->getVirtualListCursorRow();
+            for(uint8_t row = 0; row < rows; row++){
+                fillRenderItem(updateFrame.elements[renderIndex++], item->getX(), item->getY() + row * item->getRowHeight(),
+                    item->getVirtualListRow(row));
+            }
+            continue;
+        }
+
+        if(i == _selectedElement) updateFrame.focusedItemIndex = renderIndex;
+        fillRenderItem(updateFrame.elements[renderIndex++], item->getX(), item->getY(), item->getDisplayText());
+    }
+
+    //only the items that changed must be drawn again. The published frame is not modified, only read
+    ViewRenderStruct &frontFrame = _drawFrame[1 - backFrame];
+    computeDirtyRegion(updateFrame, frontFrame);
+    updateFrame.fullRedraw = false;
+
+    {
+        std::lock_guard <std::mutex> lock(_drawMutex);
+        //the renderer did not get the previous frame: its changes must be drawn too
+        if(_newFrameAvailable){
+            updateFrame.fullRedraw = frontFrame.fullRedraw;
+            if(frontFrame.dirtyTop <= frontFrame.dirtyBottom){
+                if(updateFrame.dirtyTop > updateFrame.dirtyBottom){
+                    updateFrame.dirtyTop = frontFrame.dirtyTop;
+                    updateFrame.dirtyBottom = frontFrame.dirtyBottom;
+                }else{
+                    updateFrame.dirtyTop = std::min(updateFrame.dirtyTop, frontFrame.dirtyTop);
+                    updateFrame.dirtyBottom = std::max(updateFrame.dirtyBottom, frontFrame.dirtyBottom);
+                }
+            }
+        }
+        _frontFrame = backFrame;
+        _newFrameAvailable = true;
     }
     _requireViewUpdate = false;
     return true;
 }
 
+void View::fillRenderItem(ItemRenderStruct &render_item, int view_x, int view_y, const GuiText* text){
+    render_item.height = 0;
+    render_item.real_x = 0;
+    render_item.real_y = 0;
+    render_item.width = 0;
+    render_item.view_x = view_x;
+    render_item.view_y = view_y;
+    if(text) render_item.text = *text;
+    else render_item.text.assign("", 0);
+}
+
 /**
- * @brief get the render data from the view
- * @details 
+ * @brief get the last published render data. Must be released with release_render_view() when done
+ * @param newFrame set to true if the frame changed since the last acquire
+ * @return the render data. It's not modified by the view until released
  */
-bool View::get_render_view(ViewRenderStruct &renderView){
-    if(update_render_view()){
-        _updateFrame = 1 - _updateFrame;    //exchange the frames        
-    }
-    renderView = _drawFrame [1 - _updateFrame]; //get current drawable frame
-    return true;
-}
\ No newline at end of file
+ViewRenderStruct* View::acquire_render_view(bool &newFrame){
+    std::lock_guard <std::mutex> lock(_drawMutex);
+    _readingFrame = _frontFrame;
+    newFrame = _newFrameAvailable;
+    _newFrameAvailable = false;
+    return &_drawFrame[_frontFrame];
+}
+
+void View::release_render_view(){
+    std::lock_guard <std::mutex> lock(_drawMutex);
+    _readingFrame = -1;
+}
@@ -7,17 +7,19 @@
 
 #include "core/task/gui/gui_event.h"
 #include "core/task/gui/gui_element.h"
+#include "core/task/gui/gui_container.h"
 #include "core/task/gui/view_error.h"
 #include "core/task/gui/view_render.h"
+#include "core/structs/spsc_ring.h"
 
 #include <string>
 #include <vector>
-#include <deque>
 #include <mutex>
 #include <atomic>
 
 namespace{
-    const int MAX_GUI_EVENT_COUNT = 10;
+    const int MAX_GUI_EVENT_COUNT = 16;    //must be a power of two
+    const int MAX_GUI_ELEMENT_ID = 1024;    //element ids index a table, keep them small
 };
 
 /**
@@ -25,9 +27,11 @@ namespace{
  */
 class View{
 public:
-    View();
+    View(uint32_t displayId);
     ~View();
 
+    uint32_t getDisplayId() const {return _displayId;}
+
     //functions to update gui element state
     ViewError gui_list_add_text(const int elementId, const std::string &text);
     ViewError gui_set_text(const int elementId, const std::string &text);
@@ -37,19 +41,39 @@ public:
     ViewError gui_get_position(const int elementId, int &view_x, int& view_y);
 
     //functions to get gui events
+    bool getEvent(GuiEventData& event);
     bool getEvent(GuiEvent& event);
+    uint32_t getDroppedEventCount() const;
+    ViewError gui_set_event_callback(const int elementId, GuiEventCallback callback, void* context, const uint8_t eventMask = GUI_EVENT_MASK_ALL);
 
     //functions to create new gui elements
     ViewError create_generic_element(const int elementId, std::string text, const int view_x, const int view_y);
     ViewError create_button_element(const int elementId, std::string text, const int view_x, const int view_y);
     ViewError create_list_element(const int elementId, const int view_x, const int view_y);
+    ViewError create_virtual_list_element(const int elementId, const GuiListDataSource &source, const int visible_rows, const int row_height, const int view_x, const int view_y);
+
+    //virtual list functions
+    ViewError gui_virtual_list_refresh(const int elementId);
+    ViewError gui_virtual_list_get_index(const int elementId, int &index) const;
+    ViewError gui_virtual_list_select_index(const int elementId, const int index);
+
+    //containers: they place the elements automatically
+    ViewError create_container(const int containerId, const Gui_ContainerType type, const int parentContainerId, const int view_x, const int view_y, const int spacing);
+    ViewError gui_delete_container(const int containerId);
+    ViewError gui_set_container(const int elementId, const int containerId);
+    ViewError gui_container_set_page(const int containerId, const int page);
+    ViewError gui_container_set_visible_height(const int containerId, const int height);
+    void set_layout_metrics(const GuiLayoutMetrics &metrics);
 
     //function to delete and element
     ViewError gui_delete_element(const int elementId);
 
     ViewError gui_get_selected_element(int &item);
 
-    bool get_render_view(ViewRenderStruct &renderView);
+    //render data exchange between the task and the renderer
+    bool publish_render_view();
+    ViewRenderStruct* acquire_render_view(bool &newFrame);
+    void release_render_view();
 
     //INTERNAL USE ONLY
     //navigation functions: they run in the same thread of the user task
@@ -63,28 +87,44 @@ private:
     int gui_list_decrement_text_index(CESP_GuiElement* element, const int step);
 
     //gui event stack functions
-    int pushGuiEvent(GuiEvent);
+    int pushGuiEvent(GuiEvent event, int elementId);
 
     //some view private functions
-    bool update_render_view();
-    int findElement(const int elementId) const;
+    CESP_GuiElement* getElementById(const int elementId) const;
+    int findElementIndex(const CESP_GuiElement* element) const;
     int insertElementSorted(CESP_GuiElement* element);
+    void fillRenderItem(ItemRenderStruct &render_item, int view_x, int view_y, const GuiText* text);
+    int stepSelection(const int step);
+    GuiContainer* getContainerById(const int containerId) const;
+    void elementChanged(CESP_GuiElement* element);
+    void updateLayout();
+    void computeDirtyRegion(ViewRenderStruct &newFrame, const ViewRenderStruct &oldFrame);
 
     //private variables
+    const uint32_t _displayId;  //display the view is drawn on
     bool _requireViewUpdate;
     int _selectedElement;
 
     //element vector sorted by position on the view
     std::vector <CESP_GuiElement*> _elements;
-    std::mutex _elementsMutex;
+    std::vector <CESP_GuiElement*> _elementsById;   //indexed by element id, nullptr if the id is free
+    std::vector <uint16_t> _selectableIndexes;  //indexes in _elements of the selectable elements, sorted
+    bool _selectableDirty;  //_selectableIndexes must be rebuilt
+
+    //containers, indexed by container id
+    std::vector <GuiContainer*> _containersById;
+    GuiLayoutMetrics _layoutMetrics;
 
-    //gui event queue
-    std::deque <GuiEvent> _guiEvents;
+    //gui event queue: written by the navigation functions, read by the task
+    SpscRing <GuiEventData, MAX_GUI_EVENT_COUNT> _guiEvents;
+    std::atomic <uint32_t> _droppedEvents;  //events lost because the queue was full
 
-    //stuff to draw
+    //stuff to draw: one frame is published for the renderer, the other is rebuilt by the task
     ViewRenderStruct _drawFrame[2];
-    std::atomic <uint8_t> _updateFrame;
-    std::mutex _drawMutex;
+    uint8_t _frontFrame;    //published frame
+    int8_t _readingFrame;   //frame held by the renderer, -1 if none
+    bool _newFrameAvailable;
+    std::mutex _drawMutex;  //protects the three variables above
 };
 
 #endif //VIEW_H
\ No newline at end of file
@@ -5,11 +5,13 @@
 #ifndef VIEW_RENDER_H
 #define VIEW_RENDER_H
 
-#include <string>
+#include "core/task/gui/gui_text.h"
+
+#include <stdint.h>
 #include <vector>
 
 struct ItemRenderStruct{
-    std::string text;   //text to display
+    GuiText text;   //text to display
     int16_t view_x, view_y; //position of the item in the view
     int16_t real_x, real_y;
     uint16_t width, height;
@@ -18,6 +20,10 @@ struct ItemRenderStruct{
 struct ViewRenderStruct{
     std::vector <ItemRenderStruct> elements;    //list of items to be displayed
     int focusedItemIndex;    //index of the focused item
+
+    //region to draw again, in view coordinates: items with view_y between dirtyTop and dirtyBottom changed
+    bool fullRedraw;
+    int16_t dirtyTop, dirtyBottom;  //empty if dirtyTop > dirtyBottom
 };
 
 #endif  //VIEW_RENDER_H
\ No newline at end of file
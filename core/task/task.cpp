@@ -8,6 +8,7 @@
 #include "core/kernel/components/input_manager.h"
 #include "core/task/task_interface.h"
 #include "core/kernel/chibi_kernel.h"
+#include "core/tracing/tracer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -29,10 +30,13 @@ CESP_Task::CESP_Task(ChibiKernel* kernelObj, const int kernelCoreId, const int u
     _taskStatus.terminationRequest = false;
     _taskStatus.user_task_terminated = false;
     _taskStatus.task_user_function_start_time = 0; // Initialize user function start time
+    _taskStatus.loop_count = 0;
+    _taskStatus.monitorLoopHandle = nullptr;
+    _taskStatus.userLoopHandle = nullptr;
 }
 
 CESP_Task::~CESP_Task(){
-    Logger::info("Deleted task");
+    CESP_LOGI(LogModule::TASK, "Deleted task");
     delay(1000);
     if(_taskInterface) delete _taskInterface;
 }
@@ -90,8 +94,12 @@ void CESP_Task::user_task_function(void *args){
     // Call user-defined loop function
     if (taskInfo.user_def_loop) {
         while(!taskStatus.quitRequest) {    //quit request is handled by the user mode loop
-            taskInfo.user_def_loop(userTaskData);
+            {
+                CESP_TRACE_SCOPE("user_loop");
+                taskInfo.user_def_loop(userTaskData);
+            }
             taskStatus.task_user_function_start_time = millis(); // Update the start time of the user function
+            taskStatus.loop_count.fetch_add(1, std::memory_order_relaxed);
             userTaskData.taskInterface._updateInterface();
         }
     }
@@ -149,5 +157,7 @@ CESP_TaskInfo_t CESP_Task::getInfo() const{
     info.status = _taskStatus.task_status.load(); // Use atomic load for thread safety
     info.taskID = _taskInfo.task_id;
     info.task_alive_time = millis() - _taskStatus.task_start_time; // Calculate alive time in milliseconds
+    info.loop_count = _taskStatus.loop_count.load(std::memory_order_relaxed);
+    info.cpu_time = 0; // filled by the task manager, that reads the run time of all the tasks at once
     return info;
 }
@@ -34,6 +34,8 @@ struct CESP_TaskInfo_t{
     CESP_TaskStatus status;
     uint32_t taskID; // ID of the task
     uint32_t task_alive_time; // Time the task has been alive in milliseconds
+    uint32_t loop_count; // Iterations of the user loop
+    uint32_t cpu_time; // Run time of the user loop task in FreeRTOS run time stats units (microseconds by default), 0 if run time stats are disabled
 };
 
 /**
@@ -50,6 +52,7 @@ public:
         const void (*user_def_closeup)(CESP_UserTaskData& data));
     ~CESP_Task();
     CESP_TaskInfo_t getInfo() const; // Get task information
+    TaskHandle_t getUserTaskHandle() const { return _taskStatus.userLoopHandle; }
 
     void start_task(); // Start the task
     void user_task_function(void *args); // Task loop function
@@ -96,6 +99,7 @@ struct InternalTaskStatus_t{
     std::atomic <bool> terminationRequest; // Flag for task forced termination request
     std::atomic <bool> quitRequest; // Flag for task graceful quit request
     std::atomic <bool> user_task_terminated; // Flag for task termination
+    std::atomic <uint32_t> loop_count; // Iterations of the user loop
     TaskHandle_t monitorLoopHandle; // Handle for the task monitor loop
     TaskHandle_t userLoopHandle;    // Handle for the user 
 }_taskStatus;
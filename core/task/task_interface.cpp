@@ -7,8 +7,15 @@
 #include "core/task/gui/view_render.h"
 #include "core/task/gui/view.h"
 #include "core/task/gui/task_view_renderer.h"
+#include "core/tracing/tracer.h"
 #include "chibiESP.h"
 
+namespace{
+    //time between two frames in ms. Animations need a faster frame clock to look smooth
+    const uint32_t RENDER_PERIOD_MS = 100;
+    const uint32_t ANIMATION_FRAME_PERIOD_MS = 33;
+};
+
 TaskInterface::TaskInterface(bool enableGraphics, InputListener *listener) : 
 _enableGraphics(enableGraphics)
 {
@@ -16,7 +23,6 @@ _enableGraphics(enableGraphics)
     _deleteCurrentView = false;
 
     inputInit(listener);
-    _viewRenderer = new TaskViewRenderer();
     _upNavEvent = chibiESP.getNavUpEvent();
     _downNavEvent = chibiESP.getNavDownEvent();
     _selectNavEvent = chibiESP.getNavSelectEvent();
@@ -32,7 +38,10 @@ TaskInterface::~TaskInterface() { // Destructor
         delete _views[i];
     }
     _views.clear();
-    delete _viewRenderer;
+    for(auto &renderer : _viewRenderers){
+        delete renderer.second;
+    }
+    _viewRenderers.clear();
 }
 
 // Initialize the interface with a listener and ID. Internal use only.
@@ -102,6 +111,7 @@ void TaskInterface::clearInputs(){
 
 //graphical functions
 View* TaskInterface::getActiveView(){
+    std::lock_guard <std::mutex> lock(_viewMutex);
     if(!_enableGraphics || _views.size() == 0){
         return nullptr;
     }
@@ -109,6 +119,26 @@ View* TaskInterface::getActiveView(){
     return _views.back();
 }
 
+/**
+ * @brief get the view shown on a display: the last one created for it
+ * @return nullptr if the task has no view on the display
+ */
+View* TaskInterface::getActiveView(uint32_t displayId){
+    std::lock_guard <std::mutex> lock(_viewMutex);
+    if(!_enableGraphics){
+        return nullptr;
+    }
+    return getTopView(displayId);
+}
+
+//called with _viewMutex held
+View* TaskInterface::getTopView(uint32_t displayId){
+    for(int i = _views.size() - 1; i >= 0; i--){
+        if(_views[i]->getDisplayId() == displayId) return _views[i];
+    }
+    return nullptr;
+}
+
 bool TaskInterface::deleteCurrentView(){
     if(!_enableGraphics){
         return false;
@@ -120,44 +150,71 @@ bool TaskInterface::deleteCurrentView(){
     return _deleteCurrentView;
 }
 
-bool TaskInterface::createView(){
+/**
+ * @brief create a new view and make it the active one
+ * @param displayId display the view is drawn on. Views on other displays keep being drawn.
+ * If the display does not exist the view works, but it is not drawn
+ */
+bool TaskInterface::createView(uint32_t displayId){
     if(!_enableGraphics){
         return false;
     }
 
-    //std::lock_guard <std::mutex> lock(_viewMutex);
-    _views.push_back(new View());
+    std::lock_guard <std::mutex> lock(_viewMutex);
+    TaskViewRenderer* renderer;
+    auto it = _viewRenderers.find(displayId);
+    if(it == _viewRenderers.end()){
+        renderer = new TaskViewRenderer(displayId);
+        _viewRenderers[displayId] = renderer;
+    }else{
+        renderer = it->second;
+    }
+
+    _views.push_back(new View(displayId));
+    renderer->startTransition(1);  //the new view slides in from the right, drawn from scratch
     return true;
 }
 
 void TaskInterface::_updateInterface(){
-    //std::lock_guard <std::mutex> lock(_viewMutex);
+    CESP_TRACE_SCOPE("update_interface");
+    std::lock_guard <std::mutex> lock(_viewMutex);
     if(!_enableGraphics || _views.size() == 0){
         return;
     }
 
     if(_deleteCurrentView){
         View* to_erase = _views.back();
+        _viewRenderers[to_erase->getDisplayId()]->startTransition(-1); //the previous view slides back in from the left
         delete to_erase;
         _views.pop_back();
         _deleteCurrentView = false;
+        if(_views.size() == 0) return;
     }
 
-    if(millis() - _renderTimer > 100){
-        _renderTimer = millis();
-        renderView();
+    //each display shows the last view created for it
+    //the frame clock runs faster while a view is moving
+    uint32_t now = millis();
+    uint32_t period = RENDER_PERIOD_MS;
+    for(auto &renderer : _viewRenderers){
+        if(renderer.second->isAnimating()) period = ANIMATION_FRAME_PERIOD_MS;
     }
-}
-
-bool TaskInterface::renderView(){
-    if(!_enableGraphics || _views.size() == 0){
-        return false;
+    bool render = now - _renderTimer >= period;
+    if(render) _renderTimer = now;
+    for(auto &renderer : _viewRenderers){
+        View* view = getTopView(renderer.first);
+        if(view == nullptr) continue;
+
+        //publish the view changes made by the task
+        view->publish_render_view();
+        if(render) renderView(view, renderer.second, now);
     }
+}
 
-    //std::lock_guard <std::mutex> lock(_viewMutex);
-    View* active_view = _views.back();
-    ViewRenderStruct viewRender;
-    bool ret = active_view->get_render_view(viewRender);
-    if(!ret) return false;
-    return _viewRenderer->renderView(viewRender);
+//called with _viewMutex held
+bool TaskInterface::renderView(View* view, TaskViewRenderer* renderer, uint32_t frameTime){
+    bool newFrame;
+    ViewRenderStruct* viewRender = view->acquire_render_view(newFrame);
+    bool ret = renderer->renderView(*viewRender, newFrame, frameTime);
+    view->release_render_view();
+    return ret;
 }
\ No newline at end of file
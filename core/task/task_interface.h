@@ -9,6 +9,7 @@
 #include "core/task/gui/view_render.h"
 
 #include <vector>
+#include <map>
 #include <mutex>
 
 class InputListener;
@@ -29,25 +30,27 @@ public:
 
     //graphical functions
     View* getActiveView();
+    View* getActiveView(uint32_t displayId);
     bool deleteCurrentView();
-    bool createView();
+    bool createView(uint32_t displayId = 0);
 
     //Internal use only functions  
     void _updateInterface();
 private:
     void inputInit(InputListener *listener);
-    bool renderView();
+    View* getTopView(uint32_t displayId);
+    bool renderView(View* view, TaskViewRenderer* renderer, uint32_t frameTime);
 
     //input variables
     InputListener *_inputListener;
-    TaskViewRenderer *_viewRenderer;
+    std::map <uint32_t, TaskViewRenderer*> _viewRenderers;  //one for each display used by the views, by display id
 
     //view variabiles
     const bool _enableGraphics; //disables all graphical functionality
     std::vector <View *> _views;
     bool _deleteCurrentView;
     std::mutex _viewMutex;
-    int _renderTimer;
+    uint32_t _renderTimer;  //time of the last frame
 
     //navigation input events
     InputEvent _upNavEvent, _downNavEvent, _selectNavEvent;
@@ -0,0 +1,209 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include "core/tracing/tracer.h"
+#include "core/logging/logging.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <map>
+#include <new>
+#include <vector>
+#include <string.h>
+
+Tracer::CoreBuffer Tracer::_buffers[TRACE_CORE_COUNT];
+uint32_t Tracer::_capacity = 0;
+std::atomic <bool> Tracer::_recording(false);
+
+/**
+ * @brief start a new recording, discarding the previous one
+ * @param eventsPerCore size of the buffer of each core, allocated here and kept until release
+ * @return false if already recording or the memory is not available
+ */
+bool Tracer::start(uint32_t eventsPerCore){
+    if(isRecording() || eventsPerCore == 0) return false;
+    waitWriters();  //events of the previous recording still being written
+
+    if(eventsPerCore != _capacity){
+        release();
+        for(int core = 0; core < TRACE_CORE_COUNT; core++){
+            _buffers[core].events = new (std::nothrow) TraceEvent[eventsPerCore];
+            if(_buffers[core].events == nullptr){
+                release();
+                CESP_LOGE(LogModule::KERNEL, "Tracer: could not allocate %u events", eventsPerCore);
+                return false;
+            }
+        }
+        _capacity = eventsPerCore;
+    }
+
+    for(int core = 0; core < TRACE_CORE_COUNT; core++){
+        CoreBuffer &buffer = _buffers[core];
+        for(uint32_t i = 0; i < _capacity; i++) buffer.events[i].name.store(nullptr, std::memory_order_relaxed);
+        buffer.count.store(0);
+        buffer.referenceSet.store(false);
+    }
+    _recording.store(true);
+    return true;
+}
+
+/**
+ * @brief stop adding events. The recording is kept until the next start
+ */
+void Tracer::stop(){
+    _recording.store(false);
+}
+
+/**
+ * @brief free the buffers
+ */
+void Tracer::release(){
+    stop();
+    waitWriters();
+    for(int core = 0; core < TRACE_CORE_COUNT; core++){
+        if(_buffers[core].events) delete[] _buffers[core].events;
+        _buffers[core].events = nullptr;
+        _buffers[core].count.store(0);
+    }
+    _capacity = 0;
+}
+
+/**
+ * @brief wait until no event is being written, after the recording stopped
+ * @details a writer that saw the recording stopped leaves without touching the buffer. The wait yields,
+ * so that a lower priority task interrupted while recording can complete its event
+ */
+void Tracer::waitWriters(){
+    for(int core = 0; core < TRACE_CORE_COUNT; core++){
+        while(_buffers[core].writers.load() != 0) vTaskDelay(1);
+    }
+}
+
+uint32_t Tracer::getEventCount(int core){
+    if(core < 0 || core >= TRACE_CORE_COUNT) return 0;
+    uint32_t count = _buffers[core].count.load();
+    return count < _capacity ? count : _capacity;
+}
+
+/**
+ * @brief events not recorded because the buffer of the core was full
+ */
+uint32_t Tracer::getDroppedCount(int core){
+    if(core < 0 || core >= TRACE_CORE_COUNT) return 0;
+    uint32_t count = _buffers[core].count.load();
+    return count > _capacity ? count - _capacity : 0;
+}
+
+void Tracer::recordEvent(TraceEventType type, const char* name){
+    uint32_t cycles = ESP.getCycleCount();
+    int core = xPortGetCoreID();
+    if(core < 0 || core >= TRACE_CORE_COUNT) return;
+    CoreBuffer &buffer = _buffers[core];
+
+    //announce the writer before checking again: stop() may have been called after the check in record()
+    buffer.writers.fetch_add(1);
+    if(!_recording.load()){
+        buffer.writers.fetch_sub(1);
+        return;
+    }
+
+    //the first event of the core takes the reference used to align the two cycle counters
+    if(!buffer.referenceSet.load(std::memory_order_relaxed)){
+        bool expected = false;
+        if(buffer.referenceSet.compare_exchange_strong(expected, true)){
+            buffer.referenceMicros = micros();
+            buffer.referenceCycles = ESP.getCycleCount();
+        }
+    }
+
+    uint32_t index = buffer.count.fetch_add(1, std::memory_order_relaxed);
+    if(index < _capacity){  //otherwise full, counted as dropped
+        TraceEvent &event = buffer.events[index];
+        event.cycles = cycles;
+        event.task = (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+        event.type = type;
+        event.name.store(name, std::memory_order_release);
+    }
+    buffer.writers.fetch_sub(1, std::memory_order_release);
+}
+
+namespace{
+    size_t writeValue(Print &out, const void* value, size_t size){
+        return out.write((const uint8_t*)value, size);
+    }
+};
+
+/**
+ * @brief write the recording in binary: header, the events of each core, then the names of the events. Little endian
+ * @details must be called after stop. Events still being written when the recording stopped are completed first
+ */
+size_t Tracer::dump(Print &out){
+    if(isRecording() || _capacity == 0) return 0;
+    waitWriters();  //events still being written when the recording stopped
+
+    //the name of each event is read once: an event without name is not written, and the count must match.
+    //Events refer to their name by index
+    std::vector <const char*> eventNames[TRACE_CORE_COUNT];
+    std::map <const char*, uint16_t> names;
+    for(int core = 0; core < TRACE_CORE_COUNT; core++){
+        eventNames[core].resize(getEventCount(core));
+        for(uint32_t i = 0; i < eventNames[core].size(); i++){
+            const char* name = _buffers[core].events[i].name.load(std::memory_order_acquire);
+            eventNames[core][i] = name;
+            if(name && names.find(name) == names.end()){
+                uint16_t id = names.size();
+                names[name] = id;
+            }
+        }
+    }
+
+    size_t written = 0;
+    uint32_t magic = TRACE_DUMP_MAGIC;
+    uint16_t version = TRACE_DUMP_VERSION;
+    uint16_t cores = TRACE_CORE_COUNT;
+    uint32_t frequency = ESP.getCpuFreqMHz();
+    written += writeValue(out, &magic, 4);
+    written += writeValue(out, &version, 2);
+    written += writeValue(out, &cores, 2);
+    written += writeValue(out, &frequency, 4);
+
+    for(int core = 0; core < TRACE_CORE_COUNT; core++){
+        CoreBuffer &buffer = _buffers[core];
+        uint32_t count = 0;
+        for(const char* name : eventNames[core]){
+            if(name) count++;
+        }
+        uint32_t dropped = getDroppedCount(core);
+        written += writeValue(out, &buffer.referenceCycles, 4);
+        written += writeValue(out, &buffer.referenceMicros, 4);
+        written += writeValue(out, &count, 4);
+        written += writeValue(out, &dropped, 4);
+
+        //cycles, task, name index, type: 11 bytes
+        for(uint32_t i = 0; i < eventNames[core].size(); i++){
+            TraceEvent &event = buffer.events[i];
+            const char* name = eventNames[core][i];
+            if(name == nullptr) continue;
+            uint16_t id = names[name];
+            uint8_t type = (uint8_t)event.type;
+            written += writeValue(out, &event.cycles, 4);
+            written += writeValue(out, &event.task, 4);
+            written += writeValue(out, &id, 2);
+            written += writeValue(out, &type, 1);
+        }
+    }
+
+    //names ordered by index
+    std::vector <const char*> table(names.size());
+    for(auto &name : names) table[name.second] = name.first;
+    uint16_t nameCount = table.size();
+    written += writeValue(out, &nameCount, 2);
+    for(const char* name : table){
+        uint8_t length = strlen(name) > 255 ? 255 : strlen(name);
+        written += writeValue(out, &length, 1);
+        written += writeValue(out, name, length);
+    }
+    return written;
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <stdint.h>
+#include <stddef.h>
+
+class Print;
+
+//set to 0 to remove the trace points from the build
+#ifndef CESP_TRACE_ENABLED
+#define CESP_TRACE_ENABLED 1
+#endif
+
+namespace{
+    const uint8_t TRACE_CORE_COUNT = 2;
+    const uint32_t TRACE_DEFAULT_EVENTS = 1024;     //events for each core
+    const uint32_t TRACE_DUMP_MAGIC = 0x43525443;   //"CTRC"
+    const uint16_t TRACE_DUMP_VERSION = 1;
+};
+
+enum class TraceEventType : uint8_t{
+    BEGIN = 0,
+    END = 1,
+    INSTANT = 2
+};
+
+struct TraceEvent{
+    uint32_t cycles;    //cycle counter of the core
+    uint32_t task;      //handle of the task that recorded the event
+    std::atomic <const char*> name;    //string literal, set last: nullptr while the event is being written
+    TraceEventType type;
+};
+
+/**
+ * @brief records begin, end and instant events with the cycle counter of the core, for a time window.
+ * The recording is dumped in binary and converted to a Chrome trace by tools/trace_to_chrome.py
+ * @details each core has its own buffer, a slot is reserved with an atomic increment: no locks, usable from interrupts.
+ * The recording stops adding events when the buffer of a core is full. When not recording a trace point costs a load.
+ * start and release wait for the events being written before they reset or free the buffers
+ */
+class Tracer{
+public:
+    static bool start(uint32_t eventsPerCore = TRACE_DEFAULT_EVENTS);
+    static void stop();
+    static void release();
+    static bool isRecording() {return _recording.load(std::memory_order_relaxed);}
+
+    static void record(TraceEventType type, const char* name){
+        if(isRecording()) recordEvent(type, name);
+    }
+
+    static uint32_t getEventCount(int core);
+    static uint32_t getDroppedCount(int core);
+    static size_t dump(Print &out);
+private:
+    static void recordEvent(TraceEventType type, const char* name);
+    static void waitWriters();
+
+    struct CoreBuffer{
+        TraceEvent* events;
+        std::atomic <uint32_t> count;       //slots reserved, can exceed the capacity
+        std::atomic <uint32_t> writers;     //recordEvent calls in progress, the buffer is not freed or reset until 0
+        std::atomic <bool> referenceSet;
+        uint32_t referenceCycles;           //cycle counter and micros() read together by the first event,
+        uint32_t referenceMicros;           //to align the cores
+    };
+    static CoreBuffer _buffers[TRACE_CORE_COUNT];
+    static uint32_t _capacity;
+    static std::atomic <bool> _recording;
+};
+
+/**
+ * @brief begin event when created, end event when destroyed
+ */
+class TraceScope{
+public:
+    TraceScope(const char* name) : _name(name) {Tracer::record(TraceEventType::BEGIN, name);}
+    ~TraceScope() {Tracer::record(TraceEventType::END, _name);}
+private:
+    const char* _name;
+};
+
+#define CESP_TRACE_CONCAT_(a, b) a##b
+#define CESP_TRACE_CONCAT(a, b) CESP_TRACE_CONCAT_(a, b)
+
+#if CESP_TRACE_ENABLED
+#define CESP_TRACE_SCOPE(name) TraceScope CESP_TRACE_CONCAT(_traceScope, __LINE__)(name)
+#define CESP_TRACE_BEGIN(name) Tracer::record(TraceEventType::BEGIN, name)
+#define CESP_TRACE_END(name) Tracer::record(TraceEventType::END, name)
+#define CESP_TRACE_INSTANT(name) Tracer::record(TraceEventType::INSTANT, name)
+#else
+#define CESP_TRACE_SCOPE(name) do{}while(0)
+#define CESP_TRACE_BEGIN(name) do{}while(0)
+#define CESP_TRACE_END(name) do{}while(0)
+#define CESP_TRACE_INSTANT(name) do{}while(0)
+#endif
+
+#endif //TRACER_H
@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <chibiESP.h>
+#include <core/logging/logging.h>
+#include <core/task/user_task.h>
+#include <core/kernel/components/display_compositor.h>
+#include <core/kernel/interfaces/i2c_bus.h>
+#include <core/kernel/interfaces/simulated_i2c_backend.h>
+#include <core/base_devices/ssd1306.h>
+
+const uint32_t BENCHMARK_DISPLAY_ID = 0;
+const int BENCHMARK_BUS = 0;
+
+SimulatedI2cBackend simulatedBus;
+
+struct FlushBenchmarkConfig{
+    const char* name;
+    uint32_t clock;
+    size_t chunkSize;
+};
+
+//the first one sends like the Adafruit library on the ESP32: 128 byte writes at 400 kHz
+const FlushBenchmarkConfig FLUSH_BENCHMARK_CONFIGS[] = {
+    {"fast, 128 B chunks", I2C_CLOCK_FAST, 128},
+    {"fast, 1025 B chunks", I2C_CLOCK_FAST, 1025},
+    {"fast plus, 1025 B chunks", I2C_CLOCK_FAST_PLUS, 1025},
+};
+
+/**
+ * @brief draw a frame through the compositor, wait for it to be sent and log the bytes and the time on the simulated wire
+ */
+void flush_benchmark_frame(const char* name, void (*draw)(DisplayDevice* display)){
+    DisplayCompositor* compositor = chibiESP.getDisplayCompositor(BENCHMARK_DISPLAY_ID);
+    SSD1306* display = static_cast<SSD1306*>(chibiESP.getDisplayDevice(BENCHMARK_DISPLAY_ID));
+    if(compositor == nullptr || display == nullptr){
+        Logger::error("Flush benchmark: display not available");
+        return;
+    }
+
+    uint32_t flushes = compositor->getFlushCount();
+    uint32_t bytes = simulatedBus.getByteCount();
+    uint32_t transfers = simulatedBus.getTransferCount();
+    uint64_t busTime = simulatedBus.getBusTime();
+
+    compositor->beginFrame(nullptr);
+    draw(display);
+    compositor->endFrame(true);
+    uint32_t wait_start = millis();
+    while(compositor->getFlushCount() == flushes && millis() - wait_start < 1000) delay(1);
+
+    Logger::info("  %s: %u pages, %u bytes in %u writes, %u us on the wire", name, display->getLastUpdatePages(),
+        simulatedBus.getByteCount() - bytes, simulatedBus.getTransferCount() - transfers, (uint32_t)(simulatedBus.getBusTime() - busTime));
+}
+
+void flush_benchmark_full(DisplayDevice* display){
+    static bool white = false;
+    white = !white;
+    display->fillScreen(white ? BW_Color::CESP_WHITE : BW_Color::CESP_BLACK);
+}
+
+void flush_benchmark_line(DisplayDevice* display){
+    display->drawText("one changed line", 0, 24, 1, BW_Color::CESP_BLACK, BW_Color::CESP_WHITE);
+}
+
+const void flush_benchmark_program_setup(CESP_UserTaskData &taskData){
+    Logger::info("Flush benchmark: SSD1306 128x64 on a simulated bus");
+}
+
+const void flush_benchmark_program_loop(CESP_UserTaskData &taskData){
+    static bool done = false;
+    I2cBus* bus = chibiESP.getI2cBus(BENCHMARK_BUS);
+    if(!done && bus != nullptr){
+        for(const FlushBenchmarkConfig &config : FLUSH_BENCHMARK_CONFIGS){
+            bus->setClock(config.clock);
+            size_t chunkSize = bus->setChunkSize(config.chunkSize);
+            Logger::info("%s (chunk %u)", config.name, chunkSize);
+            flush_benchmark_frame("full screen", flush_benchmark_full);
+            flush_benchmark_frame("one line", flush_benchmark_line);
+        }
+        done = true;
+    }
+    delay(1000);
+}
+
+const void flush_benchmark_program_closeup(CESP_UserTaskData &taskData){
+    Logger::info("Closing flush benchmark");
+}
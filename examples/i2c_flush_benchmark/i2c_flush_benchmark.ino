@@ -0,0 +1,44 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include <chibiESP.h>
+#include <core/base_devices/ssd1306.h>
+#include <core/kernel/interfaces/simulated_i2c_backend.h>
+#include <core/logging/logging.h>
+#include <core/structs/program.h>
+
+#include "flush_benchmark_program.h"
+
+void user_setup_function(){
+  CESP_Program benchmarkProgram("flush benchmark", flush_benchmark_program_setup, flush_benchmark_program_loop, flush_benchmark_program_closeup );
+
+  chibiESP.createProgram(benchmarkProgram);
+
+  chibiESP.startProgram("flush benchmark");
+}
+
+void setup() {
+  chibiESP.init();
+
+  //simulated bus with a display at the SSD1306 address: no hardware needed
+  simulatedBus.addDevice(0x3C, 256);
+  chibiESP.registerI2cInterface(BENCHMARK_BUS, &simulatedBus);
+
+  SSD1306 *display = new SSD1306(BENCHMARK_DISPLAY_ID);
+  SSD1306ConfigStruct displayConfig = {128, 64, BENCHMARK_BUS};
+  display->configure(displayConfig);
+  chibiESP.register_display_device(display);
+
+  //initialize all system devices
+  chibiESP.init_kernel_devices();
+
+  //enter setup loop
+  user_setup_function();
+}
+
+void loop() {
+  chibiESP.loop();
+
+  delay(10);
+}
@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <chibiESP.h>
+#include <core/logging/logging.h>
+#include <core/task/user_task.h>
+#include <core/task/gui/view.h>
+#include <core/task/gui/task_view_renderer.h>
+#include <core/kernel/components/display_compositor.h>
+#include <core/base_devices/memory_mono_display.h>
+
+#include <string>
+
+const uint32_t BENCHMARK_DISPLAY_ID = 0;
+const int BENCHMARK_FRAMES = 100;
+
+//the task_menu example view
+void build_menu_view(View &view){
+    view.create_generic_element(0, "this is a text", 0, 0);
+    view.create_button_element(1, "button", 0, 10);
+    view.create_generic_element(2, "try this:", 0, 20);
+    view.create_list_element(3, 60, 20);
+    view.gui_list_add_text(3, "option 1");
+    view.gui_list_add_text(3, "option 2");
+    view.gui_list_add_text(3, "option 3");
+    view.gui_list_add_text(3, "option 4");
+    view.create_generic_element(4, "press: ", 0, 30);
+    view.create_button_element(5, "button2", 40, 30);
+    view.create_button_element(6, "button3", 0, 40);
+}
+
+//a long list of buttons, scrolled by the focus
+void build_long_view(View &view){
+    for(int i = 0; i < 200; i++){
+        view.create_button_element(i, "item " + std::to_string(i), 0, i * 10);
+    }
+}
+
+int benchmark_list_count(void* context){
+    return 10000;
+}
+
+bool benchmark_list_item(void* context, int index, GuiText &text){
+    char buffer[GUI_TEXT_MAX_LENGTH + 1];
+    int length = snprintf(buffer, sizeof(buffer), "row %d", index);
+    text.assign(buffer, length);
+    return true;
+}
+
+//a virtual list with many rows, scrolled by its cursor
+void build_virtual_list_view(View &view){
+    GuiListDataSource source = {benchmark_list_count, benchmark_list_item, nullptr};
+    view.create_generic_element(0, "virtual list", 0, 0);
+    view.create_virtual_list_element(1, source, 6, 8, 0, 10);
+    view._gui_navigation_up(1);     //focus the list..
+    view._gui_navigation_release(); //..and enter it
+}
+
+/**
+ * @brief render a view for BENCHMARK_FRAMES frames, moving the focus up by one each frame, and log the results
+ * @details the renderer is the one used by the tasks, but it is driven directly so that only the rendering is timed.
+ * The frames are sent by the display compositor, as usual
+ */
+void run_benchmark(const char* name, void (*build)(View &view)){
+    MemoryMonoDisplay* display = static_cast<MemoryMonoDisplay*>(chibiESP.getDisplayDevice(BENCHMARK_DISPLAY_ID));
+    DisplayCompositor* compositor = chibiESP.getDisplayCompositor(BENCHMARK_DISPLAY_ID);
+    if(display == nullptr || compositor == nullptr){
+        Logger::error("Benchmark: display not available");
+        return;
+    }
+
+    View view(BENCHMARK_DISPLAY_ID);
+    TaskViewRenderer renderer(BENCHMARK_DISPLAY_ID);
+    renderer.setAnimationsEnabled(false);   //every frame shows the final position, the cost does not depend on timing
+    build(view);
+    GuiEventData event;
+
+    uint32_t total_us = 0, max_us = 0;
+    for(int frame = 0; frame <= BENCHMARK_FRAMES; frame++){
+        if(frame == 1) display->resetStats();   //the first frame draws everything, it is not counted
+        uint32_t flushes = compositor->getFlushCount();
+
+        uint32_t start = micros();
+        view.publish_render_view();
+        bool newFrame;
+        ViewRenderStruct* render = view.acquire_render_view(newFrame);
+        renderer.renderView(*render, newFrame, millis());
+        view.release_render_view();
+        uint32_t elapsed = micros() - start;
+        if(frame > 0){
+            total_us += elapsed;
+            if(elapsed > max_us) max_us = elapsed;
+        }
+
+        //wait for the frame to be sent, then move to the next one
+        uint32_t wait_start = millis();
+        while(compositor->getFlushCount() == flushes && millis() - wait_start < 100) delay(1);
+        view._gui_navigation_up(1);
+        while(view.getEvent(event));
+    }
+
+    MemoryDisplayUpdateStats stats = display->getTotalStats();
+    uint32_t updates = display->getUpdateCount() > 0 ? display->getUpdateCount() : 1;
+    Logger::info("%s: render avg %u us, max %u us | per update: %u bytes sent, %u bytes changed, %u pixels changed (%u updates)",
+        name, total_us / BENCHMARK_FRAMES, max_us, stats.bytesSent / updates, stats.bytesChanged / updates,
+        stats.pixelsChanged / updates, display->getUpdateCount());
+}
+
+const void benchmark_program_setup(CESP_UserTaskData &taskData){
+    Logger::info("Render benchmark: %d frames per view", BENCHMARK_FRAMES);
+}
+
+const void benchmark_program_loop(CESP_UserTaskData &taskData){
+    static bool done = false;
+    if(!done){
+        run_benchmark("menu view", build_menu_view);
+        run_benchmark("long view", build_long_view);
+        run_benchmark("virtual list", build_virtual_list_view);
+        done = true;
+    }
+    delay(1000);
+}
+
+const void benchmark_program_closeup(CESP_UserTaskData &taskData){
+    Logger::info("Closing render benchmark");
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include <chibiESP.h>
+#include <core/base_devices/memory_mono_display.h>
+#include <core/logging/logging.h>
+#include <core/structs/program.h>
+
+#include "benchmark_program.h"
+
+void user_setup_function(){
+  CESP_Program benchmarkProgram("render benchmark", benchmark_program_setup, benchmark_program_loop, benchmark_program_closeup );
+
+  chibiESP.createProgram(benchmarkProgram);
+
+  chibiESP.startProgram("render benchmark");
+}
+
+void setup() {
+  chibiESP.init();
+
+  //headless display with the size of a SSD1306: no hardware needed
+  MemoryMonoDisplay *display = new MemoryMonoDisplay(BENCHMARK_DISPLAY_ID);
+  MemoryMonoDisplayConfigStruct displayConfig = {128, 64};
+  display->configure(displayConfig);
+  chibiESP.register_display_device(display);
+
+  //initialize all system devices
+  chibiESP.init_kernel_devices();
+
+  //enter setup loop
+  user_setup_function();
+}
+
+void loop() {
+  chibiESP.loop();
+
+  delay(10);
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <chibiESP.h>
+#include <core/logging/logging.h>
+#include <core/task/user_task.h>
+#include <core/kernel/components/sensor_buffer.h>
+#include <core/kernel/interfaces/simulated_i2c_backend.h>
+
+#include <vector>
+
+const uint32_t TEMPERATURE_SENSOR_ID = 0;
+const uint32_t ACCELEROMETER_SENSOR_ID = 1;
+const int SENSOR_BUS = 0;
+const uint8_t TEMPERATURE_ADDRESS = 0x48;
+const uint8_t ACCELEROMETER_ADDRESS = 0x68;
+
+SimulatedI2cBackend simulatedBus;
+
+/**
+ * @brief change the values in the simulated registers, as if the sensors measured something
+ */
+void sensor_program_simulate(){
+    static uint16_t step = 0;
+    step++;
+    uint8_t* temperature = simulatedBus.getRegisters(TEMPERATURE_ADDRESS);
+    int16_t raw = (int16_t)((22 + (step % 40) / 10.0f) * 128);
+    temperature[0] = raw >> 8;
+    temperature[1] = raw & 0xFF;
+
+    uint8_t* accelerometer = simulatedBus.getRegisters(ACCELEROMETER_ADDRESS);
+    int16_t z = 16384 + (step % 8) * 64;    //1 g and some vibration
+    accelerometer[6] = z >> 8;
+    accelerometer[7] = z & 0xFF;
+}
+
+const void sensor_program_setup(CESP_UserTaskData &taskData){
+    Logger::info("Sensors: temperature every 100 ms, accelerometer every 20 ms, on the same bus");
+}
+
+const void sensor_program_loop(CESP_UserTaskData &taskData){
+    //the subscriptions read the sensor buffers, the bus is read only by the kernel sampler
+    static SensorSubscription temperature = chibiESP.subscribeSensor(TEMPERATURE_SENSOR_ID);
+    static SensorSubscription accelerometer = chibiESP.subscribeSensor(ACCELEROMETER_SENSOR_ID);
+    static std::vector <SensorSample> samples;
+
+    sensor_program_simulate();
+
+    SensorSample latest;
+    if(temperature.latest(latest)) Logger::info("temperature %.2f C", latest.values[0]);
+
+    //average of the last second of the z axis
+    size_t count = accelerometer.history(samples, 1000);
+    float sum = 0;
+    for(const SensorSample &sample : samples) sum += sample.values[2];
+    if(count > 0) Logger::info("acceleration z %.3f g, average of %u samples", sum / count, count);
+
+    //samples taken since the last loop, none is lost while the buffer holds them
+    count = accelerometer.readNew(samples);
+    Logger::info("%u new accelerometer samples, %u missed", count, accelerometer.getMissed());
+
+    delay(1000);
+}
+
+const void sensor_program_closeup(CESP_UserTaskData &taskData){
+    Logger::info("Closing sensors");
+}
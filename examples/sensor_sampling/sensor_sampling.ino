@@ -0,0 +1,57 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#include <chibiESP.h>
+#include <core/base_devices/i2c_register_sensor.h>
+#include <core/kernel/interfaces/simulated_i2c_backend.h>
+#include <core/logging/logging.h>
+#include <core/structs/program.h>
+
+#include "sensor_program.h"
+
+void user_setup_function(){
+  CESP_Program sensorProgram("sensors", sensor_program_setup, sensor_program_loop, sensor_program_closeup );
+
+  chibiESP.createProgram(sensorProgram);
+
+  chibiESP.startProgram("sensors");
+}
+
+void setup() {
+  chibiESP.init();
+
+  //simulated bus with two sensors: no hardware needed
+  simulatedBus.addDevice(TEMPERATURE_ADDRESS, 16);
+  simulatedBus.addDevice(ACCELEROMETER_ADDRESS, 16);
+  simulatedBus.setRealTime(true);
+  chibiESP.registerI2cInterface(SENSOR_BUS, &simulatedBus);
+
+  //temperature in 1/128 degrees, like the TMP102 and LM75 family
+  I2cRegisterSensor *temperature = new I2cRegisterSensor(TEMPERATURE_SENSOR_ID);
+  I2cRegisterSensorConfigStruct temperatureConfig = {SENSOR_BUS, TEMPERATURE_ADDRESS, 0x00, 1};
+  temperatureConfig.scale = 1.0f / 128;
+  temperatureConfig.model = "temperature";
+  temperature->configure(temperatureConfig);
+  chibiESP.register_sensor_device(temperature, 100);
+
+  //three axes in 1/16384 g
+  I2cRegisterSensor *accelerometer = new I2cRegisterSensor(ACCELEROMETER_SENSOR_ID);
+  I2cRegisterSensorConfigStruct accelerometerConfig = {SENSOR_BUS, ACCELEROMETER_ADDRESS, 0x02, 3};
+  accelerometerConfig.scale = 1.0f / 16384;
+  accelerometerConfig.model = "accelerometer";
+  accelerometer->configure(accelerometerConfig);
+  chibiESP.register_sensor_device(accelerometer, 20, 64);
+
+  //initialize all system devices
+  chibiESP.init_kernel_devices();
+
+  //enter setup loop
+  user_setup_function();
+}
+
+void loop() {
+  chibiESP.loop();
+
+  delay(10);
+}
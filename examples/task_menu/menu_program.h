@@ -13,6 +13,19 @@
 
 #include <memory>
 
+//called on the task thread when a button is released
+void on_button_released(const GuiEventData &event, void* context){
+    Logger::info("Button %d released", event.elementId);
+}
+
+//called on the task thread when the shown option of the list changes
+void on_list_changed(const GuiEventData &event, void* context){
+    View* view = static_cast<View*>(context);
+    std::string option;
+    view->gui_get_Text(event.elementId, option);
+    Logger::info("Selected %s", option.c_str());
+}
+
 const void menu_program_setup(CESP_UserTaskData &taskData){
     Logger::info("Menu program setup");
 
@@ -29,18 +42,25 @@ const void menu_program_setup(CESP_UserTaskData &taskData){
     view->create_generic_element(4, "press: ", 0, 30);
     view->create_button_element(5, "button2", 40, 30);
     view->create_button_element(6, "button3", 0, 40);
+
+    //the buttons and the list notify their events, the other ones are queued
+    view->gui_set_event_callback(1, on_button_released, nullptr, guiEventMask(GuiEvent::BUTTON_RELEASED));
+    view->gui_set_event_callback(5, on_button_released, nullptr, guiEventMask(GuiEvent::BUTTON_RELEASED));
+    view->gui_set_event_callback(6, on_button_released, nullptr, guiEventMask(GuiEvent::BUTTON_RELEASED));
+    view->gui_set_event_callback(3, on_list_changed, view, guiEventMask(GuiEvent::LIST_CHANGED));
 }
 
 const void menu_program_loop(CESP_UserTaskData &taskData){
+    //reading the inputs drives the navigation of the view, that calls the element callbacks
     InputEvent event;
     while(taskData.taskInterface.getInputEvent(event)){
   
     }
     View* view = taskData.taskInterface.getActiveView();
     if(view != nullptr){
-      GuiEvent gui_event;
+      GuiEventData gui_event;
       while(view->getEvent(gui_event)){
-        Logger::info("New gui event: %d", static_cast<int>(gui_event));
+        Logger::info("New gui event: %d from element %d", static_cast<int>(gui_event.type), gui_event.elementId);
       }
     }
     delay(10);
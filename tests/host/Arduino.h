@@ -0,0 +1,79 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Host replacement of the Arduino core, for the tests that run on Linux.
+// Time comes from the steady clock, pins do nothing and Serial writes to stdout
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <math.h>
+
+#define LOW 0x0
+#define HIGH 0x1
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define CHANGE 0x03
+#define NOT_AN_INTERRUPT -1
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(int interrupt, void (*callback)(), int mode);
+void detachInterrupt(int interrupt);
+
+class Print{
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) {return write(&c, 1);}
+    virtual size_t write(const uint8_t* buffer, size_t size) {return size;}
+    virtual int availableForWrite() {return 0;}
+    size_t print(const char* text);
+    size_t printf(const char* format, ...);
+};
+
+class HardwareSerial : public Print{
+public:
+    using Print::write;
+    void begin(unsigned long baud) {}
+    operator bool() const {return true;}
+    void println(const char* text);
+    void flush();
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int availableForWrite() override {return 128;}
+};
+
+extern HardwareSerial Serial;
+
+class EspClass{
+public:
+    uint32_t getCycleCount();
+    uint32_t getCpuFreqMHz() {return 240;}
+    uint32_t getFreeHeap() {return 200000;}
+    uint32_t getMinFreeHeap() {return 150000;}
+    uint32_t getHeapSize() {return 320000;}
+};
+
+extern EspClass ESP;
+
+int xPortGetCoreID();
+
+#endif //HOST_ARDUINO_H
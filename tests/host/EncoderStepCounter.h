@@ -0,0 +1,21 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Host replacement of the encoder library: the encoder never moves
+
+#ifndef HOST_ENCODER_STEP_COUNTER_H
+#define HOST_ENCODER_STEP_COUNTER_H
+
+#include <Arduino.h>
+
+class EncoderStepCounter{
+public:
+    EncoderStepCounter(int pin1, int pin2) {}
+    void begin() {}
+    void tick() {}
+    signed char getPosition() {return 0;}
+    void reset() {}
+};
+
+#endif //HOST_ENCODER_STEP_COUNTER_H
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Host replacement of the Arduino file system interface: files accept writes and read empty
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs{
+class File{
+public:
+    size_t write(const uint8_t* data, size_t length) {return length;}
+    size_t write(uint8_t data) {return 1;}
+    int read() {return -1;}
+    size_t read(uint8_t* buffer, size_t length) {return 0;}
+    int available() {return 0;}
+    size_t size() const {return 0;}
+    void flush() {}
+    void close() {}
+    operator bool() const {return true;}
+};
+
+class FS{
+public:
+    File open(const char* path, const char* mode = FILE_READ, bool create = false) {return File();}
+    bool exists(const char* path) {return false;}
+    bool remove(const char* path) {return true;}
+    bool rename(const char* from, const char* to) {return true;}
+};
+}
+
+using fs::FS;
+using fs::File;
+
+#endif //HOST_FS_H
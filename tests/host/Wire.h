@@ -0,0 +1,27 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Host replacement of the Arduino TwoWire driver: every transfer succeeds and reads return 0
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire{
+public:
+    TwoWire(int bus) {}
+    bool begin(int sda, int scl) {return true;}
+    bool setClock(uint32_t frequency) {return true;}
+    size_t setBufferSize(size_t size) {return size;}
+    void beginTransmission(uint8_t address) {}
+    uint8_t endTransmission(bool stop = true) {return 0;}
+    size_t write(uint8_t data) {return 1;}
+    size_t write(const uint8_t* data, size_t length) {return length;}
+    uint8_t requestFrom(uint8_t address, size_t length, bool stop = true) {return length;}
+    int read() {return 0;}
+    int available() {return 0;}
+};
+
+#endif //HOST_WIRE_H
@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Host replacement of the ESP-IDF SPI master driver: there is no SPI host, every call fails
+
+#ifndef HOST_SPI_MASTER_H
+#define HOST_SPI_MASTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef enum{
+    SPI1_HOST = 0,
+    SPI2_HOST = 1,
+    SPI3_HOST = 2
+} spi_host_device_t;
+
+#define SPI_DMA_CH_AUTO 3
+
+typedef struct{
+    int mosi_io_num;
+    int miso_io_num;
+    int sclk_io_num;
+    int quadwp_io_num;
+    int quadhd_io_num;
+    int max_transfer_sz;
+    uint32_t flags;
+} spi_bus_config_t;
+
+typedef struct{
+    uint8_t mode;
+    int clock_speed_hz;
+    int spics_io_num;
+    int queue_size;
+    uint32_t flags;
+} spi_device_interface_config_t;
+
+typedef struct{
+    uint32_t flags;
+    size_t length;
+    size_t rxlength;
+    const void* tx_buffer;
+    void* rx_buffer;
+} spi_transaction_t;
+
+typedef struct spi_device_t* spi_device_handle_t;
+
+inline esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* config, int dma) {return ESP_FAIL;}
+inline esp_err_t spi_bus_free(spi_host_device_t host) {return ESP_OK;}
+inline esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config, spi_device_handle_t* handle) {return ESP_FAIL;}
+inline esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {return ESP_OK;}
+inline esp_err_t spi_device_transmit(spi_device_handle_t handle, spi_transaction_t* transaction) {return ESP_FAIL;}
+
+#endif //HOST_SPI_MASTER_H
@@ -0,0 +1,14 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+#ifndef HOST_ESP_ATTR_H
+#define HOST_ESP_ATTR_H
+
+#define RTC_NOINIT_ATTR
+#define __NOINIT_ATTR
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#endif //HOST_ESP_ATTR_H
@@ -0,0 +1,20 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Host replacement of the ESP-IDF memory checks. The flash data of the ESP32 is the read only data of
+// the executable: the image from its start to the end of the initialized data, excluding stack and heap
+
+#ifndef HOST_ESP_MEMORY_UTILS_H
+#define HOST_ESP_MEMORY_UTILS_H
+
+#include <stdint.h>
+
+extern "C" char __executable_start[];
+extern "C" char edata[];
+
+inline bool esp_ptr_in_drom(const void* p){
+    return (uintptr_t)p >= (uintptr_t)__executable_start && (uintptr_t)p < (uintptr_t)edata;
+}
+
+#endif //HOST_ESP_MEMORY_UTILS_H
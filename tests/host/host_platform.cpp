@@ -0,0 +1,160 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Host implementation of the Arduino and FreeRTOS functions used by the library.
+// Every task is a detached std::thread with its own notification counter; threads that were
+// not created as tasks (e.g. the main thread of a test) get a handle on first use.
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace{
+    struct HostTask{
+        std::mutex mutex;
+        std::condition_variable notified;
+        uint32_t notifications = 0;
+    };
+
+    thread_local HostTask* currentTask = nullptr;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    HostTask* selfTask(){
+        if(currentTask == nullptr) currentTask = new HostTask();  //never freed: handles can outlive the thread
+        return currentTask;
+    }
+};
+
+HardwareSerial Serial;
+EspClass ESP;
+
+unsigned long millis(){
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long micros(){
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void delay(unsigned long ms){
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us){
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void pinMode(int pin, int mode) {}
+void digitalWrite(int pin, int value) {}
+int digitalRead(int pin) {return HIGH;}
+int digitalPinToInterrupt(int pin) {return pin;}
+void attachInterrupt(int interrupt, void (*callback)(), int mode) {}
+void detachInterrupt(int interrupt) {}
+
+size_t Print::print(const char* text){
+    return write((const uint8_t*)text, strlen(text));
+}
+
+size_t Print::printf(const char* format, ...){
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if(length < 0) return 0;
+    if(length >= (int)sizeof(buffer)) length = sizeof(buffer) - 1;
+    return write((const uint8_t*)buffer, length);
+}
+
+void HardwareSerial::println(const char* text){
+    print(text);
+    print("\n");
+}
+
+void HardwareSerial::flush(){
+    fflush(stdout);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size){
+    return fwrite(buffer, 1, size, stdout);
+}
+
+uint32_t EspClass::getCycleCount(){
+    return (uint32_t)(micros() * getCpuFreqMHz());
+}
+
+int xPortGetCoreID(){
+    return 0;
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*function)(void*), const char* name, uint32_t stackDepth, void* parameters,
+    UBaseType_t priority, TaskHandle_t* handle, BaseType_t coreId){
+    HostTask* task = new HostTask();
+    if(handle) *handle = task;
+    std::thread([task, function, parameters](){
+        currentTask = task;
+        function(parameters);
+    }).detach();
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task){
+    //the thread ends when its function returns; a task deleting itself never returns
+    if(task == nullptr || task == currentTask){
+        while(true) std::this_thread::sleep_for(std::chrono::hours(1));
+    }
+}
+
+void vTaskDelay(TickType_t ticks){
+    if(ticks == 0) std::this_thread::yield();
+    else std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+TickType_t xTaskGetTickCount(){
+    return (TickType_t)millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(){
+    return selfTask();
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t handle){
+    HostTask* task = (HostTask*)handle;
+    {
+        std::lock_guard <std::mutex> lock(task->mutex);
+        task->notifications++;
+    }
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks){
+    HostTask* task = selfTask();
+    std::unique_lock <std::mutex> lock(task->mutex);
+    auto pending = [task](){return task->notifications > 0;};
+    if(ticks == portMAX_DELAY) task->notified.wait(lock, pending);
+    else task->notified.wait_for(lock, std::chrono::milliseconds(ticks), pending);
+
+    uint32_t value = task->notifications;
+    if(value > 0) task->notifications = clearOnExit ? 0 : value - 1;
+    return value;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task){
+    return 1024;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(){
+    return 0;
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* status, UBaseType_t size, uint32_t* totalRunTime){
+    if(totalRunTime) *totalRunTime = 0;
+    return 0;
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Minimal assertions for the host tests. The tests end with TEST_EXIT, which skips the static
+// destructors: the library tasks are detached threads that are still running at that point.
+
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace{
+    int testFailures = 0;
+};
+
+#define CHECK(condition) do{ \
+        if(!(condition)){ \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++; \
+        } \
+    }while(0)
+
+#define CHECK_EQ(actual, expected) do{ \
+        long long _actual = (long long)(actual), _expected = (long long)(expected); \
+        if(_actual != _expected){ \
+            printf("%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #actual, #expected, _actual, _expected); \
+            testFailures++; \
+        } \
+    }while(0)
+
+#define TEST_EXIT() do{ \
+        printf(testFailures ? "FAILED (%d checks)\n" : "OK\n", testFailures); \
+        fflush(stdout); \
+        _Exit(testFailures ? 1 : 0); \
+    }while(0)
+
+#endif //TEST_CHECK_H
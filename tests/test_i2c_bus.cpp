@@ -0,0 +1,201 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// I2cBus over SimulatedI2cBackend: transfers run inline and on the worker, batches and bulk chunks,
+// priority order with aging over the three levels, queue overflow and concurrent blocking clients.
+
+#include "core/kernel/interfaces/i2c_bus.h"
+#include "core/kernel/interfaces/simulated_i2c_backend.h"
+#include "host/test_check.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace{
+    const uint8_t DISPLAY_ADDRESS = 0x3C;
+    const uint8_t SENSOR_ADDRESS = 0x48;
+    const int PRIORITY_COUNT = (int)I2cPriority::COUNT;
+
+    std::mutex servedMutex;
+    std::vector <int> served;   //priority * 100 + index of the asynchronous requests, in the order they ended
+    std::atomic <int> callbacks{0};
+
+    void recordServed(int result, void* context){
+        std::lock_guard <std::mutex> lock(servedMutex);
+        served.push_back((int)(intptr_t)context);
+        callbacks++;
+    }
+
+    //keeps the worker busy until released, so that requests pile up in the queues
+    struct Blocker{
+        std::atomic <bool> entered{false}, released{false};
+        std::thread thread;
+
+        void start(I2cBus &bus){
+            entered = false;
+            released = false;
+            thread = std::thread([this, &bus](){
+                bus.run([](void* context) -> int{
+                    Blocker* blocker = static_cast<Blocker*>(context);
+                    blocker->entered = true;
+                    while(!blocker->released) delay(1);
+                    return I2C_OK;
+                }, this, I2cPriority::INTERACTIVE);
+            });
+            while(!entered) delay(1);
+        }
+        void release(){
+            released = true;
+            thread.join();
+        }
+    };
+
+    bool waitCallbacks(int count){
+        for(int retry = 0; retry < 2000 && callbacks.load() < count; retry++) delay(1);
+        return callbacks.load() >= count;
+    }
+
+    void testInline(I2cBus &bus, SimulatedI2cBackend &backend){
+        //no worker yet: run on the caller
+        uint8_t value[2];
+        CHECK_EQ(bus.transfer(I2cTransaction(SENSOR_ADDRESS).readRegister(2, value, 2)), I2C_OK);
+        CHECK_EQ(value[0], 0xAB);
+        CHECK_EQ(value[1], 0xCD);
+        CHECK_EQ(bus.transfer(I2cTransaction(0x50).write(value, 1)), I2C_ERROR_NACK);
+
+        //a batch: several writes in one transaction
+        const uint8_t command[3] = {0x10, 1, 2};
+        uint8_t data[65];
+        data[0] = 0x20;
+        for(int i = 1; i < 65; i++) data[i] = i;
+        uint32_t transfers = backend.getTransferCount();
+        CHECK_EQ(bus.transfer(I2cTransaction(DISPLAY_ADDRESS).write(command, 3).write(data, 65)), I2C_OK);
+        CHECK_EQ(backend.getTransferCount() - transfers, 2);
+        CHECK_EQ(backend.getRegisters(DISPLAY_ADDRESS)[0x11], 2);
+        CHECK_EQ(backend.getRegisters(DISPLAY_ADDRESS)[0x20 + 63], 64);
+
+        //a bulk write is split in chunks, each one with the prefix
+        CHECK_EQ(bus.setChunkSize(16), 16);
+        const uint8_t prefix = 0x40;
+        transfers = backend.getTransferCount();
+        uint32_t bytes = backend.getByteCount();
+        CHECK_EQ(bus.transfer(I2cTransaction(DISPLAY_ADDRESS).writeBulk(&prefix, 1, data, 100)), I2C_OK);
+        CHECK_EQ(backend.getTransferCount() - transfers, 7);    //100 bytes in chunks of 15
+        CHECK_EQ(backend.getByteCount() - bytes, 100 + 7 * 2);  //data, plus prefix and address of each chunk
+        CHECK_EQ(bus.setChunkSize(1), 16);                      //no room for the prefix: refused
+    }
+
+    void testPriorityAging(I2cBus &bus){
+        const int perPriority = 10;
+        Blocker blocker;
+        blocker.start(bus);
+        served.clear();
+        callbacks = 0;
+
+        //lowest priority first, so that it is also the oldest
+        const uint8_t value = 0;
+        for(int priority = PRIORITY_COUNT - 1; priority >= 0; priority--){
+            for(int i = 0; i < perPriority; i++){
+                I2cTransaction transaction(SENSOR_ADDRESS, (I2cPriority)priority);
+                transaction.write(&value, 1);
+                CHECK_EQ(bus.submit(transaction, recordServed, (void*)(intptr_t)(priority * 100 + i)), I2C_OK);
+            }
+        }
+        blocker.release();
+        CHECK(waitCallbacks(perPriority * PRIORITY_COUNT));
+
+        //first in first out inside a priority
+        int next[PRIORITY_COUNT] = {};
+        for(int request : served){
+            CHECK_EQ(request % 100, next[request / 100]);
+            next[request / 100]++;
+        }
+
+        //while a queue waits, it is passed by higher priority requests at most once more than the limit
+        for(int priority = 1; priority < PRIORITY_COUNT; priority++){
+            int passed = 0, maxPassed = 0, left = perPriority;
+            for(int request : served){
+                if(left == 0) break;
+                if(request / 100 == priority){
+                    left--;
+                    passed = 0;
+                }else if(request / 100 < priority){
+                    passed++;
+                    if(passed > maxPassed) maxPassed = passed;
+                }
+            }
+            if(maxPassed > I2C_PRIORITY_BYPASS_LIMIT + 1) printf("priority %d passed %d times in a row\n", priority, maxPassed);
+            CHECK(maxPassed <= I2C_PRIORITY_BYPASS_LIMIT + 1);
+        }
+    }
+
+    void testOverflow(I2cBus &bus){
+        Blocker blocker;
+        blocker.start(bus);
+        callbacks = 0;
+
+        const uint8_t value = 0;
+        int accepted = 0, rejected = 0;
+        for(int i = 0; i < I2C_QUEUE_CAPACITY + 5; i++){
+            I2cTransaction transaction(SENSOR_ADDRESS, (I2cPriority)(i % PRIORITY_COUNT));
+            transaction.write(&value, 1);
+            int result = bus.submit(transaction, recordServed, nullptr);
+            if(result == I2C_OK) accepted++;
+            else if(result == I2C_ERROR_QUEUE_FULL) rejected++;
+        }
+        CHECK_EQ(accepted, I2C_QUEUE_CAPACITY);
+        CHECK_EQ(rejected, 5);
+        CHECK_EQ(bus.getQueueDepth(), I2C_QUEUE_CAPACITY);
+        CHECK_EQ(bus.getStats().maxQueueDepth, I2C_QUEUE_CAPACITY);
+
+        blocker.release();
+        CHECK(waitCallbacks(I2C_QUEUE_CAPACITY));
+        CHECK_EQ(bus.getQueueDepth(), 0);
+    }
+
+    //each client writes its own register and reads it back in the same transaction: another client in between would be seen
+    void testConcurrentClients(I2cBus &bus){
+        const int clients = 4;
+        const int transfers = 100;
+        std::atomic <int> good{0};
+        uint32_t before = bus.getStats().transactions;
+
+        std::vector <std::thread> threads;
+        for(int client = 0; client < clients; client++){
+            threads.emplace_back([&bus, &good, client](){
+                for(int i = 0; i < transfers; i++){
+                    const uint8_t write[2] = {(uint8_t)(8 + client), (uint8_t)(client * 50 + i)};
+                    uint8_t read = 0xFF;
+                    I2cTransaction transaction(SENSOR_ADDRESS, (I2cPriority)(i % PRIORITY_COUNT));
+                    transaction.write(write, 2).readRegister(8 + client, &read, 1);
+                    if(bus.transfer(transaction) == I2C_OK && read == write[1]) good++;
+                }
+            });
+        }
+        for(std::thread &thread : threads) thread.join();
+        CHECK_EQ(good.load(), clients * transfers);
+        CHECK_EQ(bus.getStats().transactions - before, clients * transfers);
+    }
+};
+
+int main(){
+    SimulatedI2cBackend backend(400000);
+    backend.addDevice(DISPLAY_ADDRESS, 256);
+    backend.addDevice(SENSOR_ADDRESS, 16);
+    backend.getRegisters(SENSOR_ADDRESS)[2] = 0xAB;
+    backend.getRegisters(SENSOR_ADDRESS)[3] = 0xCD;
+
+    I2cBus bus(0, &backend);
+    CHECK(bus.init());
+    testInline(bus, backend);
+
+    CHECK(bus.start(0));
+    testPriorityAging(bus);
+    testOverflow(bus);
+    testConcurrentClients(bus);
+
+    TEST_EXIT();
+}
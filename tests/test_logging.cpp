@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Formats of the log messages: string literals are stored by address, formats built at run time are
+// formatted when logged, so the message is right even if the buffer is overwritten before the writer runs.
+
+#include "core/logging/logging.h"
+#include "core/logging/log_sink.h"
+#include "host/test_check.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace{
+    const char LITERAL_FORMAT[] = "literal %d";
+
+    class CaptureSink : public LogSink{
+    public:
+        void write(const LogRecord &record, const char* line, size_t length) override{
+            std::lock_guard <std::mutex> lock(mutex);
+            lines.push_back(std::string(line, length));
+            formats.push_back(record.format);
+        }
+        std::mutex mutex;
+        std::vector <std::string> lines;
+        std::vector <const char*> formats;
+    };
+
+    //index of the first captured line containing text, -1 if it does not arrive in time
+    int waitLine(CaptureSink &sink, const char* text){
+        for(int retry = 0; retry < 200; retry++){
+            {
+                std::lock_guard <std::mutex> lock(sink.mutex);
+                for(int i = 0; i < sink.lines.size(); i++){
+                    if(sink.lines[i].find(text) != std::string::npos) return i;
+                }
+            }
+            delay(5);
+        }
+        return -1;
+    }
+};
+
+int main(){
+    CaptureSink sink;
+    Logger::addSink(&sink);
+    CHECK_EQ(Logger::init(0, false), 0);
+
+    Logger::info(LITERAL_FORMAT, 42);
+    int line = waitLine(sink, "literal 42");
+    CHECK(line >= 0);
+    if(line >= 0) CHECK(sink.formats[line] == LITERAL_FORMAT);
+
+    //the format buffer is reused before the writer task formats the message
+    char format[48];
+    snprintf(format, sizeof(format), "runtime %%d %%s %s", "x");
+    Logger::info(format, 7, "arg");
+    memset(format, 0, sizeof(format));
+    snprintf(format, sizeof(format), "overwritten");
+    line = waitLine(sink, "runtime 7 arg x");
+    CHECK(line >= 0);
+    if(line >= 0) CHECK(sink.formats[line] != format);
+
+    //formatted text longer than the payload is truncated and marked
+    std::string longFormat(200, 'a');
+    longFormat += " %d";
+    Logger::warning(longFormat.c_str(), 1);
+    line = waitLine(sink, "aaaa");
+    CHECK(line >= 0);
+    if(line >= 0){
+        const std::string &text = sink.lines[line];
+        CHECK(text.size() >= 3 && text.compare(text.size() - 3, 3, "...") == 0);
+    }
+
+    TEST_EXIT();
+}
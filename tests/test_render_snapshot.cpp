@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Stress test of the render snapshot protocol of View: one thread updates the elements and publishes,
+// another acquires and reads the frames like the display task does. A frame must never mix two
+// generations of texts and the generations seen by the renderer must never go back.
+
+#include "core/task/gui/view.h"
+#include "host/test_check.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+namespace{
+    const int ELEMENT_COUNT = 40;
+    const int GENERATIONS = 5000;
+
+    //parse "g<generation>-<index>", -1 if malformed
+    int parseGeneration(const char* text, int &index){
+        int generation;
+        if(sscanf(text, "g%d-%d", &generation, &index) != 2) return -1;
+        return generation;
+    }
+};
+
+int main(){
+    View view(0);
+    for(int i = 0; i < ELEMENT_COUNT; i++){
+        view.create_button_element(i, "g0-" + std::to_string(i), 0, i * 10);
+    }
+    view.publish_render_view();
+
+    std::atomic<bool> updaterDone{false};
+    std::atomic<long> tornFrames{0}, staleFrames{0}, malformedItems{0};
+    long renderedFrames = 0;
+    int lastGeneration = -1;
+
+    std::thread renderer([&](){
+        while(true){
+            bool finished = updaterDone.load();
+            bool newFrame;
+            ViewRenderStruct* frame = view.acquire_render_view(newFrame);
+
+            int frameGeneration = -1;
+            bool torn = false;
+            for(size_t i = 0; i < frame->elements.size(); i++){
+                int index;
+                int generation = parseGeneration(frame->elements[i].text.c_str(), index);
+                if(generation < 0 || index != (int)i){
+                    malformedItems++;
+                    continue;
+                }
+                if(frameGeneration < 0) frameGeneration = generation;
+                else if(generation != frameGeneration) torn = true;
+            }
+            if(frame->elements.size() != ELEMENT_COUNT) malformedItems++;
+            if(torn) tornFrames++;
+            if(frameGeneration < lastGeneration) staleFrames++;
+            if(!newFrame && frameGeneration != lastGeneration) staleFrames++;  //changed without being flagged as new
+            lastGeneration = frameGeneration;
+            renderedFrames++;
+            view.release_render_view();
+
+            if(finished && lastGeneration == GENERATIONS) break;
+        }
+    });
+
+    for(int generation = 1; generation <= GENERATIONS; generation++){
+        std::string prefix = "g" + std::to_string(generation) + "-";
+        for(int i = 0; i < ELEMENT_COUNT; i++) view.gui_set_text(i, prefix + std::to_string(i));
+        while(!view.publish_render_view()) std::this_thread::yield();  //the renderer holds the back frame
+    }
+    updaterDone = true;
+    renderer.join();
+
+    printf("rendered %ld frames\n", renderedFrames);
+    CHECK_EQ(tornFrames.load(), 0);
+    CHECK_EQ(staleFrames.load(), 0);
+    CHECK_EQ(malformedItems.load(), 0);
+    CHECK_EQ(lastGeneration, GENERATIONS);
+    TEST_EXIT();
+}
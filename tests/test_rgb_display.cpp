@@ -0,0 +1,93 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Updates of an RGB display larger than the send buffer: they must be sent in pieces of at most
+// RGB_SEND_BUFFER_TILE_ROWS tile rows and leave the panel equal to the framebuffer.
+
+#include "core/base_devices/memory_rgb_display.h"
+#include "host/test_check.h"
+
+namespace{
+    const int WIDTH = 320;
+    const int HEIGHT = 240;
+
+    class RecordingDisplay : public MemoryRgbDisplay{
+    public:
+        RecordingDisplay() : MemoryRgbDisplay(0) {}
+        uint32_t pieceBytes = 0, maxPieceBytes = 0;
+        int pieces = 0;
+
+        //prepareUpdate/sendUpdate pairs as the display compositor runs them
+        void update(){
+            do{
+                prepareUpdate();
+                pieceBytes = 0;
+                sendUpdate();
+                if(pieceBytes > 0) pieces++;
+                if(pieceBytes > maxPieceBytes) maxPieceBytes = pieceBytes;
+            }while(hasPendingUpdate());
+        }
+        const uint16_t* framebuffer() {return _framebuffer.getBuffer();}
+    protected:
+        int writeWindow(int16_t x, int16_t y, int16_t width, int16_t height, const uint8_t *pixels) override{
+            pieceBytes += (uint32_t)width * height * 2;
+            return MemoryRgbDisplay::writeWindow(x, y, width, height, pixels);
+        }
+    };
+
+    bool panelMatches(RecordingDisplay &display){
+        for(int y = 0; y < HEIGHT; y++){
+            for(int x = 0; x < WIDTH; x++){
+                if(display.getPanelPixel(x, y) != display.framebuffer()[y * WIDTH + x]) return false;
+            }
+        }
+        return true;
+    }
+};
+
+int main(){
+    const uint32_t bufferBytes = (uint32_t)WIDTH * RGB565_TILE_SIZE * RGB_SEND_BUFFER_TILE_ROWS * 2;
+    const int tileRows = (HEIGHT + RGB565_TILE_SIZE - 1) / RGB565_TILE_SIZE;
+
+    RecordingDisplay display;
+    display.configure({WIDTH, HEIGHT});
+    CHECK_EQ(display.init(), 0);
+
+    //full screen: one piece per tile row
+    display.fillScreen(RGB_Color{10, 200, 30});
+    display.update();
+    CHECK_EQ(display.pieces, tileRows / RGB_SEND_BUFFER_TILE_ROWS);
+    CHECK(display.maxPieceBytes <= bufferBytes);
+    CHECK_EQ(display.getLastUpdatePixels(), WIDTH * HEIGHT);
+    CHECK(panelMatches(display));
+
+    //small changes on many rows are packed in the same piece
+    display.pieces = 0;
+    display.maxPieceBytes = 0;
+    for(int row = 0; row < tileRows; row++) display.drawRect(row * 8, row * RGB565_TILE_SIZE, 4, 4, true, RGB_Color{255, 0, 0});
+    display.update();
+    CHECK(display.pieces < tileRows);
+    CHECK(display.maxPieceBytes <= bufferBytes);
+    CHECK(panelMatches(display));
+
+    //a drawing between two pieces is sent with the rest of the update or with the next one
+    display.pieces = 0;
+    display.fillScreen(RGB_Color{0, 0, 255});
+    display.prepareUpdate();
+    display.sendUpdate();
+    CHECK(display.hasPendingUpdate());
+    display.drawText("top", 0, 0, 2, RGB_Color{0, 0, 0}, RGB_Color{255, 255, 255});
+    display.update();
+    display.update();
+    CHECK(!display.hasPendingUpdate());
+    CHECK(panelMatches(display));
+
+    //nothing changed: nothing sent
+    display.pieces = 0;
+    display.update();
+    CHECK_EQ(display.pieces, 0);
+    CHECK_EQ(display.getLastUpdateWindows(), 0);
+
+    TEST_EXIT();
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// SensorSampler with sensors on a simulated I2C bus: a slow reading must not block period changes,
+// and a batch the bus refuses (queue full) is counted as errors of its sensors.
+
+#include "core/kernel/components/sensor_sampler.h"
+#include "core/kernel/components/sensor_buffer.h"
+#include "core/kernel/device/sensor_device.h"
+#include "core/kernel/interfaces/i2c_bus.h"
+#include "core/kernel/interfaces/simulated_i2c_backend.h"
+#include "core/stats/stats_registry.h"
+#include "host/test_check.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace{
+    const uint8_t DEVICE_ADDRESS = 0x48;
+    const uint32_t SLOW_READ_MS = 150;
+
+    //counts its readings, optionally taking a long time
+    class TestSensor : public SensorDevice{
+    public:
+        TestSensor(uint32_t deviceId, uint32_t readTime) : SensorDevice(deviceId), _readTime(readTime) {}
+        int read(float* values) override{
+            reading = true;
+            if(_readTime) delay(_readTime);
+            values[0] = ++readings;
+            reading = false;
+            return 0;
+        }
+        int get_device_info(SensorDeviceInfo_t &info) override{
+            info.sensorModel = "test";
+            info.channelCount = 1;
+            info.minPeriod = 1;
+            return 0;
+        }
+        std::atomic <bool> reading{false};
+        std::atomic <int> readings{0};
+    private:
+        uint32_t _readTime;
+    };
+
+    bool waitFor(std::atomic <bool> &flag){
+        for(int retry = 0; retry < 1000 && !flag.load(); retry++) delay(1);
+        return flag.load();
+    }
+
+    size_t sampleCount(const SensorBuffer &buffer){
+        std::vector <SensorSample> samples;
+        return buffer.getSince(samples, 0);
+    }
+};
+
+int main(){
+    SimulatedI2cBackend backend(400000);
+    backend.addDevice(DEVICE_ADDRESS, 16);
+    I2cBus bus(0, &backend);
+    CHECK(bus.init());
+    CHECK(bus.start(0));
+
+    TestSensor slow(1, SLOW_READ_MS), direct(2, 0), fast(3, 0);
+    SensorBuffer slowBuffer(8), directBuffer(8), fastBuffer(8);
+    SensorSampler sampler;
+    sampler.addSensor(&slow, &slowBuffer, &bus, 20);
+    sampler.addSensor(&direct, &directBuffer, nullptr, 10);
+    sampler.addSensor(&fast, &fastBuffer, &bus, 0);
+    CHECK(sampler.start(0));
+
+    //a period change while a sensor is being read on the bus does not wait for the reading
+    CHECK(waitFor(slow.reading));
+    uint32_t start = millis();
+    CHECK(sampler.setPeriod(2, 15));
+    uint32_t elapsed = millis() - start;
+    if(elapsed >= SLOW_READ_MS / 3) printf("setPeriod waited %u ms\n", elapsed);
+    CHECK(elapsed < SLOW_READ_MS / 3);
+    CHECK(sampler.setPeriod(1, 0));
+    delay(SLOW_READ_MS + 20);
+    CHECK(sampleCount(slowBuffer) >= 1);
+    CHECK(sampleCount(directBuffer) >= 2);
+
+    //fill the bus queue behind a blocked request, then start a sensor on the bus: its batches are refused
+    struct BusGate{
+        std::atomic <bool> entered{false}, released{false};
+    } gate;
+    std::thread blocker([&](){
+        bus.run([](void* context) -> int{
+            BusGate* gate = static_cast<BusGate*>(context);
+            gate->entered = true;
+            while(!gate->released) delay(1);
+            return I2C_OK;
+        }, &gate, I2cPriority::INTERACTIVE);
+    });
+    CHECK(waitFor(gate.entered));
+    const uint8_t value = 0;
+    while(bus.submit(I2cTransaction(DEVICE_ADDRESS).write(&value, 1)) == I2C_OK);
+
+    StatCounter* errors = StatsRegistry::counter("sensors.errors");
+    uint32_t errorsBefore = errors->get();
+    CHECK(sampler.setPeriod(3, 10));
+    delay(60);
+    CHECK(errors->get() - errorsBefore >= 3);
+    CHECK_EQ(fast.readings.load(), 0);
+
+    gate.released = true;
+    blocker.join();
+    delay(60);
+    CHECK(fast.readings.load() >= 2);
+    CHECK(sampleCount(fastBuffer) >= 2);
+
+    TEST_EXIT();
+}
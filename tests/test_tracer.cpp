@@ -0,0 +1,46 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Tracer buffers replaced and freed while other threads are recording: start and release must wait
+// for the events in progress. Meaningful with -fsanitize=address, which reports the writes after free.
+
+#include "core/tracing/tracer.h"
+#include "host/test_check.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace{
+    const int RECORDER_THREADS = 4;
+    const int RECORDINGS = 500;
+};
+
+int main(){
+    std::atomic<bool> done{false};
+    std::vector <std::thread> recorders;
+    for(int i = 0; i < RECORDER_THREADS; i++){
+        recorders.emplace_back([&](){
+            while(!done.load()){
+                CESP_TRACE_SCOPE("scope");
+                CESP_TRACE_INSTANT("instant");
+            }
+        });
+    }
+
+    for(int recording = 0; recording < RECORDINGS; recording++){
+        uint32_t capacity = 16 + recording % 7 * 8;    //a new size frees and allocates the buffers
+        CHECK(Tracer::start(capacity));
+        std::this_thread::yield();
+        Tracer::stop();
+        CHECK(Tracer::getEventCount(0) <= capacity);
+        if(recording % 5 == 0) Tracer::release();
+    }
+    done = true;
+    for(std::thread &recorder : recorders) recorder.join();
+    Tracer::release();
+    CHECK_EQ(Tracer::getEventCount(0), 0);
+
+    TEST_EXIT();
+}
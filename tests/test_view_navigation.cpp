@@ -0,0 +1,160 @@
+// Copyright (c) 2025 Riccardo Damiani
+// Licensed under the Apache License, Version 2.0
+// See LICENSE file in the project root for full license information.
+
+// Property test of the element navigation of View: over random sets of elements, random changes of
+// selectability and deletions, every step of _gui_navigation_up/_gui_navigation_down must land where
+// walking the elements one at a time (the original navigation) lands. A PAGES container keeps its active
+// page when pages are removed, and the focus leaves a page when it is hidden.
+
+#include "core/task/gui/view.h"
+#include "host/test_check.h"
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace{
+    const int ROUNDS = 300;
+    const int MAX_ELEMENTS = 24;
+    const int OPERATIONS = 200;
+
+    //reference: walk one element at a time with wrap-around, counting only the selectable landings
+    int referenceStep(const std::vector<bool> &selectable, int selected, int step){
+        int size = selectable.size();
+        bool any = false;
+        for(bool s : selectable) any |= s;
+        if(!any) return -1;
+
+        int direction = step > 0 ? 1 : -1;
+        int index = selected;
+        for(int landed = 0; landed < step * direction;){
+            index += direction;
+            if(index >= size) index = 0;
+            if(index < 0) index = size - 1;
+            if(selectable[index]) landed++;
+        }
+        return index;
+    }
+
+    //element ids in the order used by the navigation, read from the published frame
+    std::vector<int> elementOrder(View &view){
+        view.publish_render_view();
+        bool newFrame;
+        ViewRenderStruct* frame = view.acquire_render_view(newFrame);
+        std::vector<int> order;
+        for(const ItemRenderStruct &item : frame->elements) order.push_back(atoi(item.text.c_str()));
+        view.release_render_view();
+        return order;
+    }
+
+    int selectedIndex(View &view, const std::vector<int> &order){
+        int id;
+        if(view.gui_get_selected_element(id) != ViewError::NO_ERROR) return -1;
+        for(int i = 0; i < order.size(); i++){
+            if(order[i] == id) return i;
+        }
+        return -2;  //selected element not in the frame
+    }
+
+    int selectedId(View &view){
+        int id;
+        if(view.gui_get_selected_element(id) != ViewError::NO_ERROR) return -1;
+        return id;
+    }
+
+    void testPages(){
+        View view(0);
+        CHECK(view.create_container(0, Gui_ContainerType::PAGES, -1, 0, 0, 0) == ViewError::NO_ERROR);
+        for(int id = 0; id < 4; id++){
+            view.create_button_element(id, std::to_string(id), 0, 0);
+            CHECK(view.gui_set_container(id, 0) == ViewError::NO_ERROR);
+        }
+        view.create_button_element(9, "9", 0, 20);  //outside of the container
+
+        //only the active page can take the focus
+        CHECK(elementOrder(view) == std::vector<int>({0, 9}));
+        view._gui_navigation_up(1);
+        CHECK_EQ(selectedId(view), 0);
+
+        //hiding the focused page moves the focus to a visible element
+        CHECK(view.gui_container_set_page(0, 2) == ViewError::NO_ERROR);
+        CHECK(elementOrder(view) == std::vector<int>({2, 9}));
+        CHECK_EQ(selectedId(view), 2);
+
+        //removing a page before the active one keeps the same page shown
+        CHECK(view.gui_delete_element(0) == ViewError::NO_ERROR);
+        CHECK(elementOrder(view) == std::vector<int>({2, 9}));
+        CHECK_EQ(selectedId(view), 2);
+
+        //removing the active page shows the next one, and the focus follows
+        CHECK(view.gui_delete_element(2) == ViewError::NO_ERROR);
+        CHECK(elementOrder(view) == std::vector<int>({3, 9}));
+        CHECK_EQ(selectedId(view), 3);
+
+        //removing the last page, active, shows the previous one
+        CHECK(view.gui_delete_element(3) == ViewError::NO_ERROR);
+        CHECK(elementOrder(view) == std::vector<int>({1, 9}));
+        CHECK(view.gui_container_set_page(0, 1) == ViewError::INVALID_PARAM);
+    }
+};
+
+int main(){
+    testPages();
+
+    std::mt19937 random(1234);
+    long steps = 0;
+
+    for(int round = 0; round < ROUNDS; round++){
+        View view(0);
+        std::map<int, bool> selectableById;
+        int elementCount = 1 + random() % MAX_ELEMENTS;
+        for(int id = 0; id < elementCount; id++){
+            int x = random() % 100, y = random() % 8 * 10;
+            bool button = random() % 3 != 0;
+            if(button) view.create_button_element(id, std::to_string(id), x, y);
+            else view.create_generic_element(id, std::to_string(id), x, y);
+            selectableById[id] = button;
+        }
+
+        for(int operation = 0; operation < OPERATIONS && !selectableById.empty(); operation++){
+            int choice = random() % 10;
+            if(choice == 0){
+                auto element = std::next(selectableById.begin(), random() % selectableById.size());
+                element->second = !element->second;
+                CHECK(view.gui_set_selectable(element->first, element->second) == ViewError::NO_ERROR);
+                continue;
+            }
+            if(choice == 1 && selectableById.size() > 1){
+                auto element = std::next(selectableById.begin(), random() % selectableById.size());
+                CHECK(view.gui_delete_element(element->first) == ViewError::NO_ERROR);
+                selectableById.erase(element);
+                continue;
+            }
+
+            std::vector<int> order = elementOrder(view);
+            CHECK_EQ(order.size(), selectableById.size());
+            std::vector<bool> selectable;
+            for(int id : order) selectable.push_back(selectableById[id]);
+
+            int before = selectedIndex(view, order);
+            CHECK(before >= -1);
+            int step = 1 + random() % 5;
+            bool up = random() % 2;
+            if(up) view._gui_navigation_up(step);
+            else view._gui_navigation_down(step);
+
+            int expected = referenceStep(selectable, before, up ? step : -step);
+            int actual = selectedIndex(view, elementOrder(view));
+            if(actual != expected){
+                printf("round %d: %s %d from %d, expected %d got %d\n", round, up ? "up" : "down", step, before, expected, actual);
+            }
+            CHECK_EQ(actual, expected);
+            steps++;
+        }
+    }
+
+    printf("checked %ld steps\n", steps);
+    TEST_EXIT();
+}
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Riccardo Damiani
+# Licensed under the Apache License, Version 2.0
+# See LICENSE file in the project root for full license information.
+
+"""Decode the binary log stream of ChibiESP (Logger::setOutput(LogOutput::BINARY)).
+
+Each frame holds the address of the format string and the raw arguments. The format
+strings are read from the ELF file of the firmware that produced the stream.
+
+usage: log_decoder.py firmware.elf capture.bin     (or - to read from stdin)
+"""
+
+import re
+import struct
+import sys
+
+FRAME_SYNC = b"\xA5\x5A"
+HEADER_SIZE = 12
+PAYLOAD_SIZE = 116  # LOG_PAYLOAD_SIZE in core/logging/logging.h
+LEVELS = {0: "Debug", 1: "Info", 2: "Warning", 3: "Error"}
+
+ARG_INT32 = 1
+ARG_INT64 = 2
+ARG_DOUBLE = 3
+ARG_STRING = 4
+
+SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(?:hh|h|ll|l|L|q|j|z|t)?([diuoxXcfFeEgGaAsp%])")
+
+
+class Elf32:
+    """Reads NUL terminated strings at an address of a little endian ELF32 file."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1:
+            raise ValueError("%s is not an ELF32 file" % path)
+        shoff, = struct.unpack_from("<I", self.data, 0x20)
+        shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            sh_type, sh_flags, sh_addr, sh_offset, sh_size = struct.unpack_from("<IIIII", self.data, shoff + i * shentsize + 4)
+            alloc = sh_flags & 0x2
+            if alloc and sh_type != 8 and sh_size:  # SHT_NOBITS has no content in the file
+                self.sections.append((sh_addr, sh_size, sh_offset))
+
+    def string_at(self, address):
+        for start, size, offset in self.sections:
+            if start <= address < start + size:
+                begin = offset + address - start
+                end = self.data.index(b"\0", begin)
+                return self.data[begin:end].decode("utf-8", "replace")
+        return None
+
+
+def read_args(payload):
+    args = []
+    pos = 0
+    while pos < len(payload):
+        tag = payload[pos]
+        pos += 1
+        if tag == ARG_INT32:
+            args.append((tag, struct.unpack_from("<i", payload, pos)[0]))
+            pos += 4
+        elif tag == ARG_INT64:
+            args.append((tag, struct.unpack_from("<q", payload, pos)[0]))
+            pos += 8
+        elif tag == ARG_DOUBLE:
+            args.append((tag, struct.unpack_from("<d", payload, pos)[0]))
+            pos += 8
+        elif tag == ARG_STRING:
+            end = payload.index(b"\0", pos)
+            args.append((tag, payload[pos:end].decode("utf-8", "replace")))
+            pos = end + 1
+        else:
+            break
+    return args
+
+
+def format_message(fmt, args, truncated):
+    """printf formatting, the same done by Logger::formatRecord on the device."""
+    args = list(args)
+    missing = False
+
+    def next_arg():
+        nonlocal missing
+        if not args:
+            missing = True
+            return None
+        return args.pop(0)
+
+    def replace(match):
+        flags, width, precision, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        if width == "*":
+            arg = next_arg()
+            width = str(arg[1]) if arg else ""
+        if precision == "*":
+            arg = next_arg()
+            precision = str(arg[1]) if arg else ""
+        spec = "%" + flags + (width or "") + ("." + precision if precision is not None else "")
+        arg = next_arg()
+        if arg is None:
+            return ""
+        tag, value = arg
+        if conversion in "uoxX" and tag in (ARG_INT32, ARG_INT64):
+            value &= 0xFFFFFFFF if tag == ARG_INT32 else 0xFFFFFFFFFFFFFFFF
+        if conversion == "p":
+            return "0x%x" % (value & 0xFFFFFFFF if tag == ARG_INT32 else value)
+        if conversion == "u" or conversion == "i":
+            conversion = "d"
+        if conversion == "c":
+            value = chr(value & 0xFF)
+            conversion = "s"
+        if conversion in "aA":
+            return float(value).hex()
+        if conversion == "F":
+            conversion = "f"
+        return (spec + conversion) % value
+
+    text = SPEC.sub(replace, fmt)
+    if missing or truncated:
+        text += "..."
+    return text
+
+
+def decode(stream, elf, out):
+    buffer = b""
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            break
+        buffer += chunk
+        while True:
+            start = buffer.find(FRAME_SYNC)
+            if start < 0:
+                buffer = buffer[-1:]
+                break
+            if len(buffer) - start < HEADER_SIZE:
+                buffer = buffer[start:]
+                break
+            level, timestamp, address, length = struct.unpack_from("<BIIB", buffer, start + 2)
+            if (level & 0x7F) not in LEVELS or length > PAYLOAD_SIZE:
+                buffer = buffer[start + 1:]  # not a frame, keep searching
+                continue
+            if len(buffer) - start < HEADER_SIZE + length:
+                buffer = buffer[start:]
+                break
+            payload = buffer[start + HEADER_SIZE:start + HEADER_SIZE + length]
+            buffer = buffer[start + HEADER_SIZE + length:]
+
+            fmt = elf.string_at(address)
+            if fmt is None:
+                text = "<unknown format 0x%08x>" % address
+            else:
+                text = format_message(fmt, read_args(payload), level & 0x80)
+            out.write("%10.6f %s: %s\n" % (timestamp / 1e6, LEVELS[level & 0x7F], text))
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+    elf = Elf32(sys.argv[1])
+    if sys.argv[2] == "-":
+        decode(sys.stdin.buffer, elf, sys.stdout)
+    else:
+        with open(sys.argv[2], "rb") as stream:
+            decode(stream, elf, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
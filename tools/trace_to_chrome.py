@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+# Copyright (c) 2025 Riccardo Damiani
+# Licensed under the Apache License, Version 2.0
+# See LICENSE file in the project root for full license information.
+
+"""Convert a recording written by Tracer::dump to the Chrome trace format.
+
+Open the output in chrome://tracing or https://ui.perfetto.dev. Each core is a process,
+each FreeRTOS task a thread.
+
+usage: trace_to_chrome.py trace.bin trace.json
+"""
+
+import json
+import struct
+import sys
+
+MAGIC = 0x43525443  # TRACE_DUMP_MAGIC in core/tracing/tracer.h
+VERSION = 1
+PHASES = {0: "B", 1: "E", 2: "i"}
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def read(self, fmt):
+        values = struct.unpack_from("<" + fmt, self.data, self.pos)
+        self.pos += struct.calcsize("<" + fmt)
+        return values
+
+
+def signed32(value):
+    value &= 0xFFFFFFFF
+    return value - 0x100000000 if value & 0x80000000 else value
+
+
+def convert(data):
+    reader = Reader(data)
+    magic, version, cores, frequency = reader.read("IHHI")
+    if magic != MAGIC:
+        raise ValueError("not a trace recording")
+    if version != VERSION:
+        raise ValueError("unsupported trace version %d" % version)
+
+    cores_events = []
+    for core in range(cores):
+        reference_cycles, reference_micros, count, dropped = reader.read("IIII")
+        events = [reader.read("IIHB") for _ in range(count)]
+        cores_events.append((reference_cycles, reference_micros, dropped, events))
+
+    name_count, = reader.read("H")
+    names = []
+    for _ in range(name_count):
+        length, = reader.read("B")
+        names.append(reader.data[reader.pos:reader.pos + length].decode("utf-8", "replace"))
+        reader.pos += length
+
+    trace = []
+    tasks = set()
+    for core, (reference_cycles, reference_micros, dropped, events) in enumerate(cores_events):
+        trace.append({"name": "process_name", "ph": "M", "pid": core, "args": {"name": "Core %d" % core}})
+        if dropped:
+            print("core %d: %d events dropped, the buffer was full" % (core, dropped), file=sys.stderr)
+
+        # the 32 bit cycle counter wraps: accumulate the differences between consecutive events
+        elapsed = None
+        previous = None
+        for cycles, task, name, event_type in events:
+            if elapsed is None:
+                elapsed = signed32(cycles - reference_cycles)
+            else:
+                elapsed += signed32(cycles - previous)
+            previous = cycles
+
+            event = {
+                "name": names[name],
+                "ph": PHASES.get(event_type, "i"),
+                "ts": reference_micros + elapsed / float(frequency),
+                "pid": core,
+                "tid": task,
+            }
+            if event["ph"] == "i":
+                event["s"] = "t"
+            trace.append(event)
+            tasks.add((core, task))
+
+    for core, task in sorted(tasks):
+        trace.append({"name": "thread_name", "ph": "M", "pid": core, "tid": task, "args": {"name": "task 0x%08x" % task}})
+
+    trace.sort(key=lambda e: e.get("ts", -1))
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__.strip(), file=sys.stderr)
+        return 1
+    with open(sys.argv[1], "rb") as f:
+        trace = convert(f.read())
+    with open(sys.argv[2], "w") as f:
+        json.dump(trace, f)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())